@@ -72,20 +72,20 @@ void BrakePipe_Cumulative::initializeSystemMatrixAndForcingVector() {
 }
 
 
-void BrakePipe_Cumulative::calc_brakePipe_FiniteElements() {
+void BrakePipe_Cumulative::calc_brakePipe_FiniteElements(int maxRailVehiclesPerFE) {
 	int numberOfRailVehicles = (railVehicles[railVehicles.size() - 1]->positionInTrainConsist - railVehicles[0]->positionInTrainConsist) + 1;
 	int remainingNumberOfRailVehicles = numberOfRailVehicles;
 	int railVehiclesUsed = 0;
 	int numberOfFiniteElements = 0;
 	do {
-		if ((numberOfRailVehicles <= BrakePipe_FiniteElement::MAX_RAIL_VEHICLES_PER_BRAKE_PIPE_FE) ||
-			(remainingNumberOfRailVehicles > (2 * BrakePipe_FiniteElement::MAX_RAIL_VEHICLES_PER_BRAKE_PIPE_FE))) {
+		if ((numberOfRailVehicles <= maxRailVehiclesPerFE) ||
+			(remainingNumberOfRailVehicles > (2 * maxRailVehiclesPerFE))) {
 			int FESize;
-			if (numberOfRailVehicles <= BrakePipe_FiniteElement::MAX_RAIL_VEHICLES_PER_BRAKE_PIPE_FE) {
+			if (numberOfRailVehicles <= maxRailVehiclesPerFE) {
 				FESize = numberOfRailVehicles;
 			}
 			else {
-				FESize = BrakePipe_FiniteElement::MAX_RAIL_VEHICLES_PER_BRAKE_PIPE_FE;
+				FESize = maxRailVehiclesPerFE;
 			}
 			numberOfFiniteElements++;
 			brakePipe_FiniteElements.push_back(new BrakePipe_FiniteElement(this, numberOfFiniteElements - 1));
@@ -45,7 +45,8 @@ public:
 	void initializeSystemMatrixAndForcingVector();
 
 	// Calculates vector of brake pipe finite elements
-	void calc_brakePipe_FiniteElements();
+	// maxRailVehiclesPerFE	-->	Maximum number of rail vehicles per brake pipe finite element
+	void calc_brakePipe_FiniteElements(int maxRailVehiclesPerFE);
 
 	// Calculates array of rail vehicle types
 	void calc_railVehicleTypes();
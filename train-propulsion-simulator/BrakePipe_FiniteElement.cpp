@@ -7,6 +7,7 @@
 #include "BrakePipe_Cumulative.h"
 #include "Car.h"
 #include "ControlValve_Car.h"
+#include "SimulationState.h"
 #include "TrainConsist.h"
 #include "UnitConverter.h"
 
@@ -255,3 +256,23 @@ double BrakePipe_FiniteElement::calculateInterpolatedValue(double x, bool pressu
 	return interpolatedValue;
 }
 
+
+void BrakePipe_FiniteElement::saveState(SimulationState* simulationState) {
+	for (int i = 0; i < NUMBER_OF_NODES_PER_BRAKE_PIPE_FE; i++) {
+		simulationState->append(nodePressures[i], true);
+		simulationState->append(nodeVelocities[i], true);
+		simulationState->append(nodeDensities[i], true);
+		simulationState->append(nodeMValues[i], true);
+	}
+}
+
+
+void BrakePipe_FiniteElement::loadState(SimulationState* simulationState) {
+	for (int i = 0; i < NUMBER_OF_NODES_PER_BRAKE_PIPE_FE; i++) {
+		nodePressures[i] = simulationState->next();
+		nodeVelocities[i] = simulationState->next();
+		nodeDensities[i] = simulationState->next();
+		nodeMValues[i] = simulationState->next();
+	}
+}
+
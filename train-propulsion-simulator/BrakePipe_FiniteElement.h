@@ -9,6 +9,7 @@
 
 class BrakePipe_Cumulative;
 class RailVehicle;
+class SimulationState;
 
 class BrakePipe_FiniteElement {
 
@@ -87,6 +88,14 @@ public:
 	// Calculates node densities
 	void calc_nodeDensities();
 
+	// Saves state (variables that persist from one implicit solver time step to the next)
+	// simulationState		-->	Simulation state
+	void saveState(SimulationState* simulationState);
+
+	// Loads state (variables that persist from one implicit solver time step to the next)
+	// simulationState		-->	Simulation state
+	void loadState(SimulationState* simulationState);
+
 	// Calculates node areas
 	void calc_nodeAreas();
 
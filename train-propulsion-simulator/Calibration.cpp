@@ -0,0 +1,186 @@
+//////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+// This file is part of the TRAIN PROPULSION SIMULATOR repository available at github.com/lnaz01/train-propulsion-simulator //
+//////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <iostream>
+#include "Calibration.h"
+#include "BrakeCylinder.h"
+#include "CouplingSystem.h"
+#include "InputFileReader_ForcedSpeed.h"
+#include "InputFileReader_Simulation.h"
+#include "InputFileReader_SolverSettings.h"
+#include "RailVehicle.h"
+#include "Simulation.h"
+#include "Track.h"
+#include "TrainConsist.h"
+#include "UnitConverter.h"
+
+
+Calibration::Calibration(Simulation* simulation, InputFileReader_SolverSettings* inputFileReader_SolverSettings) {
+	this->simulation = simulation;
+	this->inputFileReader_SolverSettings = inputFileReader_SolverSettings;
+	numberOfImplicitSolverTimeSteps = (int)std::round(inputFileReader_SolverSettings->calibrationDuration / simulation->IMPLICIT_SOLVER_FIXED_TIME_STEP);
+	// User-defined configuration (candidate 0)
+	candidateExplicitSolverTypes.push_back(simulation->explicitSolverType);
+	candidateExplicitSolverFixedTimeSteps.push_back(simulation->explicitSolverFixedTimeStep);
+	candidateExplicitSolverMaxErrorThresholds.push_back(simulation->explicitSolverMaxErrorThreshold);
+	candidateBrakePipeFiniteElementSizes.push_back(simulation->brakePipeFiniteElementSize);
+	// Variable time step explicit solver candidates
+	addCandidates(1, simulation->explicitSolverFixedTimeStep, 1.0 * pow(10.0, -9.0));
+	addCandidates(1, simulation->explicitSolverFixedTimeStep, 1.0 * pow(10.0, -8.0));
+	addCandidates(1, simulation->explicitSolverFixedTimeStep, 1.0 * pow(10.0, -7.0));
+	addCandidates(1, simulation->explicitSolverFixedTimeStep, 1.0 * pow(10.0, -6.0));
+	// Fixed time step explicit solver candidates
+	addCandidates(0, 0.002, simulation->explicitSolverMaxErrorThreshold);
+	addCandidates(0, 0.004, simulation->explicitSolverMaxErrorThreshold);
+	addCandidates(0, 0.005, simulation->explicitSolverMaxErrorThreshold);
+	addCandidates(0, 0.01, simulation->explicitSolverMaxErrorThreshold);
+}
+
+
+Calibration::~Calibration() {}
+
+
+void Calibration::calibrate() {
+	std::cout << "Calibrating solver settings..." << std::endl;
+	std::cout << std::endl;
+	// Reference configuration
+	std::vector<double> rcf;  // reference coupler forces
+	std::vector<double> rbcp;  // reference brake cylinder pressures
+	double rct = run(1, 1, simulation->explicitSolverFixedTimeStep, REFERENCE_EXPLICIT_SOLVER_MAX_ERROR_THRESHOLD, simulation->brakePipeFiniteElementSize, &rcf, &rbcp);  // reference computation time
+	if (rct < 0.0) {
+		std::cout << "Calibration reference terminated early.  User-defined solver settings are used." << std::endl;
+		std::cout << std::endl;
+		return;
+	}
+	size_t nts = rbcp.size() / simulation->inputFileReader_Simulation->userDefinedTrainConsists[0]->railVehicles.size();  // number of implicit solver time steps
+	// Fastest candidate configuration within tolerances (user-defined configuration if no candidate configuration is within tolerances)
+	int bi = 0;  // best candidate index
+	double bct = -1.0;  // best computation time ('-1' until candidate configuration within tolerances is found)
+	for (size_t i = 0; i < candidateExplicitSolverTypes.size(); i++) {
+		std::vector<double> ccf;  // candidate coupler forces
+		std::vector<double> cbcp;  // candidate brake cylinder pressures
+		double cct = run(NUMBER_OF_TIMED_RUNS, candidateExplicitSolverTypes[i], candidateExplicitSolverFixedTimeSteps[i], candidateExplicitSolverMaxErrorThresholds[i],
+			candidateBrakePipeFiniteElementSizes[i], &ccf, &cbcp);  // candidate computation time
+		if ((cct < 0.0) || (ccf.size() != rcf.size()) || (cbcp.size() != rbcp.size())) {
+			continue;
+		}
+		if ((maxAbsoluteDifference(&ccf, &rcf, rcf.size() / nts) <= inputFileReader_SolverSettings->calibrationCouplerForceTolerance) &&
+			(maxAbsoluteDifference(&cbcp, &rbcp, rbcp.size() / nts) <= inputFileReader_SolverSettings->calibrationBrakeCylinderPressureTolerance) &&
+			((bct < 0.0) || (cct < bct))) {
+			bi = (int)i;
+			bct = cct;
+		}
+	}
+	// Apply configuration to simulation
+	simulation->explicitSolverType = candidateExplicitSolverTypes[bi];
+	simulation->explicitSolverFixedTimeStep = candidateExplicitSolverFixedTimeSteps[bi];
+	simulation->explicitSolverMaxErrorThreshold = candidateExplicitSolverMaxErrorThresholds[bi];
+	simulation->brakePipeFiniteElementSize = candidateBrakePipeFiniteElementSizes[bi];
+	if (bct < 0.0) {
+		std::cout << "No candidate configuration is within calibration tolerances.  User-defined solver settings are used." << std::endl;
+	}
+	else if (bi == 0) {
+		std::cout << "Calibrated configuration: user-defined solver settings (" << bct << " seconds)" << std::endl;
+	}
+	else {
+		std::cout << "Calibrated configuration: candidate " << bi << " of " << (candidateExplicitSolverTypes.size() - 1) << " (" << bct << " seconds)" << std::endl;
+	}
+	if (simulation->explicitSolverType == 0) {
+		std::cout << "Calibrated explicit solver: fixed time step (" << simulation->explicitSolverFixedTimeStep << " seconds)" << std::endl;
+	}
+	else {
+		std::cout << "Calibrated explicit solver: variable time step (error tolerance " << simulation->explicitSolverMaxErrorThreshold << ")" << std::endl;
+	}
+	std::cout << "Calibrated brake pipe finite element size: " << simulation->brakePipeFiniteElementSize << " rail vehicle(s)" << std::endl;
+	std::cout << std::endl;
+}
+
+
+void Calibration::addCandidates(int explicitSolverType, double explicitSolverFixedTimeStep, double explicitSolverMaxErrorThreshold) {
+	for (int i = simulation->brakePipeFiniteElementSize; i <= MAX_CANDIDATE_BRAKE_PIPE_FINITE_ELEMENT_SIZE; i++) {
+		candidateExplicitSolverTypes.push_back(explicitSolverType);
+		candidateExplicitSolverFixedTimeSteps.push_back(explicitSolverFixedTimeStep);
+		candidateExplicitSolverMaxErrorThresholds.push_back(explicitSolverMaxErrorThreshold);
+		candidateBrakePipeFiniteElementSizes.push_back(i);
+	}
+}
+
+
+double Calibration::run(int numberOfTimedRuns, int explicitSolverType, double explicitSolverFixedTimeStep, double explicitSolverMaxErrorThreshold,
+	int brakePipeFiniteElementSize, std::vector<double>* couplerForces, std::vector<double>* brakeCylinderPressures) {
+	double mct = -1.0;  // minimum computation time
+	for (int r = 0; r < numberOfTimedRuns; r++) {
+		// Create simulation from same input file as 'simulation' (without output results files)
+		InputFileReader_Simulation* inputFileReader_Simulation = new InputFileReader_Simulation(simulation->inputFileReader_Simulation->inputFileAbsolutePath);
+		inputFileReader_Simulation->load();
+		inputFileReader_Simulation->userDefinedTracks[0]->calc_trackLength();
+		InputFileReader_ForcedSpeed* inputFileReader_ForcedSpeed = new InputFileReader_ForcedSpeed(inputFileReader_Simulation);
+		if (inputFileReader_ForcedSpeed->inputFileExistsBool == true) {
+			inputFileReader_ForcedSpeed->load();
+		}
+		Simulation* candidateSimulation = inputFileReader_Simulation->userDefinedSimulations[0];
+		candidateSimulation->printProgressBool = false;
+		candidateSimulation->explicitSolverType = explicitSolverType;
+		candidateSimulation->explicitSolverFixedTimeStep = explicitSolverFixedTimeStep;
+		candidateSimulation->explicitSolverMaxErrorThreshold = explicitSolverMaxErrorThreshold;
+		candidateSimulation->brakePipeFiniteElementSize = brakePipeFiniteElementSize;
+		candidateSimulation->trackTableResolution = simulation->trackTableResolution;
+		candidateSimulation->trackTableMaxMemory = simulation->trackTableMaxMemory;
+		candidateSimulation->trackDatabaseBool = simulation->trackDatabaseBool;
+		candidateSimulation->trackDatabaseResolution = simulation->trackDatabaseResolution;
+		candidateSimulation->trackAveragingBool = simulation->trackAveragingBool;
+		candidateSimulation->initialize(inputFileReader_ForcedSpeed, false);
+		// Simulate prefix and record coupler forces and brake cylinder pressures at end of each implicit solver time step (histories of all runs are
+		// identical, so histories of last run are kept)
+		couplerForces->clear();
+		brakeCylinderPressures->clear();
+		int tc = Simulation::TC_NONE;  // termination condition
+		std::chrono::steady_clock::time_point begin_time = std::chrono::steady_clock::now();
+		for (int n = 0; (n < numberOfImplicitSolverTimeSteps) && (tc == Simulation::TC_NONE); n++) {
+			tc = candidateSimulation->implicitSolverIntegrationStep();
+			for (size_t i = 0; i < inputFileReader_Simulation->userDefinedTrainConsists[0]->couplingSystems.size(); i++) {
+				couplerForces->push_back(UnitConverter::n_To_Lb(inputFileReader_Simulation->userDefinedTrainConsists[0]->couplingSystems[i]->totalForceOnLeadingRailVehicle));
+			}
+			for (size_t i = 0; i < inputFileReader_Simulation->userDefinedTrainConsists[0]->railVehicles.size(); i++) {
+				brakeCylinderPressures->push_back(UnitConverter::pa_To_Psi(inputFileReader_Simulation->userDefinedTrainConsists[0]->railVehicles[i]->brakeCylinder->pressure));
+			}
+		}
+		std::chrono::steady_clock::time_point end_time = std::chrono::steady_clock::now();
+		double ct = std::chrono::duration_cast<std::chrono::nanoseconds>(end_time - begin_time).count() * pow(10.0, -9.0);  // computation time
+		delete inputFileReader_ForcedSpeed;
+		delete inputFileReader_Simulation;
+		// Configurations that fail numerically are rejected (without further runs)
+		if ((tc == Simulation::TC_TIME_STEP_TOO_SMALL) || (tc == Simulation::TC_EXCESSIVE_COUPLER_DISPLACEMENT)) {
+			return -1.0;
+		}
+		if ((mct < 0.0) || (ct < mct)) {
+			mct = ct;
+		}
+	}
+	return mct;
+}
+
+
+double Calibration::maxAbsoluteDifference(std::vector<double>* candidateHistory, std::vector<double>* referenceHistory, size_t stride) {
+	double mad = 0.0;  // maximum absolute difference
+	for (size_t i = 0; i < candidateHistory->size(); i++) {
+		// Difference to closest reference value within one implicit solver time step (so that events are not penalized for small shifts in timing)
+		double ad = std::abs((*candidateHistory)[i] - (*referenceHistory)[i]);  // absolute difference
+		if (i >= stride) {
+			ad = std::min(ad, std::abs((*candidateHistory)[i] - (*referenceHistory)[i - stride]));
+		}
+		if ((i + stride) < referenceHistory->size()) {
+			ad = std::min(ad, std::abs((*candidateHistory)[i] - (*referenceHistory)[i + stride]));
+		}
+		if (ad > mad) {
+			mad = ad;
+		}
+	}
+	return mad;
+}
+
@@ -0,0 +1,95 @@
+//////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+// This file is part of the TRAIN PROPULSION SIMULATOR repository available at github.com/lnaz01/train-propulsion-simulator //
+//////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+#ifndef CALIBRATION_DEF
+#define CALIBRATION_DEF
+
+#include <cmath>
+#include <vector>
+
+class InputFileReader_SolverSettings;
+class Simulation;
+
+// Solver settings calibration
+// (A short prefix of the simulation is run with a reference configuration (tight tolerance variable time step explicit
+// solver and default brake pipe finite element size) and with each candidate configuration, the first of which is the
+// user-defined configuration.  The fastest candidate whose coupler forces and brake cylinder pressures stay within the
+// user-defined tolerances of the reference is applied, or the user-defined configuration if no candidate is within
+// tolerances.)
+class Calibration {
+
+public:
+
+	// simulation						-->	Simulation (must not yet be initialized)
+	// inputFileReader_SolverSettings	-->	Solver settings input file reader
+	Calibration(Simulation* simulation, InputFileReader_SolverSettings* inputFileReader_SolverSettings);
+
+	virtual ~Calibration();
+
+	// Runs reference and candidate configurations and applies fastest candidate configuration within tolerances to simulation
+	// (user-defined configuration is kept if no candidate configuration is within tolerances)
+	void calibrate();
+
+private:
+
+	// Maximum error tolerance of variable time step explicit solver for reference configuration
+	const double REFERENCE_EXPLICIT_SOLVER_MAX_ERROR_THRESHOLD = 1.0 * pow(10.0, -11.0);
+
+	// Maximum number of rail vehicles per brake pipe finite element for candidate configurations
+	// (candidate configurations use the default brake pipe finite element size of the reference configuration or coarser brake pipe finite elements)
+	const int MAX_CANDIDATE_BRAKE_PIPE_FINITE_ELEMENT_SIZE = 6;
+
+	// Number of timed runs of each candidate configuration (computation time is minimum over runs, so that scheduler noise does not decide fastest
+	// candidate)
+	const int NUMBER_OF_TIMED_RUNS = 3;
+
+	// Simulation
+	Simulation* simulation;
+
+	// Solver settings input file reader
+	InputFileReader_SolverSettings* inputFileReader_SolverSettings;
+
+	// Number of implicit solver time steps in simulation prefix
+	int numberOfImplicitSolverTimeSteps;
+
+	// Explicit solver integration types of candidate configurations
+	std::vector<int> candidateExplicitSolverTypes;
+
+	// Fixed time steps (seconds) of candidate configurations (used for fixed time step explicit solver)
+	std::vector<double> candidateExplicitSolverFixedTimeSteps;
+
+	// Maximum error tolerances of candidate configurations (used for variable time step explicit solver)
+	std::vector<double> candidateExplicitSolverMaxErrorThresholds;
+
+	// Maximum numbers of rail vehicles per brake pipe finite element of candidate configurations
+	std::vector<int> candidateBrakePipeFiniteElementSizes;
+
+	// Adds candidate configuration for each brake pipe finite element size
+	// explicitSolverType				-->	Explicit solver integration type
+	// explicitSolverFixedTimeStep		-->	Fixed time step (seconds)
+	// explicitSolverMaxErrorThreshold	-->	Maximum error tolerance
+	void addCandidates(int explicitSolverType, double explicitSolverFixedTimeStep, double explicitSolverMaxErrorThreshold);
+
+	// Runs simulation prefix with single configuration (returns minimum computation time in seconds over timed runs, or negative value if simulation
+	// terminated early)
+	// numberOfTimedRuns				-->	Number of timed runs
+	// explicitSolverType				-->	Explicit solver integration type
+	// explicitSolverFixedTimeStep		-->	Fixed time step (seconds)
+	// explicitSolverMaxErrorThreshold	-->	Maximum error tolerance
+	// brakePipeFiniteElementSize		-->	Maximum number of rail vehicles per brake pipe finite element
+	// couplerForces					-->	Coupler forces (pounds) of each coupling system at end of each implicit solver time step
+	// brakeCylinderPressures			-->	Brake cylinder pressures (pounds / square inch) of each rail vehicle at end of each implicit solver time step
+	double run(int numberOfTimedRuns, int explicitSolverType, double explicitSolverFixedTimeStep, double explicitSolverMaxErrorThreshold, int brakePipeFiniteElementSize,
+		std::vector<double>* couplerForces, std::vector<double>* brakeCylinderPressures);
+
+	// Calculates maximum absolute difference between candidate history and reference history
+	// (each candidate value is compared with the closest reference value of the same variable within one implicit solver time step)
+	// candidateHistory		-->	Candidate history
+	// referenceHistory		-->	Reference history
+	// stride				-->	Number of values per implicit solver time step
+	double maxAbsoluteDifference(std::vector<double>* candidateHistory, std::vector<double>* referenceHistory, size_t stride);
+
+};
+
+#endif
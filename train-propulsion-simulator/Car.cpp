@@ -16,6 +16,7 @@
 #include "LocomotiveOperator.h"
 #include "ResultsWriter.h"
 #include "Simulation.h"
+#include "SimulationState.h"
 #include "Track.h"
 #include "TrainConsist.h"
 #include "UnitConverter.h"
@@ -325,8 +326,8 @@ void Car::convertToSI() {
 			physicalVariables[0]->intervals[i]->points[j]->x = x_si;
 			physicalVariables[0]->intervals[i]->points[j]->y = y_si;
 		}
-		((IntervalSmooth*)physicalVariables[0]->intervals[i])->zvcb = false;
 	}
+	physicalVariables[0]->compile();
 	// Physical variable 1 -- Brake shoe friction coefficient
 	for (size_t i = 0; i < physicalVariables[1]->intervals.size(); i++) {
 		for (size_t j = 0; j < physicalVariables[1]->intervals[i]->points.size(); j++) {
@@ -337,8 +338,8 @@ void Car::convertToSI() {
 			physicalVariables[1]->intervals[i]->points[j]->x = x_si;
 			physicalVariables[1]->intervals[i]->points[j]->y = y_si;
 		}
-		((IntervalSmooth*)physicalVariables[1]->intervals[i])->zvcb = false;
 	}
+	physicalVariables[1]->compile();
 	// Couplers
 	couplers[0]->convertToSI();
 	couplers[1]->convertToSI();
@@ -389,14 +390,12 @@ void Car::results(Simulation* simulation, bool whb) {
 	currResults.push_back(std::to_string(temp_var));
 	temp_var = UnitConverter::mps_To_Miph(ssv[1]);
 	currResults.push_back(std::to_string(temp_var));
-	temp_var = UnitConverter::rad_To_Pct(inputFileReader_Simulation->userDefinedTracks[0]->physicalVariables[0]->
-		interpolate(ssv[0], inputFileReader_Simulation->userDefinedTracks[0]->PVDMIN_SI[0], inputFileReader_Simulation->userDefinedTracks[0]->PVDMAX_SI[0]));
+	calc_trackProperties();
+	temp_var = UnitConverter::rad_To_Pct(trackProperties[0]);
 	currResults.push_back(std::to_string(temp_var));
-	temp_var = UnitConverter::gCurv_To_TrkCurv(inputFileReader_Simulation->userDefinedTracks[0]->physicalVariables[1]->
-		interpolate(ssv[0], inputFileReader_Simulation->userDefinedTracks[0]->PVDMIN_SI[1], inputFileReader_Simulation->userDefinedTracks[0]->PVDMAX_SI[1]));
+	temp_var = UnitConverter::gCurv_To_TrkCurv(trackProperties[1]);
 	currResults.push_back(std::to_string(temp_var));
-	temp_var = UnitConverter::rad_To_InSup(inputFileReader_Simulation->userDefinedTracks[0]->physicalVariables[2]->
-		interpolate(ssv[0], inputFileReader_Simulation->userDefinedTracks[0]->PVDMIN_SI[2], inputFileReader_Simulation->userDefinedTracks[0]->PVDMAX_SI[2]));
+	temp_var = UnitConverter::rad_To_InSup(trackProperties[2]);
 	currResults.push_back(std::to_string(temp_var));
 	if (positionInTrainConsist < ((int)inputFileReader_Simulation->userDefinedTrainConsists[0]->railVehicles.size() - 1)) {
 		temp_var = UnitConverter::m_To_In(couplers[1]->displacement);
@@ -489,3 +488,25 @@ void Car::calc_throttleForce() {
 	throttleForce = 0.0;
 }
 
+
+void Car::saveState(SimulationState* simulationState) {
+	RailVehicle::saveState(simulationState);
+	simulationState->append(auxiliaryReservoir->pressure, true);
+	simulationState->append(emergencyReservoir->pressure, true);
+	((ControlValve_Car*)controlValve)->saveState(simulationState);
+	if (endOfTrainDevice != NULL) {
+		endOfTrainDevice->saveState(simulationState);
+	}
+}
+
+
+void Car::loadState(SimulationState* simulationState) {
+	RailVehicle::loadState(simulationState);
+	auxiliaryReservoir->pressure = simulationState->next();
+	emergencyReservoir->pressure = simulationState->next();
+	((ControlValve_Car*)controlValve)->loadState(simulationState);
+	if (endOfTrainDevice != NULL) {
+		endOfTrainDevice->loadState(simulationState);
+	}
+}
+
@@ -12,6 +12,7 @@ class EmergencyReservoir;
 class EndOfTrainDevice;
 class InputFileReader_Simulation;
 class Simulation;
+class SimulationState;
 
 class Car : public RailVehicle {
 
@@ -40,6 +41,10 @@ public:
 
 	void calc_throttleForce() override;
 
+	void saveState(SimulationState* simulationState) override;
+
+	void loadState(SimulationState* simulationState) override;
+
 	// Initialize end-of-train device
 	void initialize_endOfTrainDevice();
 
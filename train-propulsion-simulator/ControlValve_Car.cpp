@@ -11,6 +11,7 @@
 #include "Function.h"
 #include "InputFileReader_Simulation.h"
 #include "LocomotiveOperator.h"
+#include "SimulationState.h"
 #include "TrainConsist.h"
 
 
@@ -252,3 +253,25 @@ void ControlValve_Car::calc_mdot_bc_atm() {
 		orificeArea, airTemperature);
 }
 
+
+void ControlValve_Car::saveState(SimulationState* simulationState) {
+	simulationState->append(currentOperatingMode, false);
+	simulationState->append(orificeBool_ar_bp, false);
+	simulationState->append(orificeBool_er_bp, false);
+	simulationState->append(orificeBool_bp_atm, false);
+	simulationState->append(orificeBool_bc_ar, false);
+	simulationState->append(orificeBool_bc_er, false);
+	simulationState->append(orificeBool_bc_atm, false);
+}
+
+
+void ControlValve_Car::loadState(SimulationState* simulationState) {
+	currentOperatingMode = (int)simulationState->next();
+	orificeBool_ar_bp = (simulationState->next() != 0.0);
+	orificeBool_er_bp = (simulationState->next() != 0.0);
+	orificeBool_bp_atm = (simulationState->next() != 0.0);
+	orificeBool_bc_ar = (simulationState->next() != 0.0);
+	orificeBool_bc_er = (simulationState->next() != 0.0);
+	orificeBool_bc_atm = (simulationState->next() != 0.0);
+}
+
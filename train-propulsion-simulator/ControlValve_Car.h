@@ -9,6 +9,7 @@
 #include "UnitConverter.h"
 
 class Car;
+class SimulationState;
 
 class ControlValve_Car : public ControlValve {
 
@@ -43,6 +44,14 @@ public:
 	// Calculates all air flows
 	void calc_mdot();
 
+	// Saves state (variables that persist from one implicit solver time step to the next)
+	// simulationState		-->	Simulation state
+	void saveState(SimulationState* simulationState);
+
+	// Loads state (variables that persist from one implicit solver time step to the next)
+	// simulationState		-->	Simulation state
+	void loadState(SimulationState* simulationState);
+
 private:
 
 	// Car
@@ -78,8 +78,8 @@ void Coupler::convertToSI() {
 			physicalVariables[0]->intervals[i]->points[j]->x = x_si;
 			physicalVariables[0]->intervals[i]->points[j]->y = y_si;
 		}
-		((IntervalSmooth*)physicalVariables[0]->intervals[i])->zvcb = false;
 	}
+	physicalVariables[0]->compile();
 }
 
 
@@ -3,9 +3,12 @@
 //////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
 
 
+#include <algorithm>
+#include <cmath>
 #include "CouplingSystem.h"
 #include "Coupler.h"
 #include "Function.h"
+#include "Interval.h"
 #include "RailVehicle.h"
 
 
@@ -58,50 +61,96 @@ void CouplingSystem::calc_totalForceOnLeadingRailVehicle() {
 }
 
 
-double CouplingSystem::calculateForceOnLeadingRVDueToStiffnessAndCalculateCouplerDisplacements() {
-	double deltax = std::abs(displacement / 10.0);
-	double d1 = 0.0; // displacement of trailing vehicle's leading coupler
-	double d2 = displacement; // displacement of leading vehicle's traling coupler
-	double fk1 = 0.0; // force of trailing vehicle's leading coupler due to stiffness
-	double fk2 = couplers[0]->PVDMAX_SI[0]; // force of leading vehicle's trailing coupler due to stiffness
-	do {
-		fk1 = couplers[1]->physicalVariables[0]->interpolate(d1, couplers[1]->PVDMIN_SI[0], couplers[1]->PVDMAX_SI[0]);
-		fk2 = couplers[0]->physicalVariables[0]->interpolate(d2, couplers[0]->PVDMIN_SI[0], couplers[0]->PVDMAX_SI[0]);
-		if (displacement > 0.0) {
-			if ((fk2 > fk1) && (std::abs(fk1 - fk2) > FORCE_CALCULATION_TOLERANCE)) {
-				d1 = d1 + deltax;
-				d2 = d2 - deltax;
-			}
-			else if ((fk2 < fk1) && (std::abs(fk1 - fk2) > FORCE_CALCULATION_TOLERANCE)) {
-				deltax = deltax / 1.5;
-				d1 = d1 - deltax;
-				d2 = d2 + deltax;
-			}
+void CouplingSystem::calc_compositeForceDisplacement() {
+	// Sampled force-displacement functions of leading coupler ('0') and trailing coupler ('1')
+	std::vector<double> x0, f0, x1, f1;
+	sampleForceDisplacement(couplers[0], &x0, &f0);
+	sampleForceDisplacement(couplers[1], &x1, &f1);
+	// Force levels (sampled forces within force range common to both couplers)
+	double fmin = std::max(f0[0], f1[0]);  // minimum common force
+	double fmax = std::min(f0[f0.size() - 1], f1[f1.size() - 1]);  // maximum common force
+	std::vector<double> fl;  // force levels
+	for (size_t i = 0; i < f0.size(); i++) {
+		if ((f0[i] >= fmin) && (f0[i] <= fmax)) {
+			fl.push_back(f0[i]);
 		}
-		else if (displacement < 0.0) {
-			if ((fk2 < fk1) && (std::abs(fk1 - fk2) > FORCE_CALCULATION_TOLERANCE)) {
-				d1 = d1 - deltax;
-				d2 = d2 + deltax;
-			}
-			else if ((fk2 > fk1) && (std::abs(fk1 - fk2) > FORCE_CALCULATION_TOLERANCE)) {
-				deltax = deltax / 1.5;
-				d1 = d1 + deltax;
-				d2 = d2 - deltax;
-			}
+	}
+	for (size_t i = 0; i < f1.size(); i++) {
+		if ((f1[i] >= fmin) && (f1[i] <= fmax)) {
+			fl.push_back(f1[i]);
 		}
-		else {
-			d1 = 0.0;
-			d2 = 0.0;
-			fk1 = 0.0;
-			fk2 = 0.0;
+	}
+	std::sort(fl.begin(), fl.end());
+	fl.erase(std::unique(fl.begin(), fl.end()), fl.end());
+	// Both couplers carry same force, so coupling system displacement is sum of coupler displacements at each force level
+	// (a force level at which a coupler function is flat, such as slack, adds entries for both ends of the flat range)
+	compositeDisplacements.clear();
+	compositeForces.clear();
+	compositeTrailingCouplerDisplacements.clear();
+	for (size_t i = 0; i < fl.size(); i++) {
+		double lx0, ux0, lx1, ux1;  // lower and upper displacements of each coupler
+		invertForceDisplacement(&x0, &f0, fl[i], &lx0, &ux0);
+		invertForceDisplacement(&x1, &f1, fl[i], &lx1, &ux1);
+		compositeDisplacements.push_back(lx0 + lx1);
+		compositeForces.push_back(fl[i]);
+		compositeTrailingCouplerDisplacements.push_back(lx1);
+		if ((ux0 > lx0) || (ux1 > lx1)) {
+			compositeDisplacements.push_back(ux0 + ux1);
+			compositeForces.push_back(fl[i]);
+			compositeTrailingCouplerDisplacements.push_back(ux1);
 		}
-	} while (std::abs(fk1 - fk2) > FORCE_CALCULATION_TOLERANCE);
+	}
+	// Beyond ends of table, coupler(s) that reached end of force-displacement function take remaining displacement
+	if (f0[0] == f1[0]) {
+		compositeLowerTrailingCouplerShare = 0.5;
+	}
+	else if (f1[0] == fmin) {
+		compositeLowerTrailingCouplerShare = 1.0;
+	}
+	else {
+		compositeLowerTrailingCouplerShare = 0.0;
+	}
+	if (f0[f0.size() - 1] == f1[f1.size() - 1]) {
+		compositeUpperTrailingCouplerShare = 0.5;
+	}
+	else if (f1[f1.size() - 1] == fmax) {
+		compositeUpperTrailingCouplerShare = 1.0;
+	}
+	else {
+		compositeUpperTrailingCouplerShare = 0.0;
+	}
+}
+
+
+double CouplingSystem::calculateForceOnLeadingRVDueToStiffnessAndCalculateCouplerDisplacements() {
+	double d1;  // displacement of trailing vehicle's leading coupler
+	double fk;  // force of both couplers due to stiffness
+	size_t n = compositeDisplacements.size();
+	if (displacement == 0.0) {
+		d1 = 0.0;
+		fk = 0.0;
+	}
+	else if (displacement <= compositeDisplacements[0]) {
+		d1 = compositeTrailingCouplerDisplacements[0] + (compositeLowerTrailingCouplerShare * (displacement - compositeDisplacements[0]));
+		fk = compositeForces[0];
+	}
+	else if (displacement >= compositeDisplacements[n - 1]) {
+		d1 = compositeTrailingCouplerDisplacements[n - 1] + (compositeUpperTrailingCouplerShare * (displacement - compositeDisplacements[n - 1]));
+		fk = compositeForces[n - 1];
+	}
+	else {
+		// Linear interpolation within composite force-displacement table
+		size_t i = std::upper_bound(compositeDisplacements.begin(), compositeDisplacements.end(), displacement) - compositeDisplacements.begin();
+		double w = (displacement - compositeDisplacements[i - 1]) / (compositeDisplacements[i] - compositeDisplacements[i - 1]);  // interpolation weight
+		d1 = compositeTrailingCouplerDisplacements[i - 1] + (w * (compositeTrailingCouplerDisplacements[i] - compositeTrailingCouplerDisplacements[i - 1]));
+		fk = compositeForces[i - 1] + (w * (compositeForces[i] - compositeForces[i - 1]));
+	}
 	// Set displacement for both couplers
 	couplers[1]->displacement = d1;
-	couplers[0]->displacement = d2;
+	couplers[0]->displacement = displacement - d1;
 	// Force on leading rail vehicle due to stiffness
-	// (note that polarity change is necessary for 'fk1' and 'fk2' due to sign convention in coupler force-displacement functions)
-	double forceOnLeadingRVDueToStiffness = (-fk1 + -fk2) / 2.0;
+	// (note that polarity change is necessary for 'fk' due to sign convention in coupler force-displacement functions)
+	double forceOnLeadingRVDueToStiffness = -fk;
 	return forceOnLeadingRVDueToStiffness;
 }
 
@@ -114,3 +163,57 @@ double CouplingSystem::calculateForceOnLeadingRVDueToDamping() {
 	return forceOnLeadingRVDueToDamping;
 }
 
+void CouplingSystem::sampleForceDisplacement(Coupler* coupler, std::vector<double>* displacements, std::vector<double>* forces) {
+	for (size_t i = 0; i < coupler->physicalVariables[0]->intervals.size(); i++) {
+		Interval* interval = coupler->physicalVariables[0]->intervals[i];
+		int ns = 1;  // number of sub-intervals
+		if (interval->points.size() > 2) {
+			ns = COMPOSITE_SAMPLES_PER_INTERVAL;
+		}
+		double xs = interval->points[0]->x;  // start of interval
+		double xe = interval->points[interval->points.size() - 1]->x;  // end of interval
+		for (int j = 0; j <= ns; j++) {
+			double x = xs + ((xe - xs) * ((double)j / (double)ns));
+			if (j == ns) {
+				x = xe;
+			}
+			if ((displacements->size() > 0) && (x <= (*displacements)[displacements->size() - 1])) {
+				continue;
+			}
+			double f = coupler->physicalVariables[0]->interpolate(x, coupler->PVDMIN_SI[0], coupler->PVDMAX_SI[0]);
+			if ((forces->size() > 0) && (f < (*forces)[forces->size() - 1])) {
+				f = (*forces)[forces->size() - 1];
+			}
+			displacements->push_back(x);
+			forces->push_back(f);
+		}
+	}
+}
+
+
+void CouplingSystem::invertForceDisplacement(std::vector<double>* displacements, std::vector<double>* forces, double force, double* lowerDisplacement, double* upperDisplacement) {
+	size_t n = forces->size();
+	// Smallest displacement (first sampled force not less than 'force')
+	size_t i = std::lower_bound(forces->begin(), forces->end(), force) - forces->begin();
+	if (i == 0) {
+		*lowerDisplacement = (*displacements)[0];
+	}
+	else if (i == n) {
+		*lowerDisplacement = (*displacements)[n - 1];
+	}
+	else if ((*forces)[i] == force) {
+		*lowerDisplacement = (*displacements)[i];
+	}
+	else {
+		*lowerDisplacement = (*displacements)[i - 1] + (((force - (*forces)[i - 1]) / ((*forces)[i] - (*forces)[i - 1])) * ((*displacements)[i] - (*displacements)[i - 1]));
+	}
+	// Largest displacement (last sampled force not greater than 'force')
+	size_t j = std::upper_bound(forces->begin(), forces->end(), force) - forces->begin();
+	if ((j > 0) && ((*forces)[j - 1] == force)) {
+		*upperDisplacement = (*displacements)[j - 1];
+	}
+	else {
+		*upperDisplacement = *lowerDisplacement;
+	}
+}
+
@@ -6,7 +6,6 @@
 #define COUPLING_SYSTEM_DEF
 
 #include <vector>
-#include "UnitConverter.h"
 
 class Coupler;
 
@@ -59,8 +58,15 @@ public:
 	// Calculates initial coupler displacements
 	void initialCouplerDisplacements();
 
+	// Calculates composite force-displacement table (series combination of force-displacement functions of both couplers)
+	// (Note: Coupler force-displacement functions must be converted to SI before this function is called)
+	void calc_compositeForceDisplacement();
+
 private:
 
+	// Batch evaluation copies composite force-displacement tables and writes displacements and forces
+	friend class CouplingSystemBatch;
+
 	// Displacement of coupling system (meters)
 	double displacement;
 
@@ -70,8 +76,24 @@ private:
 	// Current center-to-center distance between leading rail vehicle and trailing rail vehicle
 	double centerToCenterDistance;
 
-	// Acceptable tolerance for force calculation (newtons)
-	const double FORCE_CALCULATION_TOLERANCE = UnitConverter::kip_To_N(0.0001);
+	// Number of sampled points per interval of coupler force-displacement function with more than two points
+	// (intervals with two points are linear, and are represented exactly by their end points)
+	static const int COMPOSITE_SAMPLES_PER_INTERVAL = 64;
+
+	// Coupling system displacements of composite force-displacement table (meters)
+	std::vector<double> compositeDisplacements;
+
+	// Forces due to stiffness in both couplers of composite force-displacement table (newtons)
+	std::vector<double> compositeForces;
+
+	// Displacements of trailing coupler (leading coupler of trailing rail vehicle) of composite force-displacement table (meters)
+	std::vector<double> compositeTrailingCouplerDisplacements;
+
+	// Share of coupling system displacement beyond first entry of composite force-displacement table taken by trailing coupler
+	double compositeLowerTrailingCouplerShare;
+
+	// Share of coupling system displacement beyond last entry of composite force-displacement table taken by trailing coupler
+	double compositeUpperTrailingCouplerShare;
 
 	// Effective damping constant
 	double effectiveDampingConstant;
@@ -83,6 +105,20 @@ private:
 	// Calculates total (not tangential) force on leading rail vehicle due to damping
 	double calculateForceOnLeadingRVDueToDamping();
 
+	// Samples force-displacement function of coupler (forces are made non-decreasing)
+	// coupler			-->	Coupler
+	// displacements	-->	Sampled coupler displacements (meters)
+	// forces			-->	Sampled coupler forces (newtons)
+	static void sampleForceDisplacement(Coupler* coupler, std::vector<double>* displacements, std::vector<double>* forces);
+
+	// Calculates range of coupler displacements at which sampled force-displacement function has given force
+	// displacements		-->	Sampled coupler displacements (meters)
+	// forces				-->	Sampled coupler forces (newtons)
+	// force				-->	Force (newtons)
+	// lowerDisplacement	-->	Smallest coupler displacement with given force (meters)
+	// upperDisplacement	-->	Largest coupler displacement with given force (meters)
+	static void invertForceDisplacement(std::vector<double>* displacements, std::vector<double>* forces, double force, double* lowerDisplacement, double* upperDisplacement);
+
 };
 
 #endif
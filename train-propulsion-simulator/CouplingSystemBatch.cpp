@@ -0,0 +1,108 @@
+//////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+// This file is part of the TRAIN PROPULSION SIMULATOR repository available at github.com/lnaz01/train-propulsion-simulator //
+//////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+
+#include "CouplingSystemBatch.h"
+#include "Coupler.h"
+#include "CouplingSystem.h"
+#include "RailVehicle.h"
+#include "TrainConsist.h"
+
+
+CouplingSystemBatch::CouplingSystemBatch(TrainConsist* trainConsist) {
+	this->trainConsist = trainConsist;
+	size_t n = trainConsist->couplingSystems.size();  // number of coupling systems
+	positions.resize(trainConsist->railVehicles.size());
+	speeds.resize(trainConsist->railVehicles.size());
+	centerToCenterDistances.resize(n);
+	displacements.resize(n);
+	forcesDueToDamping.resize(n);
+	for (size_t i = 0; i < n; i++) {
+		CouplingSystem* cs = trainConsist->couplingSystems[i];
+		centerToCenterDistances_Unstressed.push_back(cs->centerToCenterDistance_Unstressed);
+		effectiveDampingConstants.push_back(cs->effectiveDampingConstant);
+		compositeOffsets.push_back(compositeDisplacements.size());
+		compositeDisplacements.insert(compositeDisplacements.end(), cs->compositeDisplacements.begin(), cs->compositeDisplacements.end());
+		compositeForces.insert(compositeForces.end(), cs->compositeForces.begin(), cs->compositeForces.end());
+		compositeTrailingCouplerDisplacements.insert(compositeTrailingCouplerDisplacements.end(), cs->compositeTrailingCouplerDisplacements.begin(),
+			cs->compositeTrailingCouplerDisplacements.end());
+		compositeLowerTrailingCouplerShares.push_back(cs->compositeLowerTrailingCouplerShare);
+		compositeUpperTrailingCouplerShares.push_back(cs->compositeUpperTrailingCouplerShare);
+		intervalHints.push_back(compositeOffsets[i] + 1);
+	}
+	compositeOffsets.push_back(compositeDisplacements.size());
+}
+
+
+CouplingSystemBatch::~CouplingSystemBatch() {}
+
+
+void CouplingSystemBatch::calc_totalForcesOnLeadingRailVehicles(size_t firstCouplingSystem, size_t lastCouplingSystem, bool staticBool) {
+	if (firstCouplingSystem >= lastCouplingSystem) {
+		return;
+	}
+	// Gather positions and speeds of rail vehicles connected by coupling systems in range
+	for (size_t i = firstCouplingSystem; i <= lastCouplingSystem; i++) {
+		RailVehicle* rv = trainConsist->railVehicles[i];
+		positions[i] = (staticBool == true) ? rv->ssv[0] : rv->ssvApp[0];
+		speeds[i] = rv->ssv[1];
+	}
+	// Displacements and forces due to damping (contiguous arrays without branches)
+	const double* x = positions.data();
+	const double* v = speeds.data();
+	const double* cu = centerToCenterDistances_Unstressed.data();
+	const double* c = effectiveDampingConstants.data();
+	double* cc = centerToCenterDistances.data();
+	double* d = displacements.data();
+	double* fc = forcesDueToDamping.data();
+	for (size_t i = firstCouplingSystem; i < lastCouplingSystem; i++) {
+		cc[i] = x[i] - x[i + 1];
+		d[i] = cc[i] - cu[i];
+		fc[i] = -(c[i] * (v[i] - v[i + 1]));
+	}
+	// Forces due to stiffness and coupler displacements from composite force-displacement tables
+	for (size_t i = firstCouplingSystem; i < lastCouplingSystem; i++) {
+		CouplingSystem* cs = trainConsist->couplingSystems[i];
+		size_t first = compositeOffsets[i];  // first table entry
+		size_t last = compositeOffsets[i + 1] - 1;  // last table entry
+		double di = d[i];  // coupling system displacement
+		double d1;  // displacement of trailing vehicle's leading coupler
+		double fk;  // force of both couplers due to stiffness
+		if (di == 0.0) {
+			d1 = 0.0;
+			fk = 0.0;
+		}
+		else if (di <= compositeDisplacements[first]) {
+			d1 = compositeTrailingCouplerDisplacements[first] + (compositeLowerTrailingCouplerShares[i] * (di - compositeDisplacements[first]));
+			fk = compositeForces[first];
+		}
+		else if (di >= compositeDisplacements[last]) {
+			d1 = compositeTrailingCouplerDisplacements[last] + (compositeUpperTrailingCouplerShares[i] * (di - compositeDisplacements[last]));
+			fk = compositeForces[last];
+		}
+		else {
+			// Move from interval of previous lookup to first table entry greater than displacement
+			size_t j = intervalHints[i];
+			while (compositeDisplacements[j] <= di) {
+				j++;
+			}
+			while (compositeDisplacements[j - 1] > di) {
+				j--;
+			}
+			intervalHints[i] = j;
+			// Linear interpolation within composite force-displacement table
+			double w = (di - compositeDisplacements[j - 1]) / (compositeDisplacements[j] - compositeDisplacements[j - 1]);  // interpolation weight
+			d1 = compositeTrailingCouplerDisplacements[j - 1] + (w * (compositeTrailingCouplerDisplacements[j] - compositeTrailingCouplerDisplacements[j - 1]));
+			fk = compositeForces[j - 1] + (w * (compositeForces[j] - compositeForces[j - 1]));
+		}
+		// Scatter results to coupling system and couplers
+		// (note that polarity change is necessary for 'fk' due to sign convention in coupler force-displacement functions)
+		cs->centerToCenterDistance = cc[i];
+		cs->displacement = di;
+		cs->couplers[1]->displacement = d1;
+		cs->couplers[0]->displacement = di - d1;
+		cs->totalForceOnLeadingRailVehicle = -fk + fc[i];
+	}
+}
+
@@ -0,0 +1,84 @@
+//////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+// This file is part of the TRAIN PROPULSION SIMULATOR repository available at github.com/lnaz01/train-propulsion-simulator //
+//////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+#ifndef COUPLING_SYSTEM_BATCH_DEF
+#define COUPLING_SYSTEM_BATCH_DEF
+
+#include <cstddef>
+#include <vector>
+
+class TrainConsist;
+
+// Batch evaluation of coupling system forces
+// (Coupling system properties and composite force-displacement tables are copied into contiguous arrays so that
+// displacements and damping forces of all coupling systems are calculated in simple loops the compiler can vectorize.
+// Results are identical to 'CouplingSystem::calc_totalForceOnLeadingRailVehicle'.)
+class CouplingSystemBatch {
+
+public:
+
+	// (Note: Coupling systems of train consist must be configured before batch is created)
+	// trainConsist		-->	Train consist
+	CouplingSystemBatch(TrainConsist* trainConsist);
+
+	virtual ~CouplingSystemBatch();
+
+	// Calculates total force on leading rail vehicle and coupler displacements of range of coupling systems
+	// firstCouplingSystem	-->	Index of first coupling system in range
+	// lastCouplingSystem	-->	Index of last coupling system in range plus one
+	// staticBool			-->	Determines whether to calculate center-to-center distances statically ('ssv') or dynamically ('ssvApp')
+	void calc_totalForcesOnLeadingRailVehicles(size_t firstCouplingSystem, size_t lastCouplingSystem, bool staticBool);
+
+private:
+
+	// Train consist
+	TrainConsist* trainConsist;
+
+	// Positions of rail vehicles (meters)
+	std::vector<double> positions;
+
+	// Speeds of rail vehicles (meters / second)
+	std::vector<double> speeds;
+
+	// Neutral (unstressed) center-to-center distances of coupling systems (meters)
+	std::vector<double> centerToCenterDistances_Unstressed;
+
+	// Effective damping constants of coupling systems
+	std::vector<double> effectiveDampingConstants;
+
+	// Center-to-center distances of coupling systems (meters)
+	std::vector<double> centerToCenterDistances;
+
+	// Displacements of coupling systems (meters)
+	std::vector<double> displacements;
+
+	// Forces on leading rail vehicles due to damping (newtons)
+	std::vector<double> forcesDueToDamping;
+
+	// Offsets of composite force-displacement tables of coupling systems in flattened tables
+	// (table of coupling system 'i' occupies indices 'compositeOffsets[i]' to 'compositeOffsets[i + 1] - 1')
+	std::vector<size_t> compositeOffsets;
+
+	// Flattened coupling system displacements of composite force-displacement tables (meters)
+	std::vector<double> compositeDisplacements;
+
+	// Flattened forces due to stiffness of composite force-displacement tables (newtons)
+	std::vector<double> compositeForces;
+
+	// Flattened trailing coupler displacements of composite force-displacement tables (meters)
+	std::vector<double> compositeTrailingCouplerDisplacements;
+
+	// Shares of coupling system displacement below first table entry taken by trailing coupler
+	std::vector<double> compositeLowerTrailingCouplerShares;
+
+	// Shares of coupling system displacement above last table entry taken by trailing coupler
+	std::vector<double> compositeUpperTrailingCouplerShares;
+
+	// Index of table entry ending interval used in previous lookup of each coupling system
+	// (coupling system displacements change little from one stage to the next, so search starts from this interval)
+	std::vector<size_t> intervalHints;
+
+};
+
+#endif
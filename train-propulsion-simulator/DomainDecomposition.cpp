@@ -0,0 +1,347 @@
+//////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+// This file is part of the TRAIN PROPULSION SIMULATOR repository available at github.com/lnaz01/train-propulsion-simulator //
+//////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+
+#include <cmath>
+#include <limits>
+#include "DomainDecomposition.h"
+#include "AuxiliaryReservoir.h"
+#include "BrakeCylinder.h"
+#include "Car.h"
+#include "ControlValve_Car.h"
+#include "CouplingSystem.h"
+#include "CouplingSystemBatch.h"
+#include "EmergencyReservoir.h"
+#include "InputFileReader_Simulation.h"
+#include "InputFileReader_SolverSettings.h"
+#include "RailVehicle.h"
+#include "Simulation.h"
+#include "TrainConsist.h"
+#include "UnitConverter.h"
+
+
+DomainDecomposition::DomainDecomposition(Simulation* simulation, InputFileReader_SolverSettings* inputFileReader_SolverSettings) {
+	this->simulation = simulation;
+	trainConsist = simulation->inputFileReader_Simulation->userDefinedTrainConsists[0];
+	waveformRelaxationBool = (inputFileReader_SolverSettings->domainDecompositionInterfaceTolerance > 0.0);
+	interfaceTolerance = UnitConverter::lb_To_N(inputFileReader_SolverSettings->domainDecompositionInterfaceTolerance);
+	maximumNumberOfInterfaceIterations = inputFileReader_SolverSettings->domainDecompositionInterfaceIterations;
+	relaxedTimeStepBool = false;
+	initialPressureCalculationBool = false;
+	numberOfUnconvergedTimeSteps = 0;
+	currentAlgorithmStep = 0;
+	// Number of blocks (reduced so that every block has at least the minimum number of rail vehicles)
+	int numberOfRailVehicles = trainConsist->railVehicles.size();
+	numberOfBlocks = inputFileReader_SolverSettings->domainDecompositionNumberOfBlocks;
+	if (numberOfBlocks > (numberOfRailVehicles / MIN_RAIL_VEHICLES_PER_BLOCK)) {
+		numberOfBlocks = numberOfRailVehicles / MIN_RAIL_VEHICLES_PER_BLOCK;
+	}
+	if (numberOfBlocks < 1) {
+		numberOfBlocks = 1;
+	}
+	// Split rail vehicles into contiguous blocks of (nearly) equal size
+	for (int i = 0; i <= numberOfBlocks; i++) {
+		firstRailVehicles.push_back((size_t)(((long long)i * numberOfRailVehicles) / numberOfBlocks));
+	}
+	for (int i = 0; i < numberOfBlocks; i++) {
+		interfaceForces.push_back(0.0);
+		interfaceStepForces.push_back(std::vector<double>(simulation->explicitSolverNumSteps, 0.0));
+		interfaceForceChanges.push_back(0.0);
+		firstRailVehiclePositions.push_back(std::vector<double>(simulation->explicitSolverNumSteps, 0.0));
+		lastRailVehiclePositions.push_back(std::vector<double>(simulation->explicitSolverNumSteps, 0.0));
+		blockErrors.push_back(0.0);
+	}
+	// Start worker threads
+	currentPhase = PHASE_EXIT;
+	phaseGeneration = 0;
+	numberOfWorkersDone = 0;
+	for (int i = 1; i < numberOfBlocks; i++) {
+		workerThreads.push_back(std::thread(&DomainDecomposition::workerLoop, this, i));
+	}
+}
+
+
+DomainDecomposition::~DomainDecomposition() {
+	{
+		std::lock_guard<std::mutex> lock(phaseMutex);
+		currentPhase = PHASE_EXIT;
+		phaseGeneration++;
+	}
+	phaseStartCondition.notify_all();
+	for (size_t i = 0; i < workerThreads.size(); i++) {
+		workerThreads[i].join();
+	}
+}
+
+
+void DomainDecomposition::calc_couplingSystemForces() {
+	runPhase(PHASE_COUPLING_SYSTEM_FORCES);
+}
+
+
+double DomainDecomposition::calc_explicitSolverSteps(bool update_ssvBool) {
+	if (waveformRelaxationBool == false) {
+		calc_exchangedExplicitSolverSteps(update_ssvBool);
+	}
+	else {
+		// Waveform relaxation of interface forces (first iteration holds interface forces constant over time step)
+		relaxedTimeStepBool = true;
+		for (int i = 0; i < numberOfBlocks; i++) {
+			for (int l = 0; l < simulation->explicitSolverNumSteps; l++) {
+				interfaceStepForces[i][l] = interfaceForces[i];
+			}
+		}
+		bool convergedBool = false;
+		for (int i = 0; (i < maximumNumberOfInterfaceIterations) && (convergedBool == false); i++) {
+			runPhase(PHASE_EXPLICIT_SOLVER_STEPS);
+			runPhase(PHASE_INTERFACE_CORRECTION);
+			convergedBool = true;
+			for (int j = 0; j < numberOfBlocks; j++) {
+				if (interfaceForceChanges[j] > interfaceTolerance) {
+					convergedBool = false;
+				}
+			}
+		}
+		relaxedTimeStepBool = false;
+		if (convergedBool == false) {
+			numberOfUnconvergedTimeSteps++;
+			// Time step is rejected by variable time step explicit solver if interface forces have not converged
+			if (simulation->explicitSolverType == 1) {
+				return std::numeric_limits<double>::max();
+			}
+			// Time step is repeated with interface forces exchanged at every algorithm step by fixed time step explicit solver
+			calc_exchangedExplicitSolverSteps(update_ssvBool);
+		}
+		else if (update_ssvBool == true) {
+			runPhase(PHASE_UPDATE);
+		}
+	}
+	double maxBlockError = 0.0;
+	for (int i = 0; i < numberOfBlocks; i++) {
+		if (blockErrors[i] > maxBlockError) {
+			maxBlockError = blockErrors[i];
+		}
+	}
+	return maxBlockError;
+}
+
+
+void DomainDecomposition::update_ssv() {
+	runPhase(PHASE_UPDATE);
+}
+
+
+void DomainDecomposition::calc_railVehiclePneumatics(bool initialPressureCalculationBool) {
+	this->initialPressureCalculationBool = initialPressureCalculationBool;
+	runPhase(PHASE_RAIL_VEHICLE_PNEUMATICS);
+}
+
+
+void DomainDecomposition::calc_exchangedExplicitSolverSteps(bool update_ssvBool) {
+	for (int l = 0; l < simulation->explicitSolverNumSteps; l++) {
+		currentAlgorithmStep = l;
+		runPhase(PHASE_ALGORITHM_STEP_STATE_SPACE_VARIABLES);
+		runPhase(PHASE_ALGORITHM_STEP_COUPLING_SYSTEM_FORCES);
+	}
+	if (update_ssvBool == true) {
+		runPhase(PHASE_ALGORITHM_STEP_RESULTS_AND_UPDATE);
+	}
+	else {
+		runPhase(PHASE_ALGORITHM_STEP_RESULTS);
+	}
+}
+
+
+void DomainDecomposition::runPhase(int phase) {
+	{
+		std::lock_guard<std::mutex> lock(phaseMutex);
+		currentPhase = phase;
+		numberOfWorkersDone = 0;
+		phaseGeneration++;
+	}
+	phaseStartCondition.notify_all();
+	// First block is executed by calling thread
+	executePhase(phase, 0);
+	// Wait for worker threads
+	std::unique_lock<std::mutex> lock(phaseMutex);
+	phaseDoneCondition.wait(lock, [this] { return numberOfWorkersDone == (numberOfBlocks - 1); });
+}
+
+
+void DomainDecomposition::workerLoop(int blockIndex) {
+	int generation = 0;
+	while (true) {
+		int phase;
+		{
+			std::unique_lock<std::mutex> lock(phaseMutex);
+			phaseStartCondition.wait(lock, [this, generation] { return phaseGeneration != generation; });
+			generation = phaseGeneration;
+			phase = currentPhase;
+		}
+		if (phase == PHASE_EXIT) {
+			return;
+		}
+		executePhase(phase, blockIndex);
+		{
+			std::lock_guard<std::mutex> lock(phaseMutex);
+			numberOfWorkersDone++;
+		}
+		phaseDoneCondition.notify_one();
+	}
+}
+
+
+void DomainDecomposition::executePhase(int phase, int blockIndex) {
+	size_t lrv = firstRailVehicles[blockIndex + 1] - 1;  // last rail vehicle of block
+	// (Coupling system 'i' connects rail vehicle 'i' and rail vehicle 'i + 1', so coupling system 'lrv' is interface coupling system with next block)
+	if (phase == PHASE_COUPLING_SYSTEM_FORCES) {
+		trainConsist->couplingSystemBatch->calc_totalForcesOnLeadingRailVehicles(firstRailVehicles[blockIndex], lrv, true);  // also updates coupler displacements
+		if (hasInterface(blockIndex) == true) {
+			trainConsist->couplingSystems[lrv]->calc_centerToCenterDistance(true);
+			trainConsist->couplingSystems[lrv]->calc_displacement();
+			trainConsist->couplingSystems[lrv]->calc_totalForceOnLeadingRailVehicle();  // also updates coupler displacements
+			interfaceForces[blockIndex] = trainConsist->couplingSystems[lrv]->totalForceOnLeadingRailVehicle;
+		}
+	}
+	else if (phase == PHASE_EXPLICIT_SOLVER_STEPS) {
+		// Interface coupling system forces are taken from previous waveform relaxation iteration
+		for (int l = 0; l < simulation->explicitSolverNumSteps; l++) {
+			calc_stateSpaceVariables(blockIndex, l);
+			firstRailVehiclePositions[blockIndex][l] = trainConsist->railVehicles[firstRailVehicles[blockIndex]]->ssvApp[0];
+			lastRailVehiclePositions[blockIndex][l] = trainConsist->railVehicles[lrv]->ssvApp[0];
+			calc_interiorCouplingSystemForces(blockIndex);
+			calc_rates(blockIndex, l);
+		}
+		calc_results(blockIndex);
+	}
+	else if (phase == PHASE_INTERFACE_CORRECTION) {
+		// Interface force of each algorithm step is recalculated from approximated positions of both blocks at that algorithm step
+		if (hasInterface(blockIndex) == true) {
+			interfaceForceChanges[blockIndex] = 0.0;
+			for (int l = 0; l < simulation->explicitSolverNumSteps; l++) {
+				trainConsist->railVehicles[lrv]->ssvApp[0] = lastRailVehiclePositions[blockIndex][l];
+				trainConsist->railVehicles[lrv + 1]->ssvApp[0] = firstRailVehiclePositions[blockIndex + 1][l];
+				trainConsist->couplingSystems[lrv]->calc_centerToCenterDistance(false);
+				trainConsist->couplingSystems[lrv]->calc_displacement();
+				trainConsist->couplingSystems[lrv]->calc_totalForceOnLeadingRailVehicle();  // also updates coupler displacements
+				double change = std::abs(trainConsist->couplingSystems[lrv]->totalForceOnLeadingRailVehicle - interfaceStepForces[blockIndex][l]);
+				if (change > interfaceForceChanges[blockIndex]) {
+					interfaceForceChanges[blockIndex] = change;
+				}
+				interfaceStepForces[blockIndex][l] = trainConsist->couplingSystems[lrv]->totalForceOnLeadingRailVehicle;
+			}
+		}
+	}
+	else if (phase == PHASE_UPDATE) {
+		update_ssv(blockIndex);
+	}
+	else if (phase == PHASE_ALGORITHM_STEP_STATE_SPACE_VARIABLES) {
+		if (currentAlgorithmStep > 0) {
+			calc_rates(blockIndex, currentAlgorithmStep - 1);
+		}
+		calc_stateSpaceVariables(blockIndex, currentAlgorithmStep);
+	}
+	else if (phase == PHASE_ALGORITHM_STEP_COUPLING_SYSTEM_FORCES) {
+		calc_interiorCouplingSystemForces(blockIndex);
+		if (hasInterface(blockIndex) == true) {
+			trainConsist->couplingSystems[lrv]->calc_centerToCenterDistance(false);
+			trainConsist->couplingSystems[lrv]->calc_displacement();
+			trainConsist->couplingSystems[lrv]->calc_totalForceOnLeadingRailVehicle();  // also updates coupler displacements
+		}
+	}
+	else if ((phase == PHASE_ALGORITHM_STEP_RESULTS) || (phase == PHASE_ALGORITHM_STEP_RESULTS_AND_UPDATE)) {
+		calc_rates(blockIndex, simulation->explicitSolverNumSteps - 1);
+		calc_results(blockIndex);
+		if (phase == PHASE_ALGORITHM_STEP_RESULTS_AND_UPDATE) {
+			update_ssv(blockIndex);
+		}
+	}
+	else if (phase == PHASE_RAIL_VEHICLE_PNEUMATICS) {
+		// (Each rail vehicle only reads its own brake pipe pressure, so rail vehicles are calculated in same order as without domain decomposition)
+		for (size_t i = firstRailVehicles[blockIndex]; i < firstRailVehicles[blockIndex + 1]; i++) {
+			if (trainConsist->railVehicleTypes[i] == 0) {
+				Car* car = (Car*)trainConsist->railVehicles[i];
+				((ControlValve_Car*)car->controlValve)->calc_currentOperatingMode();
+				((ControlValve_Car*)car->controlValve)->calc_mdot();
+				car->auxiliaryReservoir->calc_pressure();
+				car->emergencyReservoir->calc_pressure();
+			}
+			trainConsist->railVehicles[i]->brakeCylinder->calc_pressure(initialPressureCalculationBool);
+		}
+	}
+}
+
+
+void DomainDecomposition::calc_stateSpaceVariables(int blockIndex, int algorithmStep) {
+	for (size_t i = firstRailVehicles[blockIndex]; i < firstRailVehicles[blockIndex + 1]; i++) {
+		trainConsist->railVehicles[i]->calc_ssvApp(algorithmStep);
+	}
+}
+
+
+void DomainDecomposition::calc_interiorCouplingSystemForces(int blockIndex) {
+	trainConsist->couplingSystemBatch->calc_totalForcesOnLeadingRailVehicles(firstRailVehicles[blockIndex], firstRailVehicles[blockIndex + 1] - 1, false);  // also updates coupler displacements
+}
+
+
+void DomainDecomposition::calc_rates(int blockIndex, int algorithmStep) {
+	// Calculate tangential component of leading and trailing coupler for each rail vehicle
+	for (size_t i = firstRailVehicles[blockIndex]; i < firstRailVehicles[blockIndex + 1]; i++) {
+		trainConsist->railVehicles[i]->calc_tangentialForceDueToLeadingCoupler();
+		trainConsist->railVehicles[i]->calc_tangentialForceDueToTrailingCoupler();
+	}
+	if (relaxedTimeStepBool == true) {
+		calc_interfaceTangentialForces(blockIndex, algorithmStep);
+	}
+	// Calculate state space variable rates of change
+	for (size_t i = firstRailVehicles[blockIndex]; i < firstRailVehicles[blockIndex + 1]; i++) {
+		trainConsist->railVehicles[i]->calc_ssvDot();
+	}
+	// Calculate k values for algorithm step (to be used in next algorithm step)
+	for (size_t i = firstRailVehicles[blockIndex]; i < firstRailVehicles[blockIndex + 1]; i++) {
+		trainConsist->railVehicles[i]->calc_kVals(algorithmStep);
+	}
+}
+
+
+void DomainDecomposition::calc_interfaceTangentialForces(int blockIndex, int algorithmStep) {
+	// Interface coupling system with previous block
+	if (blockIndex > 0) {
+		trainConsist->railVehicles[firstRailVehicles[blockIndex]]->calc_tangentialForceDueToLeadingCoupler(interfaceStepForces[blockIndex - 1][algorithmStep]);
+	}
+	// Interface coupling system with next block
+	if (hasInterface(blockIndex) == true) {
+		trainConsist->railVehicles[firstRailVehicles[blockIndex + 1] - 1]->calc_tangentialForceDueToTrailingCoupler(interfaceStepForces[blockIndex][algorithmStep]);
+	}
+}
+
+
+void DomainDecomposition::calc_results(int blockIndex) {
+	double curr_est_err = 0.0;  // current estimated error
+	for (size_t i = firstRailVehicles[blockIndex]; i < firstRailVehicles[blockIndex + 1]; i++) {
+		trainConsist->railVehicles[i]->calc_res4();
+		if (simulation->explicitSolverType == 1) {
+			// Rail vehicle error
+			trainConsist->railVehicles[i]->calc_res5();
+			double ee = trainConsist->railVehicles[i]->calc_ee();  // estimated error
+			if (ee > curr_est_err) {
+				curr_est_err = ee;
+			}
+		}
+	}
+	blockErrors[blockIndex] = curr_est_err;
+}
+
+
+void DomainDecomposition::update_ssv(int blockIndex) {
+	for (size_t i = firstRailVehicles[blockIndex]; i < firstRailVehicles[blockIndex + 1]; i++) {
+		trainConsist->railVehicles[i]->update_ssv();
+	}
+}
+
+
+bool DomainDecomposition::hasInterface(int blockIndex) {
+	return (blockIndex < (numberOfBlocks - 1));
+}
+
@@ -0,0 +1,194 @@
+//////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+// This file is part of the TRAIN PROPULSION SIMULATOR repository available at github.com/lnaz01/train-propulsion-simulator //
+//////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+#ifndef DOMAIN_DECOMPOSITION_DEF
+#define DOMAIN_DECOMPOSITION_DEF
+
+#include <condition_variable>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+class InputFileReader_SolverSettings;
+class Simulation;
+class TrainConsist;
+
+// Spatial domain decomposition of explicit solver
+// (The rail vehicles of the train consist are split into contiguous blocks, and each block is integrated by its own 
+// thread.  If the interface tolerance is zero, the force of each coupling system at the interface between two blocks is 
+// exchanged at every explicit solver algorithm step, so that the results are identical to those of the explicit solver 
+// without domain decomposition, but blocks synchronize twice per algorithm step.  Otherwise, interface forces are solved 
+// by waveform relaxation: each block integrates the whole explicit solver time step with the interface forces of all 
+// algorithm steps taken from the previous iteration, the interface forces are then recalculated from the approximated 
+// positions of both blocks at each algorithm step, and the time step is repeated until no interface force changes by more 
+// than the interface tolerance, so that blocks only synchronize twice per iteration.  At convergence, the results 
+// approach those of the explicit solver without domain decomposition.  A time step that has not converged after the 
+// maximum number of iterations is rejected by the variable time step explicit solver, and repeated with interface forces 
+// exchanged at every algorithm step by the fixed time step explicit solver.  Control valves, reservoirs, and brake 
+// cylinders of the blocks are also calculated concurrently, while the brake pipe is solved for the whole train consist.)
+class DomainDecomposition {
+
+public:
+
+	// simulation						-->	Simulation (must be initialized)
+	// inputFileReader_SolverSettings	-->	Solver settings input file reader
+	DomainDecomposition(Simulation* simulation, InputFileReader_SolverSettings* inputFileReader_SolverSettings);
+
+	virtual ~DomainDecomposition();
+
+	// Number of blocks
+	int numberOfBlocks;
+
+	// Number of explicit solver time steps whose waveform relaxation has not converged after maximum number of iterations
+	int numberOfUnconvergedTimeSteps;
+
+	// Calculates coupling system forces using state space variables (at start of explicit solver time step)
+	void calc_couplingSystemForces();
+
+	// Performs all explicit solver algorithm steps and calculates fourth (and fifth) order results (returns maximum estimated error)
+	// update_ssvBool	-->	Update state space variables boolean (if 'true', then state space variables are also updated)
+	double calc_explicitSolverSteps(bool update_ssvBool);
+
+	// Updates state space variables
+	void update_ssv();
+
+	// Calculates control valve operating modes and mass flow rates, reservoir pressures, and brake cylinder pressures of rail vehicles
+	// initialPressureCalculationBool	-->	Initial brake cylinder pressure calculation boolean (first implicit solver time step)
+	void calc_railVehiclePneumatics(bool initialPressureCalculationBool);
+
+private:
+
+	// Minimum number of rail vehicles per block
+	const int MIN_RAIL_VEHICLES_PER_BLOCK = 2;
+
+	// Phases executed concurrently by all blocks
+	static const int PHASE_EXIT = 0;  // end worker threads
+	static const int PHASE_COUPLING_SYSTEM_FORCES = 1;  // coupling system forces at start of time step
+	static const int PHASE_EXPLICIT_SOLVER_STEPS = 2;  // explicit solver algorithm steps with interface forces of previous waveform relaxation iteration
+	static const int PHASE_INTERFACE_CORRECTION = 3;  // interface forces of each algorithm step
+	static const int PHASE_UPDATE = 4;  // update of state space variables
+	static const int PHASE_ALGORITHM_STEP_STATE_SPACE_VARIABLES = 5;  // rates of change of previous algorithm step and state space variables of current algorithm step
+	static const int PHASE_ALGORITHM_STEP_COUPLING_SYSTEM_FORCES = 6;  // coupling system forces (including interface coupling systems) of current algorithm step
+	static const int PHASE_ALGORITHM_STEP_RESULTS = 7;  // rates of change of last algorithm step and results
+	static const int PHASE_ALGORITHM_STEP_RESULTS_AND_UPDATE = 8;  // rates of change of last algorithm step, results, and update of state space variables
+	static const int PHASE_RAIL_VEHICLE_PNEUMATICS = 9;  // control valves, reservoirs, and brake cylinders
+
+	// Simulation
+	Simulation* simulation;
+
+	// Train consist
+	TrainConsist* trainConsist;
+
+	// Waveform relaxation boolean ('false' if interface forces are exchanged at every explicit solver algorithm step)
+	bool waveformRelaxationBool;
+
+	// Interface force tolerance of waveform relaxation (newtons)
+	double interfaceTolerance;
+
+	// Maximum number of waveform relaxation iterations per explicit solver time step
+	int maximumNumberOfInterfaceIterations;
+
+	// Relaxed time step boolean ('true' while current explicit solver time step is integrated by waveform relaxation)
+	bool relaxedTimeStepBool;
+
+	// Initial brake cylinder pressure calculation boolean of current rail vehicle pneumatics phase
+	bool initialPressureCalculationBool;
+
+	// Current explicit solver algorithm step
+	int currentAlgorithmStep;
+
+	// Index of first rail vehicle of each block (last element is number of rail vehicles)
+	std::vector<size_t> firstRailVehicles;
+
+	// Interface coupling system force at start of explicit solver time step for each block (newtons)
+	std::vector<double> interfaceForces;
+
+	// Interface coupling system force of each explicit solver algorithm step for each block (newtons)
+	// (current waveform relaxation iterate)
+	std::vector<std::vector<double>> interfaceStepForces;
+
+	// Maximum change of interface coupling system forces for each block in last waveform relaxation iteration (newtons)
+	std::vector<double> interfaceForceChanges;
+
+	// Approximated position of first rail vehicle of each explicit solver algorithm step for each block (meters)
+	std::vector<std::vector<double>> firstRailVehiclePositions;
+
+	// Approximated position of last rail vehicle of each explicit solver algorithm step for each block (meters)
+	std::vector<std::vector<double>> lastRailVehiclePositions;
+
+	// Maximum estimated error of each block
+	std::vector<double> blockErrors;
+
+	// Worker threads (one for each block except first block, which is integrated by calling thread)
+	std::vector<std::thread> workerThreads;
+
+	// Phase mutex
+	std::mutex phaseMutex;
+
+	// Phase start condition
+	std::condition_variable phaseStartCondition;
+
+	// Phase done condition
+	std::condition_variable phaseDoneCondition;
+
+	// Current phase
+	int currentPhase;
+
+	// Phase generation (incremented each time a phase is started)
+	int phaseGeneration;
+
+	// Number of worker threads that have finished current phase
+	int numberOfWorkersDone;
+
+	// Performs all explicit solver algorithm steps with interface forces exchanged at every algorithm step
+	// update_ssvBool	-->	Update state space variables boolean (if 'true', then state space variables are also updated)
+	void calc_exchangedExplicitSolverSteps(bool update_ssvBool);
+
+	// Executes phase concurrently for all blocks
+	// phase	-->	Phase
+	void runPhase(int phase);
+
+	// Worker thread loop
+	// blockIndex	-->	Block index
+	void workerLoop(int blockIndex);
+
+	// Executes phase for single block
+	// phase		-->	Phase
+	// blockIndex	-->	Block index
+	void executePhase(int phase, int blockIndex);
+
+	// Calculates state space variables of block for algorithm step
+	// blockIndex		-->	Block index
+	// algorithmStep	-->	Explicit solver algorithm step
+	void calc_stateSpaceVariables(int blockIndex, int algorithmStep);
+
+	// Calculates forces of coupling systems inside block using approximated state space variables
+	// blockIndex		-->	Block index
+	void calc_interiorCouplingSystemForces(int blockIndex);
+
+	// Calculates tangential coupler forces, state space variable rates of change, and k values of block for algorithm step
+	// blockIndex		-->	Block index
+	// algorithmStep	-->	Explicit solver algorithm step
+	void calc_rates(int blockIndex, int algorithmStep);
+
+	// Calculates tangential forces of interface coupling systems on first and last rail vehicles of block from interface forces of algorithm step
+	// blockIndex		-->	Block index
+	// algorithmStep	-->	Explicit solver algorithm step
+	void calc_interfaceTangentialForces(int blockIndex, int algorithmStep);
+
+	// Calculates fourth (and fifth) order results and maximum estimated error of block
+	// blockIndex		-->	Block index
+	void calc_results(int blockIndex);
+
+	// Updates state space variables of block
+	// blockIndex		-->	Block index
+	void update_ssv(int blockIndex);
+
+	// Returns 'true' if block has interface coupling system with next block
+	// blockIndex	-->	Block index
+	bool hasInterface(int blockIndex);
+
+};
+
+#endif
@@ -9,6 +9,7 @@
 #include "Locomotive.h"
 #include "LocomotiveOperator.h"
 #include "Simulation.h"
+#include "SimulationState.h"
 #include "TrainConsist.h"
 
 
@@ -68,3 +69,21 @@ void EndOfTrainDevice::calc_pressureAfterTwoWayEOTActivation() {
 	}
 }
 
+
+void EndOfTrainDevice::saveState(SimulationState* simulationState) {
+	simulationState->append(twoWayEOTActivatedBool, false);
+	simulationState->append(pressureAfterTwoWayEOTActivation, true);
+	simulationState->append(timeOf2WayEOTActivation, false);
+	simulationState->append(pressureAtTimeOfTwoWayEOTActivation, false);
+	simulationState->append(rateOfChangeOfPressureAfterTwoWayEOTActivation, false);
+}
+
+
+void EndOfTrainDevice::loadState(SimulationState* simulationState) {
+	twoWayEOTActivatedBool = (simulationState->next() != 0.0);
+	pressureAfterTwoWayEOTActivation = simulationState->next();
+	timeOf2WayEOTActivation = simulationState->next();
+	pressureAtTimeOfTwoWayEOTActivation = simulationState->next();
+	rateOfChangeOfPressureAfterTwoWayEOTActivation = simulationState->next();
+}
+
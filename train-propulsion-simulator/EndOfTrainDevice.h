@@ -7,6 +7,7 @@
 
 class Car;
 class Locomotive;
+class SimulationState;
 
 class EndOfTrainDevice {
 
@@ -25,6 +26,14 @@ public:
 	// Calculates pressure (boundary condition) after two-way EOT activation
 	void calc_pressureAfterTwoWayEOTActivation();
 
+	// Saves state (variables that persist from one implicit solver time step to the next)
+	// simulationState		-->	Simulation state
+	void saveState(SimulationState* simulationState);
+
+	// Loads state (variables that persist from one implicit solver time step to the next)
+	// simulationState		-->	Simulation state
+	void loadState(SimulationState* simulationState);
+
 private:
 
 	// Car
@@ -6,6 +6,7 @@
 #include "ExplicitSSComponent.h"
 #include "InputFileReader_Simulation.h"
 #include "Simulation.h"
+#include "SimulationState.h"
 
 
 ExplicitSSComponent::ExplicitSSComponent(InputFileReader_Simulation* inputFileReader_Simulation, int physicalConstantsSize, int physicalVariablesSize,
@@ -45,25 +46,30 @@ void ExplicitSSComponent::update_ssv() {
 
 
 void ExplicitSSComponent::calc_ssvApp(InputFileReader_Simulation* inputFileReader_Simulation) {
+	calc_ssvApp(inputFileReader_Simulation->userDefinedSimulations[0]->explicitSolverStepIndex);
+}
+
+
+void ExplicitSSComponent::calc_ssvApp(int explicitSolverStepIndex) {
 	if (inputFileReader_Simulation->userDefinedSimulations[0]->explicitSolverType == 0) {
-		if (inputFileReader_Simulation->userDefinedSimulations[0]->explicitSolverStepIndex == 0) {
+		if (explicitSolverStepIndex == 0) {
 			for (int i = 0; i < ssvSize; i++) {
 				ssvApp[i] = ssv[i];
 			}
 		}
-		else if (inputFileReader_Simulation->userDefinedSimulations[0]->explicitSolverStepIndex == 1) {
+		else if (explicitSolverStepIndex == 1) {
 			for (int i = 0; i < ssvSize; i++) {
 				ssvApp[i] = ssv[i]
 					+ ((1.0 / 2.0) * kVals[0][i]);
 			}
 		}
-		else if (inputFileReader_Simulation->userDefinedSimulations[0]->explicitSolverStepIndex == 2) {
+		else if (explicitSolverStepIndex == 2) {
 			for (int i = 0; i < ssvSize; i++) {
 				ssvApp[i] = ssv[i]
 					+ ((1.0 / 2.0) * kVals[1][i]);
 			}
 		}
-		else if (inputFileReader_Simulation->userDefinedSimulations[0]->explicitSolverStepIndex == 3) {
+		else if (explicitSolverStepIndex == 3) {
 			for (int i = 0; i < ssvSize; i++) {
 				ssvApp[i] = ssv[i]
 					+ kVals[2][i];
@@ -71,25 +77,25 @@ void ExplicitSSComponent::calc_ssvApp(InputFileReader_Simulation* inputFileReade
 		}
 	}
 	else if (inputFileReader_Simulation->userDefinedSimulations[0]->explicitSolverType == 1) {
-		if (inputFileReader_Simulation->userDefinedSimulations[0]->explicitSolverStepIndex == 0) {
+		if (explicitSolverStepIndex == 0) {
 			for (int i = 0; i < ssvSize; i++) {
 				ssvApp[i] = ssv[i];
 			}
 		}
-		else if (inputFileReader_Simulation->userDefinedSimulations[0]->explicitSolverStepIndex == 1) {
+		else if (explicitSolverStepIndex == 1) {
 			for (int i = 0; i < ssvSize; i++) {
 				ssvApp[i] = ssv[i]
 					+ ((1.0 / 4.0) * kVals[0][i]);
 			}
 		}
-		else if (inputFileReader_Simulation->userDefinedSimulations[0]->explicitSolverStepIndex == 2) {
+		else if (explicitSolverStepIndex == 2) {
 			for (int i = 0; i < ssvSize; i++) {
 				ssvApp[i] = ssv[i]
 					+ ((3.0 / 32.0) * kVals[0][i])
 					+ ((9.0 / 32.0) * kVals[1][i]);
 			}
 		}
-		else if (inputFileReader_Simulation->userDefinedSimulations[0]->explicitSolverStepIndex == 3) {
+		else if (explicitSolverStepIndex == 3) {
 			for (int i = 0; i < ssvSize; i++) {
 				ssvApp[i] = ssv[i]
 					+ ((1932.0 / 2197.0) * kVals[0][i])
@@ -97,7 +103,7 @@ void ExplicitSSComponent::calc_ssvApp(InputFileReader_Simulation* inputFileReade
 					+ ((7296.0 / 2197.0) * kVals[2][i]);
 			}
 		}
-		else if (inputFileReader_Simulation->userDefinedSimulations[0]->explicitSolverStepIndex == 4) {
+		else if (explicitSolverStepIndex == 4) {
 			for (int i = 0; i < ssvSize; i++) {
 				ssvApp[i] = ssv[i]
 					+ ((439.0 / 216.0) * kVals[0][i])
@@ -106,7 +112,7 @@ void ExplicitSSComponent::calc_ssvApp(InputFileReader_Simulation* inputFileReade
 					- ((845.0 / 4104.0) * kVals[3][i]);
 			}
 		}
-		else if (inputFileReader_Simulation->userDefinedSimulations[0]->explicitSolverStepIndex == 5) {
+		else if (explicitSolverStepIndex == 5) {
 			for (int i = 0; i < ssvSize; i++) {
 				ssvApp[i] = ssv[i]
 					- ((8.0 / 27.0) * kVals[0][i])
@@ -121,6 +127,11 @@ void ExplicitSSComponent::calc_ssvApp(InputFileReader_Simulation* inputFileReade
 
 
 void ExplicitSSComponent::calc_kVals() {
+	calc_kVals(inputFileReader_Simulation->userDefinedSimulations[0]->explicitSolverStepIndex);
+}
+
+
+void ExplicitSSComponent::calc_kVals(int explicitSolverStepIndex) {
 	if (kValsBool == false) {
 		kVals = new double* [inputFileReader_Simulation->userDefinedSimulations[0]->explicitSolverNumSteps];
 		for (int i = 0; i < inputFileReader_Simulation->userDefinedSimulations[0]->explicitSolverNumSteps; i++) {
@@ -129,7 +140,7 @@ void ExplicitSSComponent::calc_kVals() {
 		kValsBool = true;
 	}
 	for (int i = 0; i < ssvSize; i++) {
-		kVals[inputFileReader_Simulation->userDefinedSimulations[0]->explicitSolverStepIndex][i] =
+		kVals[explicitSolverStepIndex][i] =
 			inputFileReader_Simulation->userDefinedSimulations[0]->explicitSolverTimeStep * ssvDot[i];
 	}
 }
@@ -180,3 +191,17 @@ double ExplicitSSComponent::calc_ee() {
 	return max_est_error;
 }
 
+
+void ExplicitSSComponent::saveState(SimulationState* simulationState) {
+	for (int i = 0; i < ssvSize; i++) {
+		simulationState->append(ssv[i], true);
+	}
+}
+
+
+void ExplicitSSComponent::loadState(SimulationState* simulationState) {
+	for (int i = 0; i < ssvSize; i++) {
+		ssv[i] = simulationState->next();
+	}
+}
+
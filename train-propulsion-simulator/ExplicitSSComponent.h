@@ -8,6 +8,7 @@
 #include "UserDefinedRRComponent.h"
 
 class InputFileReader_Simulation;
+class SimulationState;
 
 class ExplicitSSComponent : public UserDefinedRRComponent {
 
@@ -32,9 +33,17 @@ public:
 	// Calculates state-space variables which serves as input for state-space equations method
 	void calc_ssvApp(InputFileReader_Simulation* inputFileReader_Simulation);
 
+	// Calculates state-space variables which serves as input for state-space equations method
+	// explicitSolverStepIndex	-->	Explicit solver step index
+	void calc_ssvApp(int explicitSolverStepIndex);
+
 	// Calculates current step 'k' value
 	void calc_kVals();
 
+	// Calculates current step 'k' value
+	// explicitSolverStepIndex	-->	Explicit solver step index
+	void calc_kVals(int explicitSolverStepIndex);
+
 	// Calculates fourth order result
 	void calc_res4();
 
@@ -47,6 +56,14 @@ public:
 	// Updates state space variables
 	void update_ssv();
 
+	// Saves state (variables that persist from one implicit solver time step to the next)
+	// simulationState		-->	Simulation state
+	virtual void saveState(SimulationState* simulationState);
+
+	// Loads state (variables that persist from one implicit solver time step to the next)
+	// simulationState		-->	Simulation state
+	virtual void loadState(SimulationState* simulationState);
+
 protected:
 
 	// Derivative of state-space variables (NOTE: The derivative of state-space variables represents the state-space equations)
@@ -3,6 +3,9 @@
 //////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
 
 
+#include <algorithm>
+#include <cmath>
+#include <limits>
 #include "Function.h"
 #include "Car.h"
 #include "Coupler.h"
@@ -11,6 +14,7 @@
 #include "IntervalSmooth.h"
 #include "Locomotive.h"
 #include "LocomotiveOperator.h"
+#include "ResultsWriter.h"
 #include "Track.h"
 
 
@@ -20,6 +24,11 @@ const std::string Function::START_FUNCTION_STRING = "Function_";
 const std::string Function::END_FUNCTION_STRING = "_Function";
 
 
+// Segment types (defined out of class, since they are bound to references, such as by 'push_back')
+constexpr int Function::SEGMENT_TYPE_STEP;
+constexpr int Function::SEGMENT_TYPE_SMOOTH;
+
+
 Function::Function(UserDefinedRRComponent* userDefinedRRComponent, int functionIndex) {
 	this->functionIndex = functionIndex;
 	// Determine 'stepFunctionBool' value
@@ -53,6 +62,7 @@ Function::Function(UserDefinedRRComponent* userDefinedRRComponent, int functionI
 		maxNumberOfPointsPerInterval = IntervalSmooth::ABSOLUTE_MAX_NUMBER_OF_POINTS;
 	}
 	interpPointsCalcBool = false;
+	compiledBool = false;
 }
 
 
@@ -67,6 +77,7 @@ Function::Function(bool stepFunctionBool, int maxNumberOfPointsPerInterval) {
 		this->maxNumberOfPointsPerInterval = maxNumberOfPointsPerInterval;
 	}
 	interpPointsCalcBool = false;
+	compiledBool = false;
 }
 
 
@@ -100,6 +111,7 @@ void Function::add_interval() {
 		delete[] interpPoints;
 	}
 	interpPointsCalcBool = false;
+	compiledBool = false;
 }
 
 
@@ -126,24 +138,43 @@ void Function::piecewiseLinear(double* x, double* y, int xySize) {
 			intervals[i]->points[npml - 1]->y = y[i + 1];
 		}
 	}
+	compiledBool = false;
 }
 
 
 double Function::interpolate(double xpt, double miny, double maxy) {
+	size_t segmentIndex = 0;
+	return interpolate(xpt, miny, maxy, &segmentIndex);
+}
+
+
+double Function::interpolate(double xpt, double miny, double maxy, size_t* segmentIndex) {
+	if (compiledBool == false) {
+		compile();
+	}
 	double r = 0.0;
-	int nsiml = intervals.size();
-	int npml = intervals[nsiml - 1]->points.size();
-	if (xpt < intervals[0]->points[0]->x) {
-		r = intervals[0]->points[0]->y;
+	size_t ns = segmentTypes.size();
+	if (xpt < knotXs[0]) {
+		r = knotYs[0];
 	}
-	else if (xpt > intervals[nsiml - 1]->points[npml - 1]->x) {
-		r = intervals[nsiml - 1]->points[npml - 1]->y;
+	else if (xpt > knotXs[ns]) {
+		r = knotYs[ns];
 	}
 	else {
-		for (int i = 0; i < nsiml; i++) {
-			npml = intervals[i]->points.size();
-			if ((xpt >= intervals[i]->points[0]->x) && (xpt <= intervals[i]->points[npml - 1]->x)) {
-				r = intervals[i]->interpolate(xpt, miny, maxy);
+		size_t i = calc_segmentIndex(xpt, *segmentIndex);
+		*segmentIndex = i;
+		if (segmentTypes[i] == SEGMENT_TYPE_STEP) {
+			r = knotYs[i];
+		}
+		else {
+			const double* c = &segmentCoefficients[4 * i];
+			double t = xpt - knotXs[i];  // distance from first knot of segment
+			r = c[0] + (t * (c[1] + (t * (c[2] + (t * c[3])))));
+			if (r < miny) {
+				r = miny;
+			}
+			else if (r > maxy) {
+				r = maxy;
 			}
 		}
 	}
@@ -151,6 +182,215 @@ double Function::interpolate(double xpt, double miny, double maxy) {
 }
 
 
+void Function::interpolate(const double* xpts, size_t numberOfPoints, double miny, double maxy, size_t* segmentIndices, double* ypts) {
+	if (compiledBool == false) {
+		compile();
+	}
+	size_t ns = segmentTypes.size();
+	// Find segment of each point
+	// (Segment of previous point is checked before binary search, since points are often sorted, such as rail vehicle positions along train consist)
+	for (size_t k = 0; k < numberOfPoints; k++) {
+		size_t i = std::min(segmentIndices[k], ns - 1);
+		if (checkSegmentIsLastStartingAtOrBelow(xpts[k], i) == false) {
+			if ((i < (ns - 1)) && (checkSegmentIsLastStartingAtOrBelow(xpts[k], i + 1) == true)) {
+				i = i + 1;
+			}
+			else if ((k > 0) && (checkSegmentIsLastStartingAtOrBelow(xpts[k], segmentIndices[k - 1]) == true)) {
+				i = segmentIndices[k - 1];
+			}
+			else {
+				i = calc_segmentIndex(xpts[k]);
+			}
+		}
+		segmentIndices[k] = i;
+	}
+	// Evaluate segment of each point
+	if (stepFunctionBool == true) {
+		for (size_t k = 0; k < numberOfPoints; k++) {
+			ypts[k] = knotYs[segmentIndices[k]];
+		}
+	}
+	else {
+		for (size_t k = 0; k < numberOfPoints; k++) {
+			size_t i = segmentIndices[k];
+			const double* c = &segmentCoefficients[4 * i];
+			double t = xpts[k] - knotXs[i];  // distance from first knot of segment
+			double r = c[0] + (t * (c[1] + (t * (c[2] + (t * c[3])))));
+			ypts[k] = std::min(std::max(r, miny), maxy);
+		}
+	}
+	// Points outside of function take value of nearest end point of function
+	for (size_t k = 0; k < numberOfPoints; k++) {
+		if (xpts[k] < knotXs[0]) {
+			ypts[k] = knotYs[0];
+		}
+		else if (xpts[k] > knotXs[ns]) {
+			ypts[k] = knotYs[ns];
+		}
+	}
+}
+
+
+void Function::interpolateSweep(const double* xpts, size_t numberOfPoints, double miny, double maxy, size_t* segmentIndex, double* ypts) {
+	if (compiledBool == false) {
+		compile();
+	}
+	size_t ns = segmentTypes.size();
+	size_t i = std::min(*segmentIndex, ns - 1);  // segment cursor
+	for (size_t k = 0; k < numberOfPoints; k++) {
+		// Move cursor to last segment whose first knot is not greater than point
+		while ((i > 0) && (knotXs[i] > xpts[k])) {
+			i = i - 1;
+		}
+		while ((i < (ns - 1)) && (knotXs[i + 1] <= xpts[k])) {
+			i = i + 1;
+		}
+		if (k == 0) {
+			*segmentIndex = i;
+		}
+		// Points outside of function take value of nearest end point of function
+		if (xpts[k] < knotXs[0]) {
+			ypts[k] = knotYs[0];
+		}
+		else if (xpts[k] > knotXs[ns]) {
+			ypts[k] = knotYs[ns];
+		}
+		else if (segmentTypes[i] == SEGMENT_TYPE_STEP) {
+			ypts[k] = knotYs[i];
+		}
+		else {
+			const double* c = &segmentCoefficients[4 * i];
+			double t = xpts[k] - knotXs[i];  // distance from first knot of segment
+			double r = c[0] + (t * (c[1] + (t * (c[2] + (t * c[3])))));
+			ypts[k] = std::min(std::max(r, miny), maxy);
+		}
+	}
+}
+
+
+void Function::calc_constantRange(double xpt, double* rangeStart, double* rangeEnd) {
+	if (compiledBool == false) {
+		compile();
+	}
+	size_t ns = segmentTypes.size();
+	// Points outside of function take value of nearest end point of function
+	if (xpt < knotXs[0]) {
+		*rangeStart = -std::numeric_limits<double>::infinity();
+		*rangeEnd = knotXs[0];
+		return;
+	}
+	if (xpt > knotXs[ns]) {
+		*rangeStart = std::nextafter(knotXs[ns], std::numeric_limits<double>::infinity());
+		*rangeEnd = std::numeric_limits<double>::infinity();
+		return;
+	}
+	// Step segments and smooth segments with zero linear, quadratic, and cubic terms are constant from first knot of segment up to first knot of next segment
+	// (last segment also includes last knot)
+	size_t i = calc_segmentIndex(xpt);
+	const double* c = &segmentCoefficients[4 * i];
+	if ((segmentTypes[i] == SEGMENT_TYPE_STEP) || ((c[1] == 0.0) && (c[2] == 0.0) && (c[3] == 0.0))) {
+		*rangeStart = knotXs[i];
+		*rangeEnd = (i < (ns - 1)) ? knotXs[i + 1] : std::nextafter(knotXs[ns], std::numeric_limits<double>::infinity());
+	}
+	else {
+		*rangeStart = xpt;
+		*rangeEnd = xpt;
+	}
+}
+
+
+double Function::integrate(double xpt, size_t* segmentIndex) {
+	if (compiledBool == false) {
+		compile();
+	}
+	size_t ns = segmentTypes.size();
+	if (xpt < knotXs[0]) {
+		return (xpt - knotXs[0]) * knotYs[0];
+	}
+	if (xpt > knotXs[ns]) {
+		return knotIntegrals[ns] + ((xpt - knotXs[ns]) * knotYs[ns]);
+	}
+	size_t i = calc_segmentIndex(xpt, *segmentIndex);
+	*segmentIndex = i;
+	double t = xpt - knotXs[i];  // distance from first knot of segment
+	if (segmentTypes[i] == SEGMENT_TYPE_STEP) {
+		return knotIntegrals[i] + (t * knotYs[i]);
+	}
+	const double* c = &segmentCoefficients[4 * i];
+	return knotIntegrals[i] + (t * (c[0] + (t * ((c[1] / 2.0) + (t * ((c[2] / 3.0) + (t * (c[3] / 4.0))))))));
+}
+
+
+void Function::compile() {
+	// Function without intervals keeps segments defined directly by 'compileSteps'
+	if ((intervals.size() == 0) && (segmentTypes.size() > 0)) {
+		compiledBool = true;
+		return;
+	}
+	knotXs.clear();
+	knotYs.clear();
+	segmentTypes.clear();
+	segmentCoefficients.clear();
+	for (size_t i = 0; i < intervals.size(); i++) {
+		if (stepFunctionBool == false) {
+			((IntervalSmooth*)intervals[i])->compile();
+		}
+		// Last point of interval is first point of next interval, so only first point of each segment is added
+		for (size_t j = 0; j < (intervals[i]->points.size() - 1); j++) {
+			knotXs.push_back(intervals[i]->points[j]->x);
+			knotYs.push_back(intervals[i]->points[j]->y);
+			double c[4] = { 0.0, 0.0, 0.0, 0.0 };  // segment coefficients
+			if (stepFunctionBool == true) {
+				segmentTypes.push_back(SEGMENT_TYPE_STEP);
+			}
+			else {
+				segmentTypes.push_back(SEGMENT_TYPE_SMOOTH);
+				((IntervalSmooth*)intervals[i])->calc_segmentCoefficients(j, c);
+			}
+			segmentCoefficients.insert(segmentCoefficients.end(), c, c + 4);
+		}
+	}
+	int nsiml = intervals.size();
+	int npml = intervals[nsiml - 1]->points.size();
+	knotXs.push_back(intervals[nsiml - 1]->points[npml - 1]->x);
+	knotYs.push_back(intervals[nsiml - 1]->points[npml - 1]->y);
+	calc_knotIntegrals();
+	compiledBool = true;
+}
+
+
+void Function::compileSteps(const std::vector<double>& stepStarts, const std::vector<double>& stepValues, double end) {
+	zap();
+	knotXs = stepStarts;
+	knotXs.push_back(end);
+	knotYs = stepValues;
+	knotYs.push_back(stepValues[stepValues.size() - 1]);
+	segmentTypes.assign(stepStarts.size(), SEGMENT_TYPE_STEP);
+	segmentCoefficients.assign(4 * stepStarts.size(), 0.0);
+	calc_knotIntegrals();
+	compiledBool = true;
+}
+
+
+void Function::calc_knotIntegrals() {
+	// Prefix integrals (integral of each segment is its polynomial integrated over its length)
+	size_t ns = segmentTypes.size();
+	knotIntegrals.assign(ns + 1, 0.0);
+	for (size_t i = 0; i < ns; i++) {
+		double h = knotXs[i + 1] - knotXs[i];  // segment length
+		double si = 0.0;  // segment integral
+		if (segmentTypes[i] == SEGMENT_TYPE_STEP) {
+			si = h * knotYs[i];
+		}
+		else {
+			const double* c = &segmentCoefficients[4 * i];
+			si = h * (c[0] + (h * ((c[1] / 2.0) + (h * ((c[2] / 3.0) + (h * (c[3] / 4.0)))))));
+		}
+		knotIntegrals[i + 1] = knotIntegrals[i] + si;
+	}
+}
+
+
 void Function::interpolateMult(double miny, double maxy) {
 	if ((intervals.size()) >= 1 && (interpPointsCalcBool == false)) {
 		// Calculate interpolated points for each interval
@@ -181,6 +421,53 @@ void Function::interpolateMult(double miny, double maxy) {
 }
 
 
+void Function::sample(double miny, double maxy, double relativeTolerance, ResultsWriter* resultsWriter) {
+	if (intervals.size() == 0) {
+		return;
+	}
+	if (compiledBool == false) {
+		compile();
+	}
+	// Absolute tolerance
+	double tol = relativeTolerance * (*std::max_element(knotYs.begin(), knotYs.end()) - *std::min_element(knotYs.begin(), knotYs.end()));
+	size_t ns = segmentTypes.size();
+	for (size_t i = 0; i < ns; i++) {
+		double h = knotXs[i + 1] - knotXs[i];  // segment length
+		if (segmentTypes[i] == SEGMENT_TYPE_STEP) {
+			resultsWriter->writePoint(knotXs[i], knotYs[i]);
+			resultsWriter->writePoint(knotXs[i + 1], knotYs[i]);
+			continue;
+		}
+		const double* c = &segmentCoefficients[4 * i];
+		double minStep = h / MAX_NUM_SAMPLES_PER_SEGMENT;  // minimum distance between sampled points
+		double t = 0.0;  // distance from first knot of segment
+		while (true) {
+			double y = c[0] + (t * (c[1] + (t * (c[2] + (t * c[3])))));
+			resultsWriter->writePoint(knotXs[i] + t, std::min(std::max(y, miny), maxy));
+			if (t >= h) {
+				break;
+			}
+			// Chord over step of length 'd' deviates from segment polynomial by at most d * d * |y''| / 8, and second derivative is linear in distance,
+			// so largest second derivative over step is at one of its ends
+			double d = h - t;  // step length
+			double a0 = std::abs((2.0 * c[2]) + (6.0 * c[3] * t));  // magnitude of second derivative at start of step
+			if ((a0 * d * d) > (8.0 * tol)) {
+				d = std::sqrt(8.0 * tol / a0);
+			}
+			double a1 = std::abs((2.0 * c[2]) + (6.0 * c[3] * (t + d)));  // magnitude of second derivative at end of step
+			if ((a1 * d * d) > (8.0 * tol)) {
+				d = std::sqrt(8.0 * tol / a1);
+			}
+			t = std::min(t + std::max(d, minStep), h);
+			// Last point of segment is first point of next segment, so it is only written here for last segment or segment followed by step segment
+			if ((t >= h) && (i < (ns - 1)) && (segmentTypes[i + 1] != SEGMENT_TYPE_STEP)) {
+				break;
+			}
+		}
+	}
+}
+
+
 void Function::copy(Function* function) {
 	zap();
 	stepFunctionBool = function->stepFunctionBool;
@@ -213,6 +500,13 @@ void Function::zap() {
 	}
 	// Reset 'interPointsCalcBool' variable to false
 	interpPointsCalcBool = false;
+	// Clear compiled segments
+	knotXs.clear();
+	knotYs.clear();
+	segmentTypes.clear();
+	segmentCoefficients.clear();
+	knotIntegrals.clear();
+	compiledBool = false;
 }
 
 
@@ -352,3 +646,36 @@ void Function::console() {
 	}
 }
 
+
+bool Function::checkSegmentIsLastStartingAtOrBelow(double xpt, size_t segmentIndex) {
+	if (knotXs[segmentIndex] > xpt) {
+		return false;
+	}
+	if ((segmentIndex < (segmentTypes.size() - 1)) && (knotXs[segmentIndex + 1] <= xpt)) {
+		return false;
+	}
+	return true;
+}
+
+
+size_t Function::calc_segmentIndex(double xpt) {
+	// First knot (excluding last knot) whose independent variable value is greater than 'xpt'
+	size_t k = std::upper_bound(knotXs.begin(), knotXs.end() - 1, xpt) - knotXs.begin();
+	return (k > 0) ? (k - 1) : 0;
+}
+
+
+size_t Function::calc_segmentIndex(double xpt, size_t segmentIndex) {
+	// Segments are contiguous and ordered, so last segment containing 'xpt' is last segment whose first knot is not greater than 'xpt'
+	// (Previous segment and next segment are checked before binary search, since independent variable usually changes little between calls)
+	size_t ns = segmentTypes.size();
+	size_t i = std::min(segmentIndex, ns - 1);
+	if (checkSegmentIsLastStartingAtOrBelow(xpt, i) == true) {
+		return i;
+	}
+	if ((i < (ns - 1)) && (checkSegmentIsLastStartingAtOrBelow(xpt, i + 1) == true)) {
+		return i + 1;
+	}
+	return calc_segmentIndex(xpt);
+}
+
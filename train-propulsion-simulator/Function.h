@@ -10,6 +10,7 @@
 
 class InputFileReader;
 class Interval;
+class ResultsWriter;
 class UserDefinedRRComponent;
 
 class Function {
@@ -35,6 +36,9 @@ public:
 	// Maximum number of intervals per function
 	static constexpr int MAX_NUM_INTERVALS = 2000;
 
+	// Maximum number of sampled points per segment (excluding last point of segment)
+	static constexpr int MAX_NUM_SAMPLES_PER_SEGMENT = 100;
+
 	// Step function boolean ('true' for step function)
 	bool stepFunctionBool;
 
@@ -65,11 +69,73 @@ public:
 	// maxy		-->	Maximum threshold for dependent variable
 	double interpolate(double xpt, double miny, double maxy);
 
+	// Calculates single spline-interpolated value of a data point from compiled function, starting search for segment from segment of previous call
+	// (for callers whose independent variable changes little from one call to the next, such as rail vehicle position or time)
+	// xpt				-->	Independent variable value for which the spline-interpolated value is desired
+	// miny				-->	Minimum threshold for dependent variable
+	// maxy				-->	Maximum threshold for dependent variable
+	// segmentIndex		-->	Index of segment found by previous call (updated to index of segment found by this call)
+	double interpolate(double xpt, double miny, double maxy, size_t* segmentIndex);
+
+	// Calculates multiple spline-interpolated values of data points from compiled function (independent variable values may be sorted or unsorted)
+	// (Segments of all points are found first, and then segment polynomials of all points are evaluated in a single loop)
+	// xpts				-->	Independent variable values for which the spline-interpolated values are desired
+	// numberOfPoints	-->	Number of independent variable values
+	// miny				-->	Minimum threshold for dependent variable
+	// maxy				-->	Maximum threshold for dependent variable
+	// segmentIndices	-->	Index of segment found by previous call for each point (updated to index of segment found by this call)
+	// ypts				-->	Spline-interpolated values
+	void interpolate(const double* xpts, size_t numberOfPoints, double miny, double maxy, size_t* segmentIndices, double* ypts);
+
+	// Calculates multiple spline-interpolated values of data points from compiled function in single sweep over segments
+	// (Segment cursor moves from segment of one point to segment of next point, so for points ordered along independent variable, such as rail vehicle
+	// positions along train consist, all points are found in time proportional to number of points plus number of segments passed)
+	// xpts				-->	Independent variable values for which the spline-interpolated values are desired
+	// numberOfPoints	-->	Number of independent variable values
+	// miny				-->	Minimum threshold for dependent variable
+	// maxy				-->	Maximum threshold for dependent variable
+	// segmentIndex		-->	Index of segment found by previous call for first point (starting cursor, updated to index of segment found by this call for first point)
+	// ypts				-->	Spline-interpolated values
+	void interpolateSweep(const double* xpts, size_t numberOfPoints, double miny, double maxy, size_t* segmentIndex, double* ypts);
+
+	// Calculates range of independent variable containing independent variable value over which compiled function is constant, so that value of function
+	// need not be calculated again until independent variable leaves range (range is empty if function is not constant around independent variable value)
+	// xpt				-->	Independent variable value
+	// rangeStart		-->	First independent variable value of range
+	// rangeEnd			-->	Independent variable value at which range ends (not included in range)
+	void calc_constantRange(double xpt, double* rangeStart, double* rangeEnd);
+
+	// Calculates integral of compiled function from first knot to independent variable value, starting search for segment from segment of previous call
+	// (Function takes value of nearest end point beyond first and last knots, and thresholds are not applied)
+	// xpt				-->	Independent variable value at which integral ends
+	// segmentIndex		-->	Index of segment found by previous call (updated to index of segment found by this call)
+	double integrate(double xpt, size_t* segmentIndex);
+
+	// Compiles intervals into contiguous knot and segment coefficient arrays used by 'interpolate'
+	// (Note: Should be called whenever points are final, such as after conversion to SI, so that 'interpolate' does not compile function on first call)
+	void compile();
+
+	// Defines compiled function directly as step function, without intervals (for long schedules, such as recorded locomotive operator settings, that would
+	// exceed maximum number of intervals per function; function is constant at last step value from end of last step onward)
+	// stepStarts		-->	Independent variable values at which steps start (increasing)
+	// stepValues		-->	Dependent variable values of steps
+	// end				-->	Independent variable value at which last step ends
+	void compileSteps(const std::vector<double>& stepStarts, const std::vector<double>& stepValues, double end);
+
 	// Calculates multiple interpolated values for independent variable 'x' and dependent variable 'y'
 	// miny		-->	Minimum threshold for dependent variable
 	// maxy		-->	Maximum threshold for dependent variable
 	void interpolateMult(double miny, double maxy);
 
+	// Writes sampled points of compiled function directly to results file (one point per line), placing points densely where the second derivative of
+	// the function is large and sparsely where the function is linear, such that the polyline through the points deviates from the function by no more
+	// than the tolerance (both end points of each step segment are written, so that jumps between steps are drawn as vertical lines)
+	// miny					-->	Minimum threshold for dependent variable
+	// maxy					-->	Maximum threshold for dependent variable
+	// relativeTolerance	-->	Maximum deviation of polyline from function, relative to range of dependent variable values of points
+	// resultsWriter		-->	Results writer
+	void sample(double miny, double maxy, double relativeTolerance, ResultsWriter* resultsWriter);
+
 	// Copies function
 	// function		-->	Function to be copied
 	void copy(Function* function);
@@ -91,6 +157,48 @@ private:
 	// Interpolated points calculated boolean
 	bool interpPointsCalcBool;
 
+	// Step segment type
+	static constexpr int SEGMENT_TYPE_STEP = 0;
+
+	// Smooth (cubic spline) segment type
+	static constexpr int SEGMENT_TYPE_SMOOTH = 1;
+
+	// Compiled boolean ('true' if knot and segment arrays are up to date with intervals)
+	bool compiledBool;
+
+	// Independent variable values of knots (first point of each segment, followed by last point of last segment)
+	std::vector<double> knotXs;
+
+	// Dependent variable values of knots (first point of each segment, followed by last point of last segment)
+	std::vector<double> knotYs;
+
+	// Segment types
+	std::vector<int> segmentTypes;
+
+	// Segment polynomial coefficients (constant, linear, quadratic, and cubic terms in distance from first knot of segment, only used for smooth segments)
+	std::vector<double> segmentCoefficients;
+
+	// Integrals of function from first knot to each knot (prefix integrals, so integral over any range is difference of two prefix integrals)
+	std::vector<double> knotIntegrals;
+
+	// Calculates integrals of function from first knot to each knot from compiled segments
+	void calc_knotIntegrals();
+
+	// Checks if segment is last segment whose first knot is not greater than independent variable value
+	// xpt				-->	Independent variable value
+	// segmentIndex		-->	Segment index
+	bool checkSegmentIsLastStartingAtOrBelow(double xpt, size_t segmentIndex);
+
+	// Calculates index of last segment whose first knot is not greater than independent variable value (binary search over knots)
+	// xpt				-->	Independent variable value
+	size_t calc_segmentIndex(double xpt);
+
+	// Calculates index of last segment whose first knot is not greater than independent variable value, checking segment of previous call and next segment
+	// before binary search
+	// xpt				-->	Independent variable value
+	// segmentIndex		-->	Index of segment found by previous call
+	size_t calc_segmentIndex(double xpt, size_t segmentIndex);
+
 };
 
 #endif
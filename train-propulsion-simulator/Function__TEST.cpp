@@ -3,7 +3,10 @@
 //////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
 
 
+#include <algorithm>
+#include <cmath>
 #include <iostream>
+#include <vector>
 #include "Function.h"
 #include "IntervalSmooth.h"
 #include "Point.h"
@@ -13,8 +16,11 @@
 void console__TEST(Function* function1);
 void interpolate__TEST(Function* function1);
 void interpolateMult__TEST(Function* function1);
+void sample__TEST(Function* function1);
 void add_interval__TEST(Function* function1);
 void copy__TEST(Function* function1);
+void interpolateBatch__TEST(Function* function1, double miny, double maxy);
+void hornerCoefficients__TEST(Function* function1);
 
 
 int main() {
@@ -29,8 +35,17 @@ int main() {
 	console__TEST(functionSmooth);
 	interpolate__TEST(functionSmooth);
 	interpolateMult__TEST(functionSmooth);
+	sample__TEST(functionSmooth);
 	add_interval__TEST(functionSmooth);
+	interpolateBatch__TEST(functionSmooth, 0.0, 40.0);
+	hornerCoefficients__TEST(functionSmooth);
 	copy__TEST(functionSmooth);
+	// Step function
+	double xStep[4] = { 1.0, 2.0, 4.0, 7.0 };
+	double yStep[4] = { 3.0, -1.0, 5.0, 5.0 };
+	Function* functionStep = new Function(true, 0);
+	functionStep->piecewiseLinear(xStep, yStep, 4);
+	interpolateBatch__TEST(functionStep, -10.0, 10.0);
 
 }
 
@@ -79,6 +94,18 @@ void interpolateMult__TEST(Function* function1) {
 }
 
 
+// Tests adaptive sampling of function
+void sample__TEST(Function* function1) {
+	std::cout << "sample__TEST" << std::endl;
+	std::string fp = "C:/Users/Leith/Desktop/sample__TEST.csv";
+	ResultsWriter resultsWriter(fp, false);
+	function1->sample(0.0, 40.0, 0.001, &resultsWriter);
+	resultsWriter.ofs->flush();
+	resultsWriter.ofs->close();
+	std::cout << std::endl << std::endl << std::endl;
+}
+
+
 // Tests adding interval to function
 void add_interval__TEST(Function* function1) {
 	// Add interval
@@ -129,3 +156,83 @@ void copy__TEST(Function* function1) {
 	std::cout << std::endl << std::endl << std::endl;
 }
 
+
+// Tests batch interpolation of function against single point interpolation (sorted points, unsorted points, and points outside of function)
+void interpolateBatch__TEST(Function* function1, double miny, double maxy) {
+	std::cout << "interpolateBatch__TEST" << std::endl;
+	// Sorted points (from before first knot to after last knot) followed by same points in reverse order
+	std::vector<double> xpts;
+	for (double x = 0.0; x <= 13.0; x = x + 0.05) {
+		xpts.push_back(x);
+	}
+	size_t numberOfSortedPoints = xpts.size();
+	for (size_t k = 0; k < numberOfSortedPoints; k++) {
+		xpts.push_back(xpts[numberOfSortedPoints - 1 - k]);
+	}
+	std::vector<double> yptsScalar(xpts.size());
+	std::vector<double> yptsBatch(xpts.size());
+	std::vector<double> yptsSweep(xpts.size());
+	std::vector<size_t> segmentIndices(xpts.size(), 0);
+	size_t segmentIndexScalar = 0;
+	size_t segmentIndexSweep = 0;
+	for (size_t k = 0; k < xpts.size(); k++) {
+		yptsScalar[k] = function1->interpolate(xpts[k], miny, maxy, &segmentIndexScalar);
+	}
+	function1->interpolate(xpts.data(), xpts.size(), miny, maxy, segmentIndices.data(), yptsBatch.data());
+	function1->interpolateSweep(xpts.data(), xpts.size(), miny, maxy, &segmentIndexSweep, yptsSweep.data());
+	double maxDifferenceBatch = 0.0;
+	double maxDifferenceSweep = 0.0;
+	for (size_t k = 0; k < xpts.size(); k++) {
+		maxDifferenceBatch = std::max(maxDifferenceBatch, std::abs(yptsBatch[k] - yptsScalar[k]));
+		maxDifferenceSweep = std::max(maxDifferenceSweep, std::abs(yptsSweep[k] - yptsScalar[k]));
+	}
+	std::cout << "Number of points: " << xpts.size() << std::endl;
+	std::cout << "maxDifferenceBatch: " << maxDifferenceBatch << std::endl;
+	std::cout << "maxDifferenceSweep: " << maxDifferenceSweep << std::endl;
+	std::cout << std::endl << std::endl << std::endl;
+}
+
+
+// Tests polynomial coefficients of spline segments (spline passes through points, has continuous slope and second derivative at interior points, and
+// has slope of end chords at end points, which defines spline uniquely)
+void hornerCoefficients__TEST(Function* function1) {
+	std::cout << "hornerCoefficients__TEST" << std::endl;
+	double maxValueError = 0.0;
+	double maxSlopeError = 0.0;
+	double maxSecondDerivativeError = 0.0;
+	for (size_t j = 0; j < function1->intervals.size(); j++) {
+		IntervalSmooth* interval = (IntervalSmooth*)function1->intervals[j];
+		size_t np = interval->points.size();  // number of points
+		double c[4];  // coefficients of current segment
+		double cp[4];  // coefficients of previous segment
+		for (size_t i = 0; i < (np - 1); i++) {
+			interval->calc_segmentCoefficients(i, c);
+			double h = interval->points[i + 1]->x - interval->points[i]->x;
+			double chordSlope = (interval->points[i + 1]->y - interval->points[i]->y) / h;
+			// Value at both ends of segment
+			maxValueError = std::max(maxValueError, std::abs(c[0] - interval->points[i]->y));
+			maxValueError = std::max(maxValueError, std::abs(c[0] + (h * (c[1] + (h * (c[2] + (h * c[3]))))) - interval->points[i + 1]->y));
+			// Slope at first point and last point
+			if (i == 0) {
+				maxSlopeError = std::max(maxSlopeError, std::abs(c[1] - chordSlope));
+			}
+			if (i == (np - 2)) {
+				maxSlopeError = std::max(maxSlopeError, std::abs(c[1] + (h * ((2.0 * c[2]) + (3.0 * h * c[3]))) - chordSlope));
+			}
+			// Slope and second derivative at interior point (end of previous segment versus start of current segment)
+			if (i > 0) {
+				double hp = interval->points[i]->x - interval->points[i - 1]->x;
+				maxSlopeError = std::max(maxSlopeError, std::abs(cp[1] + (hp * ((2.0 * cp[2]) + (3.0 * hp * cp[3]))) - c[1]));
+				maxSecondDerivativeError = std::max(maxSecondDerivativeError, std::abs((2.0 * cp[2]) + (6.0 * hp * cp[3]) - (2.0 * c[2])));
+			}
+			for (int k = 0; k < 4; k++) {
+				cp[k] = c[k];
+			}
+		}
+	}
+	std::cout << "maxValueError: " << maxValueError << std::endl;
+	std::cout << "maxSlopeError: " << maxSlopeError << std::endl;
+	std::cout << "maxSecondDerivativeError: " << maxSecondDerivativeError << std::endl;
+	std::cout << std::endl << std::endl << std::endl;
+}
+
@@ -0,0 +1,94 @@
+//////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+// This file is part of the TRAIN PROPULSION SIMULATOR repository available at github.com/lnaz01/train-propulsion-simulator //
+//////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+
+#include <algorithm>
+#include <string>
+#include <vector>
+#include "InputFileReader_Route.h"
+#include "InputFileReader_Simulation.h"
+#include "UnitConverter.h"
+
+
+InputFileReader_Route::InputFileReader_Route(InputFileReader_Simulation* inputFileReader_Simulation) : InputFileReader() {
+	inputFileAbsolutePath = inputFileReader_Simulation->inputFileAbsolutePath;
+	calc_inputFileDirectoryPath();
+	calc_inputFileName();
+	inputFileAbsolutePath = inputFileDirectoryPath + "/" + "route" + "." + FE_TRF;
+	// Check if file exists
+	inputFileExistsBool = false;
+	FILE* file;
+	if (file = fopen(inputFileAbsolutePath.c_str(), "r")) {
+		inputFileExistsBool = true;
+		fclose(file);
+	}
+	// If file exists, calculate number of lines, file directory path, and file name
+	if (inputFileExistsBool == true) {
+		calc_totalNumberOfLines();
+		calc_inputFileDirectoryPath();
+		calc_inputFileName();
+		inputFileStream = new std::ifstream(inputFileAbsolutePath);
+		inputFileStream->open(inputFileAbsolutePath);
+	}
+	// Reinitialize
+	reinitialize();
+}
+
+
+InputFileReader_Route::~InputFileReader_Route() {}
+
+
+std::string InputFileReader_Route::load() {
+	// First non-empty line has path of track segment library file, and each following non-empty line has segment identifier and offset separated by a comma
+	reinitialize();
+	currentLineNumber = 0;
+	segmentIds.clear();
+	segmentOffsets.clear();
+	trackSegmentLibraryAbsolutePath.clear();
+	for (int i = 0; i < totalNumberOfLines; i++) {
+		nextLine();
+		if (currentLine.length() == 0) {
+			continue;
+		}
+		if (trackSegmentLibraryAbsolutePath.length() == 0) {
+			// Relative paths are relative to directory of route file
+			if ((currentLine[0] == '/') || (currentLine[0] == '\\') || (currentLine.find(':') != std::string::npos)) {
+				trackSegmentLibraryAbsolutePath = currentLine;
+			}
+			else {
+				trackSegmentLibraryAbsolutePath = inputFileDirectoryPath + "/" + currentLine;
+			}
+			continue;
+		}
+		size_t numcommas = std::count(currentLine.begin(), currentLine.end(), ',');
+		std::vector<std::string> strvec = InputFileReader::split_string(currentLine, ',');
+		if ((numcommas != 1) || (strvec.size() != 2)) {
+			return std::string("Each line in route file (except for first line) must have a segment identifier and an offset separated by a comma.");
+		}
+		double d;
+		try {
+			d = std::stod(strvec[1]);
+		}
+		catch (const std::invalid_argument& ia) {
+			return std::string("Error reading offset of segment '") + strvec[0] + std::string("' in route file.");
+		}
+		if ((segmentOffsets.size() > 0) && (d <= segmentOffsets[segmentOffsets.size() - 1])) {
+			return std::string("Offsets of segments in route file must be increasing.");
+		}
+		segmentIds.push_back(strvec[0]);
+		segmentOffsets.push_back(d);
+	}
+	if (segmentIds.size() == 0) {
+		return std::string("Route file must have path of track segment library file on first line followed by at least one segment.");
+	}
+	return InputFileReader::VALID_INPUT_STRING;
+}
+
+
+void InputFileReader_Route::convertToSI() {
+	for (size_t i = 0; i < segmentOffsets.size(); i++) {
+		segmentOffsets[i] = UnitConverter::ft_To_M(segmentOffsets[i]);
+	}
+}
+
@@ -0,0 +1,44 @@
+//////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+// This file is part of the TRAIN PROPULSION SIMULATOR repository available at github.com/lnaz01/train-propulsion-simulator //
+//////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+#ifndef INPUT_FILE_READER_ROUTE_DEF
+#define INPUT_FILE_READER_ROUTE_DEF
+
+#include <string>
+#include <vector>
+#include "InputFileReader.h"
+
+class InputFileReader_Simulation;
+
+class InputFileReader_Route : public InputFileReader {
+
+public:
+
+	InputFileReader_Route(InputFileReader_Simulation* ifrsim);
+
+	virtual ~InputFileReader_Route();
+
+	// Absolute path of track segment library file
+	std::string trackSegmentLibraryAbsolutePath;
+
+	// Identifiers of route segments (in order along route)
+	std::vector<std::string> segmentIds;
+
+	// Longitudinal positions of starts of route segments (feet, or meters after conversion to SI units)
+	std::vector<double> segmentOffsets;
+
+	// Loads route file
+	std::string load() override;
+
+	// Converts longitudinal positions to SI units
+	void convertToSI();
+
+private:
+
+	// File extension for route files
+	const std::string FE_TRF = "trf";
+
+};
+
+#endif
@@ -0,0 +1,42 @@
+//////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+// This file is part of the TRAIN PROPULSION SIMULATOR repository available at github.com/lnaz01/train-propulsion-simulator //
+//////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+
+#include <iostream>
+#include "InputFileReader_Route.h"
+#include "InputFileReader_Simulation.h"
+#include "TrackRoute.h"
+#include "TrackSegmentLibrary.h"
+
+
+int main() {
+
+	std::string idfp = "C:/Users/Leith/Desktop/Simulation_TEST.txt";
+	InputFileReader_Simulation* ifrsim = new InputFileReader_Simulation(idfp);
+	InputFileReader_Route* ifrr = new InputFileReader_Route(ifrsim);
+	if (ifrr->inputFileExistsBool == true) {
+		std::string errstr = ifrr->load();
+		std::cout << "Returned String: " << errstr << std::endl;
+		std::cout << "Track segment library file: " << ifrr->trackSegmentLibraryAbsolutePath << std::endl;
+		for (size_t i = 0; i < ifrr->segmentIds.size(); i++) {
+			std::cout << "Segment: " << ifrr->segmentIds[i] << ", offset: " << ifrr->segmentOffsets[i] << std::endl;
+		}
+		ifrr->convertToSI();
+		TrackRoute* tr = new TrackRoute();
+		errstr = tr->load(ifrr);
+		std::cout << "Returned String: " << errstr << std::endl;
+		if (errstr.compare(InputFileReader::VALID_INPUT_STRING) == 0) {
+			std::cout << "Route start (m): " << tr->start() << ", route end (m): " << tr->end() << std::endl;
+			for (double x = tr->start(); x <= tr->end(); x = x + 100.0) {
+				std::cout << x << ", " << tr->interpolate(0, x) << ", " << tr->interpolate(1, x) << ", " << tr->interpolate(2, x) << ", " <<
+					tr->interpolate(3, x) << std::endl;
+			}
+		}
+	}
+	else {
+		std::cout << "Route file (route.trf) does not exist in directory." << std::endl;
+	}
+
+}
+
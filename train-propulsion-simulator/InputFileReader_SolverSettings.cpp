@@ -0,0 +1,278 @@
+//////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+// This file is part of the TRAIN PROPULSION SIMULATOR repository available at github.com/lnaz01/train-propulsion-simulator //
+//////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+
+#include <algorithm>
+#include <string>
+#include <vector>
+#include "InputFileReader_SolverSettings.h"
+#include "InputFileReader_Simulation.h"
+#include "Simulation.h"
+
+
+InputFileReader_SolverSettings::InputFileReader_SolverSettings(InputFileReader_Simulation* inputFileReader_Simulation) : InputFileReader() {
+	this->inputFileReader_Simulation = inputFileReader_Simulation;
+	inputFileAbsolutePath = inputFileReader_Simulation->inputFileAbsolutePath;
+	calc_inputFileDirectoryPath();
+	calc_inputFileName();
+	inputFileAbsolutePath = inputFileDirectoryPath + "/" + "solver_settings" + "." + FE_SSF;
+	// Default solver settings
+	pararealNumberOfWindows = 0;
+	pararealWindowDuration = 60.0;
+	pararealMaximumIterations = 5;
+	pararealTolerance = 1.0 * pow(10.0, -6.0);
+	pararealCoarseTimeStep = 0.02;
+	domainDecompositionNumberOfBlocks = 0;
+	domainDecompositionInterfaceTolerance = 0.0;
+	domainDecompositionInterfaceIterations = 10;
+	quasiStaticSteppingBool = false;
+	quasiStaticVelocityTolerance = 0.01;
+	quasiStaticAccelerationTolerance = 0.01;
+	quasiStaticSettlingTime = 5.0;
+	stoppedTrainFastForwardBool = false;
+	calibrationBool = false;
+	calibrationDuration = 30.0;
+	calibrationCouplerForceTolerance = 1000.0;
+	calibrationBrakeCylinderPressureTolerance = 1.0;
+	checkpointInterval = 0.0;
+	checkpointMaximumRetries = 3;
+	rainflowNumberOfBins = 0;
+	rainflowBinWidth = 5000.0;
+	rainflowDamageExponent = 0.0;
+	rainflowDamageCoefficient = 1.0;
+	trackTableResolution = 0.0;
+	trackTableMaxMemory = 256.0;
+	trackDatabaseBool = false;
+	trackDatabaseResolution = 1.0;
+	trackAveragingBool = false;
+	// Check if file exists
+	inputFileExistsBool = false;
+	FILE* file;
+	if (file = fopen(inputFileAbsolutePath.c_str(), "r")) {
+		inputFileExistsBool = true;
+		fclose(file);
+	}
+	// If file exists, calculate number of lines, file directory path, and file name
+	if (inputFileExistsBool == true) {
+		calc_totalNumberOfLines();
+		calc_inputFileDirectoryPath();
+		calc_inputFileName();
+		inputFileStream = new std::ifstream(inputFileAbsolutePath);
+		inputFileStream->open(inputFileAbsolutePath);
+	}
+	// Reinitialize
+	reinitialize();
+}
+
+
+InputFileReader_SolverSettings::~InputFileReader_SolverSettings() {}
+
+
+std::string InputFileReader_SolverSettings::load() {
+	// Each non-empty line has exactly one keyword and one value separated by a comma
+	reinitialize();
+	currentLineNumber = 0;
+	for (int i = 0; i < totalNumberOfLines; i++) {
+		nextLine();
+		if (currentLine.length() == 0) {
+			continue;
+		}
+		size_t numcommas = std::count(currentLine.begin(), currentLine.end(), ',');
+		std::vector<std::string> strvec = InputFileReader::split_string(currentLine, ',');
+		if ((numcommas != 1) || (strvec.size() != 2)) {
+			return std::string("Each line in solver settings file must have a keyword and a value separated by a comma.");
+		}
+		std::string sval = loadSetting(strvec[0], strvec[1]);
+		if (sval.compare(InputFileReader::VALID_INPUT_STRING) != 0) {
+			return sval;
+		}
+	}
+	return InputFileReader::VALID_INPUT_STRING;
+}
+
+
+std::string InputFileReader_SolverSettings::loadSetting(std::string keyword, std::string value) {
+	double d;
+	try {
+		d = std::stod(value);
+	}
+	catch (const std::invalid_argument& ia) {
+		return std::string("Error reading number for solver setting '") + keyword + std::string("'.");
+	}
+	if (keyword.compare("parareal_windows") == 0) {
+		if ((d != (int)d) || (d < 0) || (d > MAX_PARAREAL_NUMBER_OF_WINDOWS)) {
+			return std::string("Number of parareal windows must be an integer between 0 and ") + std::to_string(MAX_PARAREAL_NUMBER_OF_WINDOWS) + std::string(".");
+		}
+		pararealNumberOfWindows = (int)d;
+	}
+	else if (keyword.compare("parareal_window_duration") == 0) {
+		if ((d < MIN_PARAREAL_WINDOW_DURATION) || (d > Simulation::MAX_NUMBER_OF_SIMULATED_SECONDS)) {
+			return std::string("Parareal window duration must be between ") + std::to_string(MIN_PARAREAL_WINDOW_DURATION) + std::string(" and ") +
+				std::to_string(Simulation::MAX_NUMBER_OF_SIMULATED_SECONDS) + std::string(" seconds.");
+		}
+		pararealWindowDuration = d;
+	}
+	else if (keyword.compare("parareal_max_iterations") == 0) {
+		if ((d != (int)d) || (d < 1)) {
+			return std::string("Maximum number of parareal iterations must be a positive integer.");
+		}
+		pararealMaximumIterations = (int)d;
+	}
+	else if (keyword.compare("parareal_tolerance") == 0) {
+		if (d <= 0.0) {
+			return std::string("Parareal tolerance must be positive.");
+		}
+		pararealTolerance = d;
+	}
+	else if (keyword.compare("parareal_coarse_time_step") == 0) {
+		if ((d <= 0.0) || (d > MAX_PARAREAL_COARSE_TIME_STEP)) {
+			return std::string("Parareal coarse time step must be positive and less than or equal to ") + std::to_string(MAX_PARAREAL_COARSE_TIME_STEP) + std::string(" seconds.");
+		}
+		pararealCoarseTimeStep = d;
+	}
+	else if (keyword.compare("domain_decomposition_blocks") == 0) {
+		if ((d != (int)d) || (d < 0) || (d > MAX_DOMAIN_DECOMPOSITION_NUMBER_OF_BLOCKS)) {
+			return std::string("Number of domain decomposition blocks must be an integer between 0 and ") + std::to_string(MAX_DOMAIN_DECOMPOSITION_NUMBER_OF_BLOCKS) + std::string(".");
+		}
+		domainDecompositionNumberOfBlocks = (int)d;
+	}
+	else if (keyword.compare("domain_decomposition_interface_tolerance") == 0) {
+		if (d < 0.0) {
+			return std::string("Domain decomposition interface tolerance must be non-negative.");
+		}
+		domainDecompositionInterfaceTolerance = d;
+	}
+	else if (keyword.compare("domain_decomposition_interface_iterations") == 0) {
+		if ((d != (int)d) || (d < 1)) {
+			return std::string("Maximum number of domain decomposition interface iterations must be a positive integer.");
+		}
+		domainDecompositionInterfaceIterations = (int)d;
+	}
+	else if (keyword.compare("quasi_static_stepping") == 0) {
+		if ((d != 0.0) && (d != 1.0)) {
+			return std::string("Quasi-static stepping must be 0 or 1.");
+		}
+		quasiStaticSteppingBool = (d == 1.0);
+	}
+	else if (keyword.compare("quasi_static_velocity_tolerance") == 0) {
+		if (d <= 0.0) {
+			return std::string("Quasi-static velocity tolerance must be positive.");
+		}
+		quasiStaticVelocityTolerance = d;
+	}
+	else if (keyword.compare("quasi_static_acceleration_tolerance") == 0) {
+		if (d <= 0.0) {
+			return std::string("Quasi-static acceleration tolerance must be positive.");
+		}
+		quasiStaticAccelerationTolerance = d;
+	}
+	else if (keyword.compare("quasi_static_settling_time") == 0) {
+		if ((d < 0.0) || (d > Simulation::MAX_NUMBER_OF_SIMULATED_SECONDS)) {
+			return std::string("Quasi-static settling time must be between 0 and ") + std::to_string(Simulation::MAX_NUMBER_OF_SIMULATED_SECONDS) + std::string(" seconds.");
+		}
+		quasiStaticSettlingTime = d;
+	}
+	else if (keyword.compare("stopped_train_fast_forward") == 0) {
+		if ((d != 0.0) && (d != 1.0)) {
+			return std::string("Stopped train fast-forward must be 0 or 1.");
+		}
+		stoppedTrainFastForwardBool = (d == 1.0);
+	}
+	else if (keyword.compare("calibration") == 0) {
+		if ((d != 0.0) && (d != 1.0)) {
+			return std::string("Calibration must be 0 or 1.");
+		}
+		calibrationBool = (d == 1.0);
+	}
+	else if (keyword.compare("calibration_duration") == 0) {
+		if ((d < MIN_CALIBRATION_DURATION) || (d > Simulation::MAX_NUMBER_OF_SIMULATED_SECONDS)) {
+			return std::string("Calibration duration must be between ") + std::to_string(MIN_CALIBRATION_DURATION) + std::string(" and ") +
+				std::to_string(Simulation::MAX_NUMBER_OF_SIMULATED_SECONDS) + std::string(" seconds.");
+		}
+		calibrationDuration = d;
+	}
+	else if (keyword.compare("calibration_coupler_force_tolerance") == 0) {
+		if (d <= 0.0) {
+			return std::string("Calibration coupler force tolerance must be positive.");
+		}
+		calibrationCouplerForceTolerance = d;
+	}
+	else if (keyword.compare("calibration_brake_cylinder_pressure_tolerance") == 0) {
+		if (d <= 0.0) {
+			return std::string("Calibration brake cylinder pressure tolerance must be positive.");
+		}
+		calibrationBrakeCylinderPressureTolerance = d;
+	}
+	else if (keyword.compare("checkpoint_interval") == 0) {
+		if ((d < 0.0) || (d > Simulation::MAX_NUMBER_OF_SIMULATED_SECONDS)) {
+			return std::string("Checkpoint interval must be between 0 and ") + std::to_string(Simulation::MAX_NUMBER_OF_SIMULATED_SECONDS) + std::string(" seconds.");
+		}
+		checkpointInterval = d;
+	}
+	else if (keyword.compare("checkpoint_max_retries") == 0) {
+		if ((d != (int)d) || (d < 0)) {
+			return std::string("Maximum number of checkpoint retries must be a non-negative integer.");
+		}
+		checkpointMaximumRetries = (int)d;
+	}
+	else if (keyword.compare("rainflow_bins") == 0) {
+		if ((d != (int)d) || (d < 0) || (d > MAX_RAINFLOW_NUMBER_OF_BINS)) {
+			return std::string("Number of rainflow bins must be an integer between 0 and ") + std::to_string(MAX_RAINFLOW_NUMBER_OF_BINS) + std::string(".");
+		}
+		rainflowNumberOfBins = (int)d;
+	}
+	else if (keyword.compare("rainflow_bin_width") == 0) {
+		if (d <= 0.0) {
+			return std::string("Rainflow bin width must be positive.");
+		}
+		rainflowBinWidth = d;
+	}
+	else if (keyword.compare("rainflow_damage_exponent") == 0) {
+		if (d < 0.0) {
+			return std::string("Rainflow damage exponent must be non-negative.");
+		}
+		rainflowDamageExponent = d;
+	}
+	else if (keyword.compare("rainflow_damage_coefficient") == 0) {
+		if (d <= 0.0) {
+			return std::string("Rainflow damage coefficient must be positive.");
+		}
+		rainflowDamageCoefficient = d;
+	}
+	else if (keyword.compare("track_table_resolution") == 0) {
+		if (d < 0.0) {
+			return std::string("Track table resolution must be non-negative.");
+		}
+		trackTableResolution = d;
+	}
+	else if (keyword.compare("track_table_max_memory") == 0) {
+		if (d < MIN_TRACK_TABLE_MAX_MEMORY) {
+			return std::string("Maximum track table memory must be at least ") + std::to_string(MIN_TRACK_TABLE_MAX_MEMORY) + std::string(" megabytes.");
+		}
+		trackTableMaxMemory = d;
+	}
+	else if (keyword.compare("track_database") == 0) {
+		if ((d != 0.0) && (d != 1.0)) {
+			return std::string("Track database must be 0 or 1.");
+		}
+		trackDatabaseBool = (d == 1.0);
+	}
+	else if (keyword.compare("track_database_resolution") == 0) {
+		if (d <= 0.0) {
+			return std::string("Track database resolution must be positive.");
+		}
+		trackDatabaseResolution = d;
+	}
+	else if (keyword.compare("track_averaging") == 0) {
+		if ((d != 0.0) && (d != 1.0)) {
+			return std::string("Track averaging must be 0 or 1.");
+		}
+		trackAveragingBool = (d == 1.0);
+	}
+	else {
+		return std::string("Unknown solver setting '") + keyword + std::string("'.");
+	}
+	return InputFileReader::VALID_INPUT_STRING;
+}
+
@@ -0,0 +1,155 @@
+//////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+// This file is part of the TRAIN PROPULSION SIMULATOR repository available at github.com/lnaz01/train-propulsion-simulator //
+//////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+#ifndef INPUT_FILE_READER_SOLVER_SETTINGS_DEF
+#define INPUT_FILE_READER_SOLVER_SETTINGS_DEF
+
+#include <string>
+#include "InputFileReader.h"
+
+class InputFileReader_Simulation;
+
+class InputFileReader_SolverSettings : public InputFileReader {
+
+public:
+
+	InputFileReader_SolverSettings(InputFileReader_Simulation* ifrsim);
+
+	virtual ~InputFileReader_SolverSettings();
+
+	// Number of parareal time windows solved concurrently
+	// ('0' or '1' for sequential time integration; '2' or more for parareal time integration)
+	int pararealNumberOfWindows;
+
+	// Duration of each parareal time window (seconds)
+	double pararealWindowDuration;
+
+	// Maximum number of parareal iterations for each block of time windows
+	int pararealMaximumIterations;
+
+	// Parareal convergence tolerance (maximum relative difference between window boundary states of successive iterations)
+	double pararealTolerance;
+
+	// Fixed time step (seconds) of explicit solver for parareal coarse propagator
+	double pararealCoarseTimeStep;
+
+	// Number of blocks of rail vehicles integrated concurrently by explicit solver
+	// ('0' or '1' for no domain decomposition; '2' or more for domain decomposition)
+	int domainDecompositionNumberOfBlocks;
+
+	// Interface force tolerance of domain decomposition (pounds)
+	// ('0' to exchange interface forces at every explicit solver algorithm step; positive for waveform relaxation of interface forces, 
+	// in which each explicit solver time step is repeated until interface forces change by no more than this tolerance)
+	double domainDecompositionInterfaceTolerance;
+
+	// Maximum number of interface iterations for each explicit solver time step of domain decomposition (waveform relaxation only)
+	int domainDecompositionInterfaceIterations;
+
+	// Quasi-static stepping boolean (if 'true', then train consist is advanced as a rigid body during steady running)
+	bool quasiStaticSteppingBool;
+
+	// Quasi-static stepping velocity tolerance (miles / hour)
+	// (maximum difference between speed of any rail vehicle and speed of leading rail vehicle during steady running)
+	double quasiStaticVelocityTolerance;
+
+	// Quasi-static stepping acceleration tolerance (miles / hour / second)
+	// (maximum difference between acceleration of any rail vehicle and acceleration of train consist during steady running)
+	double quasiStaticAccelerationTolerance;
+
+	// Quasi-static stepping settling time (seconds)
+	// (duration of steady running before train consist is advanced as a rigid body)
+	double quasiStaticSettlingTime;
+
+	// Stopped train fast-forward boolean 
+	// (if 'true', then dynamics are frozen while train consist is held at rest by brakes, and simulation skips ahead to next event once pneumatics are settled)
+	bool stoppedTrainFastForwardBool;
+
+	// Calibration boolean (if 'true', then explicit solver and brake pipe finite element size are chosen automatically from a short prefix of the simulation)
+	bool calibrationBool;
+
+	// Duration of simulation prefix used for calibration (seconds)
+	double calibrationDuration;
+
+	// Calibration coupler force tolerance (pounds)
+	// (maximum difference between coupler forces of calibration candidate and calibration reference)
+	double calibrationCouplerForceTolerance;
+
+	// Calibration brake cylinder pressure tolerance (pounds / square inch)
+	// (maximum difference between brake cylinder pressures of calibration candidate and calibration reference)
+	double calibrationBrakeCylinderPressureTolerance;
+
+	// Checkpoint interval (seconds)
+	// (simulated time between rolling in-memory checkpoints used to roll back and retry after numerical instability; '0' for no checkpoints)
+	double checkpointInterval;
+
+	// Maximum number of consecutive retries after numerical instability
+	int checkpointMaximumRetries;
+
+	// Number of coupler force cycle range bins for rainflow counting ('0' for no rainflow counting)
+	int rainflowNumberOfBins;
+
+	// Width of coupler force cycle range bins (pounds)
+	double rainflowBinWidth;
+
+	// Exponent of coupler S-N curve for damage sum ('0' for no damage sum)
+	double rainflowDamageExponent;
+
+	// Coefficient of coupler S-N curve for damage sum (cycles to failure at coupler force range of one pound)
+	double rainflowDamageCoefficient;
+
+	// Resolution of track function lookup tables (feet) ('0' for no lookup tables)
+	double trackTableResolution;
+
+	// Maximum memory of track function lookup tables (megabytes)
+	double trackTableMaxMemory;
+
+	// Binary track database boolean ('true' if track properties are read from binary track database)
+	bool trackDatabaseBool;
+
+	// Resolution of binary track database converted from track functions (feet)
+	double trackDatabaseResolution;
+
+	// Track averaging boolean ('true' if track grade, curvature, and superelevation are averaged over length of each rail vehicle)
+	bool trackAveragingBool;
+
+	// Loads solver settings file
+	std::string load() override;
+
+private:
+
+	// File extension for solver settings files
+	const std::string FE_SSF = "ssf";
+
+	// Maximum number of parareal time windows
+	const int MAX_PARAREAL_NUMBER_OF_WINDOWS = 64;
+
+	// Minimum duration of parareal time window (seconds)
+	const double MIN_PARAREAL_WINDOW_DURATION = 1.0;
+
+	// Maximum fixed time step (seconds) of explicit solver for parareal coarse propagator
+	const double MAX_PARAREAL_COARSE_TIME_STEP = 0.02;
+
+	// Maximum number of domain decomposition blocks
+	const int MAX_DOMAIN_DECOMPOSITION_NUMBER_OF_BLOCKS = 64;
+
+	// Minimum duration of simulation prefix used for calibration (seconds)
+	const double MIN_CALIBRATION_DURATION = 1.0;
+
+	// Maximum number of coupler force cycle range bins for rainflow counting
+	const int MAX_RAINFLOW_NUMBER_OF_BINS = 1000;
+
+	// Minimum memory of track function lookup tables (megabytes)
+	const double MIN_TRACK_TABLE_MAX_MEMORY = 1.0;
+
+	// Simulation input file reader
+	InputFileReader_Simulation* inputFileReader_Simulation;
+
+	// Loads single solver setting (returns validation string)
+	// keyword	-->	Solver setting keyword
+	// value	-->	Solver setting value
+	std::string loadSetting(std::string keyword, std::string value);
+
+};
+
+#endif
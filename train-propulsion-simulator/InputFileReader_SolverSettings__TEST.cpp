@@ -0,0 +1,52 @@
+//////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+// This file is part of the TRAIN PROPULSION SIMULATOR repository available at github.com/lnaz01/train-propulsion-simulator //
+//////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+
+#include <iostream>
+#include "InputFileReader_Simulation.h"
+#include "InputFileReader_SolverSettings.h"
+
+
+int main() {
+
+	std::string idfp = "C:/Users/Leith/Desktop/Simulation_TEST.txt";
+	InputFileReader_Simulation* ifrsim = new InputFileReader_Simulation(idfp);
+	InputFileReader_SolverSettings* ifrss = new InputFileReader_SolverSettings(ifrsim);
+	if (ifrss->inputFileExistsBool == true) {
+		std::string errstr = ifrss->load();
+		std::cout << "Returned String: " << errstr << std::endl;
+	}
+	else {
+		std::cout << "Solver settings file (solver_settings.ssf) does not exist in directory." << std::endl;
+	}
+	std::cout << "Parareal windows: " << ifrss->pararealNumberOfWindows << std::endl;
+	std::cout << "Parareal window duration: " << ifrss->pararealWindowDuration << std::endl;
+	std::cout << "Parareal maximum iterations: " << ifrss->pararealMaximumIterations << std::endl;
+	std::cout << "Parareal tolerance: " << ifrss->pararealTolerance << std::endl;
+	std::cout << "Parareal coarse time step: " << ifrss->pararealCoarseTimeStep << std::endl;
+	std::cout << "Domain decomposition blocks: " << ifrss->domainDecompositionNumberOfBlocks << std::endl;
+	std::cout << "Domain decomposition interface tolerance: " << ifrss->domainDecompositionInterfaceTolerance << std::endl;
+	std::cout << "Domain decomposition interface iterations: " << ifrss->domainDecompositionInterfaceIterations << std::endl;
+	std::cout << "Quasi-static stepping: " << ifrss->quasiStaticSteppingBool << std::endl;
+	std::cout << "Quasi-static velocity tolerance: " << ifrss->quasiStaticVelocityTolerance << std::endl;
+	std::cout << "Quasi-static acceleration tolerance: " << ifrss->quasiStaticAccelerationTolerance << std::endl;
+	std::cout << "Quasi-static settling time: " << ifrss->quasiStaticSettlingTime << std::endl;
+	std::cout << "Stopped train fast-forward: " << ifrss->stoppedTrainFastForwardBool << std::endl;
+	std::cout << "Calibration: " << ifrss->calibrationBool << std::endl;
+	std::cout << "Calibration duration: " << ifrss->calibrationDuration << std::endl;
+	std::cout << "Calibration coupler force tolerance: " << ifrss->calibrationCouplerForceTolerance << std::endl;
+	std::cout << "Calibration brake cylinder pressure tolerance: " << ifrss->calibrationBrakeCylinderPressureTolerance << std::endl;
+	std::cout << "Checkpoint interval: " << ifrss->checkpointInterval << std::endl;
+	std::cout << "Checkpoint maximum retries: " << ifrss->checkpointMaximumRetries << std::endl;
+	std::cout << "Rainflow bins: " << ifrss->rainflowNumberOfBins << std::endl;
+	std::cout << "Rainflow bin width: " << ifrss->rainflowBinWidth << std::endl;
+	std::cout << "Rainflow damage exponent: " << ifrss->rainflowDamageExponent << std::endl;
+	std::cout << "Rainflow damage coefficient: " << ifrss->rainflowDamageCoefficient << std::endl;
+	std::cout << "Track table resolution: " << ifrss->trackTableResolution << std::endl;
+	std::cout << "Track table maximum memory: " << ifrss->trackTableMaxMemory << std::endl;
+	std::cout << "Track database: " << ifrss->trackDatabaseBool << std::endl;
+	std::cout << "Track database resolution: " << ifrss->trackDatabaseResolution << std::endl;
+	std::cout << "Track averaging: " << ifrss->trackAveragingBool << std::endl;
+
+}
@@ -25,6 +25,7 @@ IntervalSmooth::~IntervalSmooth() {
 	if (zvcb == true) {
 		delete[] z;
 		delete[] h;
+		delete[] hornerCoefficients;
 	}
 }
 
@@ -49,6 +50,7 @@ void IntervalSmooth::zap() {
 	if (zvcb == true) {
 		delete[] z;
 		delete[] h;
+		delete[] hornerCoefficients;
 	}
 	// Reset 'zvcb' variable to false
 	zvcb = false;
@@ -67,6 +69,7 @@ void IntervalSmooth::add_point(Point* point) {
 	if (zvcb == true) {
 		delete[] z;
 		delete[] h;
+		delete[] hornerCoefficients;
 	}
 	zvcb = false;
 }
@@ -74,17 +77,16 @@ void IntervalSmooth::add_point(Point* point) {
 
 double IntervalSmooth::interpolate(double xpt, double miny, double maxy) {
 	if (zvcb == false) {
-		calc_z();
-		zvcb = true;
+		compile();
 	}
 	double r = std::numeric_limits<double>::max();
-	for (size_t i = 0; i < (points.size() - 1); i++) {
+	// Last segment containing 'xpt'
+	for (int i = ((int)points.size() - 2); i >= 0; i--) {
 		if ((xpt >= points[i]->x) && (xpt <= points[i + 1]->x)) {
-			double term1 = (z[i] / (6.0 * h[i + 1])) * pow((points[i + 1]->x - xpt), 3.0);
-			double term2 = (z[i + 1] / (6.0 * h[i + 1])) * pow((xpt - points[i]->x), 3.0);
-			double term3 = ((points[i + 1]->y / h[i + 1]) - ((z[i + 1] * h[i + 1]) / 6.0)) * (xpt - points[i]->x);
-			double term4 = ((points[i]->y / h[i + 1]) - ((z[i] * h[i + 1]) / 6.0)) * (points[i + 1]->x - xpt);
-			r = term1 + term2 + term3 + term4;
+			const double* c = &hornerCoefficients[4 * i];
+			double t = xpt - points[i]->x;
+			r = c[0] + (t * (c[1] + (t * (c[2] + (t * c[3])))));
+			break;
 		}
 	}
 	if (r < miny) {
@@ -175,6 +177,28 @@ std::string IntervalSmooth::_load(std::string str, UserDefinedRRComponent* udrrc
 }
 
 
+void IntervalSmooth::compile() {
+	if (zvcb == true) {
+		delete[] z;
+		delete[] h;
+		delete[] hornerCoefficients;
+	}
+	calc_z();
+	calc_hornerCoefficients();
+	zvcb = true;
+}
+
+
+void IntervalSmooth::calc_segmentCoefficients(size_t pointIndex, double* coefficients) {
+	if (zvcb == false) {
+		compile();
+	}
+	for (int k = 0; k < 4; k++) {
+		coefficients[k] = hornerCoefficients[(4 * pointIndex) + k];
+	}
+}
+
+
 void IntervalSmooth::calc_z() {
 	calc_h();
 	// Forcing vector
@@ -193,47 +217,47 @@ void IntervalSmooth::calc_z() {
 				(points[i + 1]->y - points[i]->y)) - ((6.0 / h[i]) * (points[i]->y - points[i - 1]->y));
 		}
 	}
-	// System matrix
-	double** a = new double* [points.size()];
-	for (size_t i = 0; i < points.size(); i++) {
-		a[i] = new double[points.size()];
-	}
+	// System matrix (tridiagonal)
+	double* al = new double[points.size()];  // lower diagonal
+	double* ad = new double[points.size()];  // diagonal
+	double* au = new double[points.size()];  // upper diagonal
 	for (size_t i = 0; i < points.size(); i++) {
-		for (size_t j = 0; j < points.size(); j++) {
-			if (i == j) {
-				if (i == (points.size() - 1)) {
-					a[i][j] = 2.0 * h[i];
-				}
-				else {
-					a[i][j] = 2.0 * (h[i] + h[i + 1]);
-				}
-			}
-			else if (j == (i + 1)) {
-				a[i][j] = h[j];
-			}
-			else if (i == (j + 1)) {
-				a[i][j] = h[i];
-			}
-			else {
-				a[i][j] = 0.0;
-			}
+		if (i == (points.size() - 1)) {
+			ad[i] = 2.0 * h[i];
+			au[i] = 0.0;
+		}
+		else {
+			ad[i] = 2.0 * (h[i] + h[i + 1]);
+			au[i] = h[i + 1];
 		}
+		al[i] = h[i];
 	}
-	linearSystem->gaussElimination(a, d, points.size());
+	linearSystem->thomasAlgorithm(al, ad, au, d, points.size());
 	z = new double[points.size()];
 	for (size_t i = 0; i < points.size(); i++) {
 		z[i] = linearSystem->stateSpaceVector[i];
 	}
-	// Delete system matrix 'a'
-	for (size_t i = 0; i < points.size(); i++) {
-		delete[] a[i];
-	}
-	delete[] a;
+	// Delete system matrix diagonals
+	delete[] al;
+	delete[] ad;
+	delete[] au;
 	// Delete forcing vector 'd'
 	delete[] d;
 }
 
 
+void IntervalSmooth::calc_hornerCoefficients() {
+	hornerCoefficients = new double[4 * (points.size() - 1)];
+	for (size_t i = 0; i < (points.size() - 1); i++) {
+		double* c = &hornerCoefficients[4 * i];
+		c[0] = points[i]->y;
+		c[1] = ((points[i + 1]->y - points[i]->y) / h[i + 1]) - ((h[i + 1] * ((2.0 * z[i]) + z[i + 1])) / 6.0);
+		c[2] = z[i] / 2.0;
+		c[3] = (z[i + 1] - z[i]) / (6.0 * h[i + 1]);
+	}
+}
+
+
 void IntervalSmooth::calc_h() {
 	h = new double[points.size()];
 	h[0] = 0.0;
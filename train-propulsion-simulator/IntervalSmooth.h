@@ -31,6 +31,15 @@ public:
 
 	double interpolate(double xpt, double miny, double maxy) override;
 
+	// Calculates step sizes and intermediate 'z' values of spline from current points
+	// (Note: Should be called whenever points are final, such as after conversion to SI, so that 'interpolate' does not calculate them on first call)
+	void compile();
+
+	// Gets polynomial coefficients of spline segment between two consecutive points
+	// pointIndex		-->	Index of first point of segment
+	// coefficients		-->	Coefficients of constant, linear, quadratic, and cubic terms in distance from first point of segment
+	void calc_segmentCoefficients(size_t pointIndex, double* coefficients);
+
 	std::string _load(std::string str, UserDefinedRRComponent* udrrc, Function* function) override;
 
 	void zap() override;
@@ -46,9 +55,15 @@ private:
 	// Intermediate 'z' values used in 'YSplineInterpolation' method
 	double* z;
 
+	// Polynomial coefficients of each segment (constant, linear, quadratic, and cubic terms in distance from first point of segment, for Horner evaluation)
+	double* hornerCoefficients;
+
 	// Calculates array of doubles 'z' used in the 'Spline' method
 	void calc_z();
 
+	// Calculates polynomial coefficients of each segment from 'z' values
+	void calc_hornerCoefficients();
+
 	// Calculates independent variable 'h' step sizes.  Element at index '0' (first element) is a 'placeholder' and is set equal to zero.
 	void calc_h();
 
@@ -98,3 +98,33 @@ void LinearSystem::gaussElimination(double** systemMatrix, double* forcingVector
 	delete[] forcingVectorCOPY;
 }
 
+
+void LinearSystem::thomasAlgorithm(double* lowerDiagonal, double* diagonal, double* upperDiagonal, double* forcingVector, int dimension) {
+	// Make copy of diagonal and forcing vector
+	double* diagonalCOPY = new double[dimension];
+	double* forcingVectorCOPY = new double[dimension];
+	for (int i = 0; i < dimension; i++) {
+		diagonalCOPY[i] = diagonal[i];
+		forcingVectorCOPY[i] = forcingVector[i];
+	}
+	// Forward elimination
+	for (int ir = 1; ir < dimension; ir++) {
+		double mult = -lowerDiagonal[ir] / diagonalCOPY[ir - 1];
+		diagonalCOPY[ir] = diagonalCOPY[ir] + (mult * upperDiagonal[ir - 1]);
+		forcingVectorCOPY[ir] = forcingVectorCOPY[ir] + (mult * forcingVectorCOPY[ir - 1]);
+	}
+	// Back substitution
+	if (stateSpaceVectorCalcBool == true) {
+		delete[] stateSpaceVector;
+	}
+	stateSpaceVector = new double[dimension];
+	stateSpaceVector[dimension - 1] = forcingVectorCOPY[dimension - 1] / diagonalCOPY[dimension - 1];
+	for (int ir = (dimension - 2); ir >= 0; ir--) {
+		stateSpaceVector[ir] = (forcingVectorCOPY[ir] - (upperDiagonal[ir] * stateSpaceVector[ir + 1])) / diagonalCOPY[ir];
+	}
+	stateSpaceVectorCalcBool = true;
+	// Delete copy of diagonal and forcing vector
+	delete[] diagonalCOPY;
+	delete[] forcingVectorCOPY;
+}
+
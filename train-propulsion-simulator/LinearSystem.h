@@ -22,6 +22,14 @@ public:
 	// dimension		-->	Number of rows (or columns) in square system matrix
 	void gaussElimination(double** systemMatrix, double* forcingVector, int dimension);
 
+	// Thomas algorithm for tridiagonal system matrix (no pivoting, so system matrix should be diagonally dominant)
+	// lowerDiagonal	-->	Lower diagonal of system matrix (element at index 'i' is in row 'i'; element at index '0' is not used)
+	// diagonal			-->	Diagonal of system matrix
+	// upperDiagonal	-->	Upper diagonal of system matrix (element at index 'i' is in row 'i'; last element is not used)
+	// forcingVector	--> Forcing vector
+	// dimension		-->	Number of rows (or columns) in square system matrix
+	void thomasAlgorithm(double* lowerDiagonal, double* diagonal, double* upperDiagonal, double* forcingVector, int dimension);
+
 private:
 
 	// State space vector calculated boolean
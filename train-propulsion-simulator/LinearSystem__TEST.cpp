@@ -10,6 +10,7 @@
 
 
 void BeamOnWinklerFoundation(double* e, double* i, double* k, double* p, double* x, int npts, std::string fnm);
+void SplineSystem(double* x, double* y, int npts);
 
 
 int main() {
@@ -48,6 +49,10 @@ int main() {
 	delete[] mod;
 	delete[] p;
 	delete[] x;
+	// Testing 'thomasAlgorithm' against 'gaussElimination' with spline system of unevenly spaced points
+	double xs[7] = { 5.5, 7.0, 7.5, 8.0, 9.0, 10.0, 12.0 };
+	double ys[7] = { 20.0, 26.5, 16.5, 17.0, 19.0, 11.0, 13.0 };
+	SplineSystem(xs, ys, 7);
 
 }
 
@@ -108,3 +113,77 @@ void BeamOnWinklerFoundation(double* e, double* i, double* k, double* p, double*
 	delete resultsWriter;
 }
 
+
+void SplineSystem(double* x, double* y, int npts) {
+	// Distances between points (same system as 'IntervalSmooth::calc_z')
+	double* h = new double[npts];
+	h[0] = 0.0;
+	for (int j = 1; j < npts; j++) {
+		h[j] = x[j] - x[j - 1];
+	}
+	// Forcing vector (clamped spline with end slopes of end chords)
+	double* d = new double[npts];
+	for (int j = 0; j < npts; j++) {
+		if (j == 0) {
+			d[j] = ((6.0 / h[1]) * (y[1] - y[0])) - (6.0 * ((y[1] - y[0]) / h[1]));
+		}
+		else if (j == (npts - 1)) {
+			d[j] = (6.0 * ((y[npts - 1] - y[npts - 2]) / h[npts - 1])) - ((6.0 / h[npts - 1]) * (y[npts - 1] - y[npts - 2]));
+		}
+		else {
+			d[j] = ((6.0 / h[j + 1]) * (y[j + 1] - y[j])) - ((6.0 / h[j]) * (y[j] - y[j - 1]));
+		}
+	}
+	// System matrix as diagonals and as full matrix
+	double* al = new double[npts];
+	double* ad = new double[npts];
+	double* au = new double[npts];
+	double** sys = new double* [npts];
+	for (int j = 0; j < npts; j++) {
+		if (j == (npts - 1)) {
+			ad[j] = 2.0 * h[j];
+			au[j] = 0.0;
+		}
+		else {
+			ad[j] = 2.0 * (h[j] + h[j + 1]);
+			au[j] = h[j + 1];
+		}
+		al[j] = h[j];
+		sys[j] = new double[npts];
+		for (int j2 = 0; j2 < npts; j2++) {
+			sys[j][j2] = 0.0;
+		}
+		sys[j][j] = ad[j];
+		if (j > 0) {
+			sys[j][j - 1] = al[j];
+		}
+		if (j < (npts - 1)) {
+			sys[j][j + 1] = au[j];
+		}
+	}
+	// Solve with both methods
+	LinearSystem* linearSystemGauss = new LinearSystem;
+	linearSystemGauss->gaussElimination(sys, d, npts);
+	LinearSystem* linearSystemThomas = new LinearSystem;
+	linearSystemThomas->thomasAlgorithm(al, ad, au, d, npts);
+	double maxDifference = 0.0;
+	for (int j = 0; j < npts; j++) {
+		std::cout << "z[" << j << "]: " << linearSystemGauss->stateSpaceVector[j] << " (Gaussian elimination), " << linearSystemThomas->stateSpaceVector[j] <<
+			" (Thomas algorithm)" << std::endl;
+		maxDifference = std::max(maxDifference, std::abs(linearSystemGauss->stateSpaceVector[j] - linearSystemThomas->stateSpaceVector[j]));
+	}
+	std::cout << "maxDifference: " << maxDifference << std::endl;
+	// Delete system
+	for (int j = 0; j < npts; j++) {
+		delete[] sys[j];
+	}
+	delete[] sys;
+	delete[] al;
+	delete[] ad;
+	delete[] au;
+	delete[] d;
+	delete[] h;
+	delete linearSystemGauss;
+	delete linearSystemThomas;
+}
+
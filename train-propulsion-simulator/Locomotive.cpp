@@ -13,6 +13,7 @@
 #include "LocomotiveOperator.h"
 #include "ResultsWriter.h"
 #include "Simulation.h"
+#include "SimulationState.h"
 #include "Track.h"
 #include "TrainConsist.h"
 #include "UnitConverter.h"
@@ -23,6 +24,12 @@ Locomotive::Locomotive(InputFileReader_Simulation* ifrsim) : RailVehicle(ifrsim,
 	for (int i = 0; i < physicalVariablesSize; i++) {
 		physicalVariables.push_back(new Function(this, i));
 	}
+	for (int i = 0; i < 4; i++) {
+		operatorSegmentIndices[i] = 0;
+		operatorSettings[i] = 0.0;
+		operatorSettingRangeStarts[i] = 0.0;
+		operatorSettingRangeEnds[i] = 0.0;
+	}
 	// State space variables
 	// 0	--> Position (feet)
 	// 1	--> Velocity (mph)
@@ -381,8 +388,8 @@ void Locomotive::convertToSI() {
 			physicalVariables[0]->intervals[i]->points[j]->x = x_si;
 			physicalVariables[0]->intervals[i]->points[j]->y = y_si;
 		}
-		((IntervalSmooth*)physicalVariables[0]->intervals[i])->zvcb = false;
 	}
+	physicalVariables[0]->compile();
 	// Physical variable 1 -- Brake shoe friction coefficient
 	for (size_t i = 0; i < physicalVariables[1]->intervals.size(); i++) {
 		for (size_t j = 0; j < physicalVariables[1]->intervals[i]->points.size(); j++) {
@@ -393,8 +400,8 @@ void Locomotive::convertToSI() {
 			physicalVariables[1]->intervals[i]->points[j]->x = x_si;
 			physicalVariables[1]->intervals[i]->points[j]->y = y_si;
 		}
-		((IntervalSmooth*)physicalVariables[1]->intervals[i])->zvcb = false;
 	}
+	physicalVariables[1]->compile();
 	// Physical variable 2 -- Throttle
 	for (size_t i = 0; i < physicalVariables[2]->intervals.size(); i++) {
 		for (size_t j = 0; j < physicalVariables[2]->intervals[i]->points.size(); j++) {
@@ -405,8 +412,8 @@ void Locomotive::convertToSI() {
 			physicalVariables[2]->intervals[i]->points[j]->x = x_si;
 			physicalVariables[2]->intervals[i]->points[j]->y = y_si;
 		}
-		((IntervalSmooth*)physicalVariables[2]->intervals[i])->zvcb = false;
 	}
+	physicalVariables[2]->compile();
 	// Physical variable 3 -- Dynamic brake
 	for (size_t i = 0; i < physicalVariables[3]->intervals.size(); i++) {
 		for (size_t j = 0; j < physicalVariables[3]->intervals[i]->points.size(); j++) {
@@ -417,8 +424,8 @@ void Locomotive::convertToSI() {
 			physicalVariables[3]->intervals[i]->points[j]->x = x_si;
 			physicalVariables[3]->intervals[i]->points[j]->y = y_si;
 		}
-		((IntervalSmooth*)physicalVariables[3]->intervals[i])->zvcb = false;
 	}
+	physicalVariables[3]->compile();
 	// Couplers
 	couplers[0]->convertToSI();
 	couplers[1]->convertToSI();
@@ -462,14 +469,12 @@ void Locomotive::results(Simulation* simulation, bool whb) {
 	currResults.push_back(std::to_string(temp_var));
 	temp_var = UnitConverter::mps_To_Miph(ssv[1]);
 	currResults.push_back(std::to_string(temp_var));
-	temp_var = UnitConverter::rad_To_Pct(inputFileReader_Simulation->userDefinedTracks[0]->physicalVariables[0]->
-		interpolate(ssv[0], inputFileReader_Simulation->userDefinedTracks[0]->PVDMIN_SI[0], inputFileReader_Simulation->userDefinedTracks[0]->PVDMAX_SI[0]));
+	calc_trackProperties();
+	temp_var = UnitConverter::rad_To_Pct(trackProperties[0]);
 	currResults.push_back(std::to_string(temp_var));
-	temp_var = UnitConverter::gCurv_To_TrkCurv(inputFileReader_Simulation->userDefinedTracks[0]->physicalVariables[1]->
-		interpolate(ssv[0], inputFileReader_Simulation->userDefinedTracks[0]->PVDMIN_SI[1], inputFileReader_Simulation->userDefinedTracks[0]->PVDMAX_SI[1]));
+	temp_var = UnitConverter::gCurv_To_TrkCurv(trackProperties[1]);
 	currResults.push_back(std::to_string(temp_var));
-	temp_var = UnitConverter::rad_To_InSup(inputFileReader_Simulation->userDefinedTracks[0]->physicalVariables[2]->
-		interpolate(ssv[0], inputFileReader_Simulation->userDefinedTracks[0]->PVDMIN_SI[2], inputFileReader_Simulation->userDefinedTracks[0]->PVDMAX_SI[2]));
+	temp_var = UnitConverter::rad_To_InSup(trackProperties[2]);
 	currResults.push_back(std::to_string(temp_var));
 	if (positionInTrainConsist < ((int)inputFileReader_Simulation->userDefinedTrainConsists[0]->railVehicles.size() - 1)) {
 		temp_var = UnitConverter::m_To_In(couplers[1]->displacement);
@@ -561,20 +566,18 @@ void Locomotive::calc_idealizedRelayValvePressure() {
 
 void Locomotive::calc_currentAutomaticBrakeValveSetting(bool nextTimeStepBool) {
 	if (locomotiveOperator->DISTANCE_VS_TIME_INDICATOR == 0) {
-		currentAutomaticBrakeValveSetting = locomotiveOperator->physicalVariables[0]->
-			interpolate(inputFileReader_Simulation->userDefinedTrainConsists[0]->locationOnTrack, TrainConsist::ATMOSPHERIC_PRESSURE, LocomotiveOperator::BRAKE_PIPE_OPERATING_PRESSURE);
+		currentAutomaticBrakeValveSetting = calc_operatorSetting(0, inputFileReader_Simulation->userDefinedTrainConsists[0]->locationOnTrack,
+			TrainConsist::ATMOSPHERIC_PRESSURE, LocomotiveOperator::BRAKE_PIPE_OPERATING_PRESSURE);
 	}
 	else if (locomotiveOperator->DISTANCE_VS_TIME_INDICATOR == 1) {
 		if (nextTimeStepBool == true) {
-			currentAutomaticBrakeValveSetting = locomotiveOperator->physicalVariables[0]->
-				interpolate(inputFileReader_Simulation->userDefinedSimulations[0]->implicitSolverTime +
-					inputFileReader_Simulation->userDefinedSimulations[0]->IMPLICIT_SOLVER_FIXED_TIME_STEP,
-					TrainConsist::ATMOSPHERIC_PRESSURE, LocomotiveOperator::BRAKE_PIPE_OPERATING_PRESSURE);
+			currentAutomaticBrakeValveSetting = calc_operatorSetting(0, inputFileReader_Simulation->userDefinedSimulations[0]->implicitSolverTime +
+				inputFileReader_Simulation->userDefinedSimulations[0]->IMPLICIT_SOLVER_FIXED_TIME_STEP,
+				TrainConsist::ATMOSPHERIC_PRESSURE, LocomotiveOperator::BRAKE_PIPE_OPERATING_PRESSURE);
 		}
 		else {
-			currentAutomaticBrakeValveSetting = locomotiveOperator->physicalVariables[0]->
-				interpolate(inputFileReader_Simulation->userDefinedSimulations[0]->implicitSolverTime,
-					TrainConsist::ATMOSPHERIC_PRESSURE, LocomotiveOperator::BRAKE_PIPE_OPERATING_PRESSURE);
+			currentAutomaticBrakeValveSetting = calc_operatorSetting(0, inputFileReader_Simulation->userDefinedSimulations[0]->implicitSolverTime,
+				TrainConsist::ATMOSPHERIC_PRESSURE, LocomotiveOperator::BRAKE_PIPE_OPERATING_PRESSURE);
 		}
 	}
 }
@@ -582,37 +585,43 @@ void Locomotive::calc_currentAutomaticBrakeValveSetting(bool nextTimeStepBool) {
 
 void Locomotive::calc_currentIndependentBrakeValveSetting() {
 	if (locomotiveOperator->DISTANCE_VS_TIME_INDICATOR == 0) {
-		currentIndependentBrakeValveSetting = locomotiveOperator->physicalVariables[1]->
-			interpolate(inputFileReader_Simulation->userDefinedTrainConsists[0]->locationOnTrack, TrainConsist::ATMOSPHERIC_PRESSURE, LocomotiveOperator::BRAKE_PIPE_OPERATING_PRESSURE);
+		currentIndependentBrakeValveSetting = calc_operatorSetting(1, inputFileReader_Simulation->userDefinedTrainConsists[0]->locationOnTrack,
+			TrainConsist::ATMOSPHERIC_PRESSURE, LocomotiveOperator::BRAKE_PIPE_OPERATING_PRESSURE);
 	}
 	else if (locomotiveOperator->DISTANCE_VS_TIME_INDICATOR == 1) {
-		currentIndependentBrakeValveSetting = locomotiveOperator->physicalVariables[1]->
-			interpolate(inputFileReader_Simulation->userDefinedSimulations[0]->explicitSolverTime, TrainConsist::ATMOSPHERIC_PRESSURE, LocomotiveOperator::BRAKE_PIPE_OPERATING_PRESSURE);
+		currentIndependentBrakeValveSetting = calc_operatorSetting(1, inputFileReader_Simulation->userDefinedSimulations[0]->explicitSolverTime,
+			TrainConsist::ATMOSPHERIC_PRESSURE, LocomotiveOperator::BRAKE_PIPE_OPERATING_PRESSURE);
 	}
 }
 
 
 void Locomotive::calc_currentThrottleSetting() {
 	if (locomotiveOperator->DISTANCE_VS_TIME_INDICATOR == 0) {
-		currentThrottleSetting = locomotiveOperator->physicalVariables[2]->
-			interpolate(inputFileReader_Simulation->userDefinedTrainConsists[0]->locationOnTrack, 0.0, locomotiveOperator->PVDMAX_SI[2]);
+		currentThrottleSetting = calc_operatorSetting(2, inputFileReader_Simulation->userDefinedTrainConsists[0]->locationOnTrack, 0.0, locomotiveOperator->PVDMAX_SI[2]);
 	}
 	else if (locomotiveOperator->DISTANCE_VS_TIME_INDICATOR == 1) {
-		currentThrottleSetting = locomotiveOperator->physicalVariables[2]->
-			interpolate(inputFileReader_Simulation->userDefinedSimulations[0]->explicitSolverTime, 0.0, locomotiveOperator->PVDMAX_SI[2]);
+		currentThrottleSetting = calc_operatorSetting(2, inputFileReader_Simulation->userDefinedSimulations[0]->explicitSolverTime, 0.0, locomotiveOperator->PVDMAX_SI[2]);
 	}
 }
 
 
 void Locomotive::calc_currentDynamicBrakeSetting() {
 	if (locomotiveOperator->DISTANCE_VS_TIME_INDICATOR == 0) {
-		currentDynamicBrakeSetting = locomotiveOperator->physicalVariables[3]->
-			interpolate(inputFileReader_Simulation->userDefinedTrainConsists[0]->locationOnTrack, 0.0, locomotiveOperator->PVDMAX_SI[3]);
+		currentDynamicBrakeSetting = calc_operatorSetting(3, inputFileReader_Simulation->userDefinedTrainConsists[0]->locationOnTrack, 0.0, locomotiveOperator->PVDMAX_SI[3]);
 	}
 	else if (locomotiveOperator->DISTANCE_VS_TIME_INDICATOR == 1) {
-		currentDynamicBrakeSetting = locomotiveOperator->physicalVariables[3]->
-			interpolate(inputFileReader_Simulation->userDefinedSimulations[0]->explicitSolverTime, 0.0, locomotiveOperator->PVDMAX_SI[3]);
+		currentDynamicBrakeSetting = calc_operatorSetting(3, inputFileReader_Simulation->userDefinedSimulations[0]->explicitSolverTime, 0.0, locomotiveOperator->PVDMAX_SI[3]);
+	}
+}
+
+
+double Locomotive::calc_operatorSetting(int functionIndex, double independentVariable, double miny, double maxy) {
+	if ((independentVariable < operatorSettingRangeStarts[functionIndex]) || (independentVariable >= operatorSettingRangeEnds[functionIndex])) {
+		operatorSettings[functionIndex] = locomotiveOperator->physicalVariables[functionIndex]->interpolate(independentVariable, miny, maxy, &operatorSegmentIndices[functionIndex]);
+		locomotiveOperator->physicalVariables[functionIndex]->calc_constantRange(independentVariable, &operatorSettingRangeStarts[functionIndex],
+			&operatorSettingRangeEnds[functionIndex]);
 	}
+	return operatorSettings[functionIndex];
 }
 
 
@@ -654,3 +663,31 @@ void Locomotive::calc_throttleForce() {
 	throttleForce = currentThrottleSetting * engineEffectivenessRatio * physicalVariables[2]->interpolate(ssv[1], PVDMIN_SI[2], PVDMAX_SI[2]);
 }
 
+
+void Locomotive::saveState(SimulationState* simulationState) {
+	RailVehicle::saveState(simulationState);
+	simulationState->append(currentIndependentBrakeValveSetting, true);
+	simulationState->append(currentAutomaticBrakeValveSetting, true);
+	simulationState->append(idealizedRelayValvePressure, true);
+	simulationState->append(previousAutomaticBrakeValveSetting, false);
+	simulationState->append(currentThrottleSetting, false);
+	simulationState->append(currentDynamicBrakeSetting, false);
+	simulationState->append(previousAutomaticBrakeValveSetting_dummy, false);
+	simulationState->append(automaticBrakeValveSettingTransitionPeriod, false);
+	simulationState->append(timeofLastAutomaticBrakeValveSettingChange, false);
+}
+
+
+void Locomotive::loadState(SimulationState* simulationState) {
+	RailVehicle::loadState(simulationState);
+	currentIndependentBrakeValveSetting = simulationState->next();
+	currentAutomaticBrakeValveSetting = simulationState->next();
+	idealizedRelayValvePressure = simulationState->next();
+	previousAutomaticBrakeValveSetting = simulationState->next();
+	currentThrottleSetting = simulationState->next();
+	currentDynamicBrakeSetting = simulationState->next();
+	previousAutomaticBrakeValveSetting_dummy = simulationState->next();
+	automaticBrakeValveSettingTransitionPeriod = simulationState->next();
+	timeofLastAutomaticBrakeValveSettingChange = simulationState->next();
+}
+
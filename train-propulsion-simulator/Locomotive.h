@@ -10,6 +10,7 @@
 
 class InputFileReader_Simulation;
 class LocomotiveOperator;
+class SimulationState;
 
 class Locomotive : public RailVehicle {
 
@@ -22,6 +23,20 @@ public:
 	// Locomotive operator
 	LocomotiveOperator* locomotiveOperator;
 
+	// Indices of locomotive operator function segments found at last lookup (automatic brake, independent brake, throttle, and dynamic brake)
+	// (search hints for locomotive operator function interpolation, since time and location change little from one lookup to the next)
+	size_t operatorSegmentIndices[4];
+
+	// Values of locomotive operator functions at last evaluation (automatic brake, independent brake, throttle, and dynamic brake)
+	double operatorSettings[4];
+
+	// First time or location of range over which each locomotive operator function keeps value of last evaluation (seconds or meters)
+	double operatorSettingRangeStarts[4];
+
+	// Time or location at which range over which each locomotive operator function keeps value of last evaluation ends (seconds or meters)
+	// (Locomotive operator function is evaluated again only once time or location leaves range, such as at next breakpoint of piecewise constant schedule)
+	double operatorSettingRangeEnds[4];
+
 	// Current independent brake valve setting (pascals)
 	double currentIndependentBrakeValveSetting;
 
@@ -41,6 +56,10 @@ public:
 
 	void calc_throttleForce() override;
 
+	void saveState(SimulationState* simulationState) override;
+
+	void loadState(SimulationState* simulationState) override;
+
 	// Calculates current throttle setting
 	void calc_currentThrottleSetting();
 
@@ -67,6 +86,14 @@ protected:
 
 private:
 
+	// Calculates value of locomotive operator function at time or location (last value is reused if time or location is in range over which function
+	// keeps last value)
+	// functionIndex			-->	Locomotive operator function index (0 for automatic brake, 1 for independent brake, 2 for throttle, 3 for dynamic brake)
+	// independentVariable		-->	Time (seconds) or location (meters)
+	// miny						-->	Minimum threshold for locomotive operator setting
+	// maxy						-->	Maximum threshold for locomotive operator setting
+	double calc_operatorSetting(int functionIndex, double independentVariable, double miny, double maxy);
+
 	// Automatic brake valve setting rate of change for service braking (pascals per second)
 	const double ABVROC_SB = UnitConverter::psi_To_Pa(2.0);
 
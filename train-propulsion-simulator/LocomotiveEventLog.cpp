@@ -0,0 +1,195 @@
+//////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+// This file is part of the TRAIN PROPULSION SIMULATOR repository available at github.com/lnaz01/train-propulsion-simulator //
+//////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+
+#include <cmath>
+#include <cstdlib>
+#include <fstream>
+#include "LocomotiveEventLog.h"
+#include "Function.h"
+#include "InputFileReader.h"
+#include "LocomotiveOperator.h"
+#include "UnitConverter.h"
+
+
+const std::string LocomotiveEventLog::TIME_COLUMN_NAME = "time";
+
+
+const std::string LocomotiveEventLog::POSITION_COLUMN_NAME = "position";
+
+
+const std::string LocomotiveEventLog::SETTING_COLUMN_NAMES[4] = { "automatic_brake", "independent_brake", "throttle_notch", "dynamic_brake_notch" };
+
+
+LocomotiveEventLog::LocomotiveEventLog(std::string filePath) {
+	this->filePath = filePath;
+	DISTANCE_VS_TIME_INDICATOR = 1;
+	end = 0.0;
+	numberOfRecords = 0;
+}
+
+
+LocomotiveEventLog::~LocomotiveEventLog() {}
+
+
+std::string LocomotiveEventLog::load(LocomotiveOperator* locomotiveOperator) {
+	std::ifstream ifs(filePath);
+	if (ifs.is_open() == false) {
+		return std::string("Locomotive event log file '") + filePath + std::string("' could not be opened.");
+	}
+	for (int k = 0; k < 4; k++) {
+		stepStarts[k].clear();
+		stepValues[k].clear();
+	}
+	end = 0.0;
+	numberOfRecords = 0;
+	std::vector<std::string> columnNames;  // column names
+	std::vector<int> columnSettings;  // operator setting index of each column ('-1' for ignored columns)
+	std::string line;  // current line (reused for every line, so records are read without allocation)
+	size_t lineNumber = 0;
+	while (std::getline(ifs, line)) {
+		lineNumber++;
+		const char* c = line.c_str();  // current character
+		while ((*c == ' ') || (*c == '\t')) {
+			c++;
+		}
+		if ((*c == '\0') || (*c == '\r') || (*c == InputFileReader::COMMENT_CHARACTER)) {
+			continue;
+		}
+		// Column names
+		if (columnNames.size() == 0) {
+			columnNames = InputFileReader::split_string(line, ',');
+			for (size_t j = 0; j < columnNames.size(); j++) {
+				std::string name;
+				for (size_t m = 0; m < columnNames[j].length(); m++) {
+					if ((columnNames[j][m] != ' ') && (columnNames[j][m] != '\t') && (columnNames[j][m] != '\r')) {
+						name.push_back(columnNames[j][m]);
+					}
+				}
+				columnNames[j] = name;
+			}
+			if (columnNames[0].compare(POSITION_COLUMN_NAME) == 0) {
+				DISTANCE_VS_TIME_INDICATOR = 0;
+			}
+			else if (columnNames[0].compare(TIME_COLUMN_NAME) == 0) {
+				DISTANCE_VS_TIME_INDICATOR = 1;
+			}
+			else {
+				return errorMessage(lineNumber, std::string("First column must be '") + TIME_COLUMN_NAME + std::string("' or '") + POSITION_COLUMN_NAME +
+					std::string("'."));
+			}
+			columnSettings.assign(columnNames.size(), -1);
+			for (int k = 0; k < 4; k++) {
+				bool foundBool = false;
+				for (size_t j = 1; j < columnNames.size(); j++) {
+					if (columnNames[j].compare(SETTING_COLUMN_NAMES[k]) == 0) {
+						if (foundBool == true) {
+							return errorMessage(lineNumber, std::string("Column '") + SETTING_COLUMN_NAMES[k] + std::string("' appears more than once."));
+						}
+						columnSettings[j] = k;
+						foundBool = true;
+					}
+				}
+				if (foundBool == false) {
+					return errorMessage(lineNumber, std::string("Column '") + SETTING_COLUMN_NAMES[k] + std::string("' is missing."));
+				}
+			}
+			continue;
+		}
+		// Record
+		double x = 0.0;  // independent variable value
+		double settings[4];  // operator settings
+		for (size_t j = 0; j < columnSettings.size(); j++) {
+			if (j > 0) {
+				if (*c != ',') {
+					return errorMessage(lineNumber, std::string("Record must have ") + std::to_string(columnSettings.size()) + std::string(" columns."));
+				}
+				c++;
+			}
+			if ((j == 0) || (columnSettings[j] >= 0)) {
+				char* e;  // end of number
+				double d = std::strtod(c, &e);
+				if ((e == c) || (std::isfinite(d) == false)) {
+					return errorMessage(lineNumber, std::string("Value in column '") + columnNames[j] + std::string("' is not a number."));
+				}
+				c = e;
+				if (j == 0) {
+					x = d;
+				}
+				else {
+					settings[columnSettings[j]] = d;
+				}
+			}
+			else {
+				while ((*c != ',') && (*c != '\0')) {
+					c++;
+				}
+			}
+			while ((*c == ' ') || (*c == '\t') || (*c == '\r')) {
+				c++;
+			}
+		}
+		if (*c != '\0') {
+			return errorMessage(lineNumber, std::string("Record must have ") + std::to_string(columnSettings.size()) + std::string(" columns."));
+		}
+		// Check values
+		if ((DISTANCE_VS_TIME_INDICATOR == 1) && (x < 0.0)) {
+			return errorMessage(lineNumber, std::string("Time must not be negative."));
+		}
+		for (int k = 0; k < 2; k++) {
+			if ((settings[k] < locomotiveOperator->PVDMIN_US[k]) || (settings[k] > locomotiveOperator->PVDMAX_US[k])) {
+				return errorMessage(lineNumber, std::string("Value in column '") + SETTING_COLUMN_NAMES[k] + std::string("' must be between ") +
+					std::to_string(locomotiveOperator->PVDMIN_US[k]) + std::string(" and ") + std::to_string(locomotiveOperator->PVDMAX_US[k]) + std::string(" ") +
+					locomotiveOperator->PVDSTR_US[k] + std::string("."));
+			}
+		}
+		for (int k = 2; k < 4; k++) {
+			if ((settings[k] < 0.0) || (settings[k] > NUMBER_OF_NOTCHES)) {
+				return errorMessage(lineNumber, std::string("Value in column '") + SETTING_COLUMN_NAMES[k] + std::string("' must be between 0 and ") +
+					std::to_string((int)NUMBER_OF_NOTCHES) + std::string("."));
+			}
+		}
+		// Convert to SI units
+		if (DISTANCE_VS_TIME_INDICATOR == 0) {
+			x = UnitConverter::ft_To_M(x);
+		}
+		if ((numberOfRecords > 0) && (x <= end)) {
+			return errorMessage(lineNumber, std::string("Values in column '") + columnNames[0] + std::string("' must be increasing."));
+		}
+		settings[0] = UnitConverter::psi_To_Pa(settings[0]);
+		settings[1] = UnitConverter::psi_To_Pa(settings[1]);
+		settings[2] = settings[2] / NUMBER_OF_NOTCHES;
+		settings[3] = settings[3] / NUMBER_OF_NOTCHES;
+		// New step only where setting changes
+		for (int k = 0; k < 4; k++) {
+			if ((stepValues[k].size() == 0) || (settings[k] != stepValues[k][stepValues[k].size() - 1])) {
+				stepStarts[k].push_back(x);
+				stepValues[k].push_back(settings[k]);
+			}
+		}
+		end = x;
+		numberOfRecords++;
+	}
+	if (columnNames.size() == 0) {
+		return std::string("Locomotive event log file '") + filePath + std::string("' must start with a line of column names.");
+	}
+	if (numberOfRecords < 2) {
+		return std::string("Locomotive event log file '") + filePath + std::string("' must have at least two records.");
+	}
+	return InputFileReader::VALID_INPUT_STRING;
+}
+
+
+void LocomotiveEventLog::attach(LocomotiveOperator* locomotiveOperator) {
+	locomotiveOperator->DISTANCE_VS_TIME_INDICATOR = DISTANCE_VS_TIME_INDICATOR;
+	for (int k = 0; k < 4; k++) {
+		locomotiveOperator->physicalVariables[k]->compileSteps(stepStarts[k], stepValues[k], end);
+	}
+}
+
+
+std::string LocomotiveEventLog::errorMessage(size_t lineNumber, std::string message) {
+	return std::string("Error on line ") + std::to_string(lineNumber) + std::string(" of locomotive event log file '") + filePath + std::string("': ") + message;
+}
+
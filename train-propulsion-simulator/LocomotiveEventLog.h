@@ -0,0 +1,75 @@
+//////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+// This file is part of the TRAIN PROPULSION SIMULATOR repository available at github.com/lnaz01/train-propulsion-simulator //
+//////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+#ifndef LOCOMOTIVE_EVENT_LOG_DEF
+#define LOCOMOTIVE_EVENT_LOG_DEF
+
+#include <string>
+#include <vector>
+
+class LocomotiveOperator;
+
+// Locomotive event log
+// (Columnar text file of recorded locomotive operator settings.  The first line names the columns, and each following line holds one record.  The
+// first column is time (seconds) or position along track (feet), and the columns holding the automatic brake setting (psi), independent brake setting
+// (psi), throttle notch, and dynamic brake notch are found by name, so that other recorded columns are ignored.  Records are read in a single pass
+// without storing them, and each setting is kept as the list of steps at which it changes, which becomes a compiled step function of the locomotive
+// operator.)
+class LocomotiveEventLog {
+
+public:
+
+	// filePath		-->	Absolute path of locomotive event log file
+	LocomotiveEventLog(std::string filePath);
+
+	virtual ~LocomotiveEventLog();
+
+	// Column name of time (first column of time-based event log)
+	static const std::string TIME_COLUMN_NAME;
+
+	// Column name of position (first column of distance-based event log)
+	static const std::string POSITION_COLUMN_NAME;
+
+	// Column names of operator settings (in order of locomotive operator physical variables)
+	static const std::string SETTING_COLUMN_NAMES[4];
+
+	// Number of throttle and dynamic brake notches (notch is converted to setting by dividing by number of notches)
+	static constexpr double NUMBER_OF_NOTCHES = 8.0;
+
+	// Absolute path of locomotive event log file
+	std::string filePath;
+
+	// Distance-based versus time-based indicator ('0' for distance-based; '1' for time-based)
+	int DISTANCE_VS_TIME_INDICATOR;
+
+	// Independent variable values at which steps of each operator setting start (meters for distance-based or seconds for time-based)
+	std::vector<double> stepStarts[4];
+
+	// Values of steps of each operator setting (pascals for brake settings, unitless for throttle and dynamic brake settings)
+	std::vector<double> stepValues[4];
+
+	// Independent variable value of last record (meters for distance-based or seconds for time-based)
+	double end;
+
+	// Number of records
+	size_t numberOfRecords;
+
+	// Reads locomotive event log file and converts operator settings to steps in SI units (returns error message if file is not valid)
+	// locomotiveOperator	-->	Locomotive operator (for limits of operator settings)
+	std::string load(LocomotiveOperator* locomotiveOperator);
+
+	// Replaces physical variables of locomotive operator by step functions of operator settings
+	// locomotiveOperator	-->	Locomotive operator
+	void attach(LocomotiveOperator* locomotiveOperator);
+
+private:
+
+	// Returns error message for line of locomotive event log file
+	// lineNumber	-->	Line number
+	// message		-->	Message
+	std::string errorMessage(size_t lineNumber, std::string message);
+
+};
+
+#endif
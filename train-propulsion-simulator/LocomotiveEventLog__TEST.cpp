@@ -0,0 +1,64 @@
+//////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+// This file is part of the TRAIN PROPULSION SIMULATOR repository available at github.com/lnaz01/train-propulsion-simulator //
+//////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+
+#include <iostream>
+#include "LocomotiveEventLog.h"
+#include "Function.h"
+#include "InputFileReader_Simulation.h"
+#include "LocomotiveOperator.h"
+#include "Track.h"
+
+
+int main() {
+
+	// Track
+	std::string inputFileAbsolutePath_TRACK = "C:/Users/Leith/Desktop/MyTrack__test.txt";
+	InputFileReader_Simulation* inputFileReaderSimulation_TRACK = new InputFileReader_Simulation(inputFileAbsolutePath_TRACK);
+	inputFileReaderSimulation_TRACK->userDefinedTracks.push_back(new Track(inputFileReaderSimulation_TRACK));
+	std::string validString_TRACK = inputFileReaderSimulation_TRACK->userDefinedTracks[0]->load();
+	std::cout << "Line " << inputFileReaderSimulation_TRACK->currentLineNumber << ": " << validString_TRACK << std::endl;
+	std::cout << std::endl;
+	if (validString_TRACK.compare(InputFileReader::VALID_INPUT_STRING) != 0) {
+		std::cout << "Failed to load track" << std::endl;
+		exit(EXIT_FAILURE);
+	}
+
+	// Locomotive operator
+	std::string inputFileAbsolutePath_LOCOMOTIVE_OPERATOR = "C:/Users/Leith/Desktop/MyLocomotiveOperator__test.txt";
+	InputFileReader_Simulation* inputFileReaderSimulation_LOCOMOTIVE_OPERATOR = new InputFileReader_Simulation(inputFileAbsolutePath_LOCOMOTIVE_OPERATOR);
+	inputFileReaderSimulation_LOCOMOTIVE_OPERATOR->userDefinedTracks.push_back(inputFileReaderSimulation_TRACK->userDefinedTracks[0]);
+	inputFileReaderSimulation_LOCOMOTIVE_OPERATOR->userDefinedLocomotiveOperators.push_back(new LocomotiveOperator(inputFileReaderSimulation_LOCOMOTIVE_OPERATOR));
+	LocomotiveOperator* locomotiveOperator = inputFileReaderSimulation_LOCOMOTIVE_OPERATOR->userDefinedLocomotiveOperators[0];
+	std::string validString_LOCOMOTIVE_OPERATOR = locomotiveOperator->load();
+	std::cout << "Line " << inputFileReaderSimulation_LOCOMOTIVE_OPERATOR->currentLineNumber << ": " << validString_LOCOMOTIVE_OPERATOR << std::endl;
+	std::cout << std::endl;
+	if (validString_LOCOMOTIVE_OPERATOR.compare(InputFileReader::VALID_INPUT_STRING) != 0) {
+		std::cout << "Failed to load locomotive operator" << std::endl;
+		exit(EXIT_FAILURE);
+	}
+
+	// Locomotive event log
+	LocomotiveEventLog* locomotiveEventLog = new LocomotiveEventLog("C:/Users/Leith/Desktop/MyLocomotiveEventLog__test.tel");
+	std::string validString_LOCOMOTIVE_EVENT_LOG = locomotiveEventLog->load(locomotiveOperator);
+	std::cout << "Returned String: " << validString_LOCOMOTIVE_EVENT_LOG << std::endl;
+	if (validString_LOCOMOTIVE_EVENT_LOG.compare(InputFileReader::VALID_INPUT_STRING) == 0) {
+		std::cout << "Number of records: " << locomotiveEventLog->numberOfRecords << std::endl;
+		for (int k = 0; k < 4; k++) {
+			std::cout << "Number of steps of '" << LocomotiveEventLog::SETTING_COLUMN_NAMES[k] << "': " << locomotiveEventLog->stepStarts[k].size() << std::endl;
+		}
+		locomotiveEventLog->attach(locomotiveOperator);
+		double dx = locomotiveEventLog->end / 20.0;
+		for (double x = 0.0; x <= locomotiveEventLog->end; x = x + dx) {
+			std::cout << x;
+			for (int k = 0; k < 4; k++) {
+				std::cout << ", " << locomotiveOperator->physicalVariables[k]->interpolate(x, locomotiveOperator->PVDMIN_SI[k], locomotiveOperator->PVDMAX_SI[k]);
+			}
+			std::cout << ", end of constant input: " << locomotiveOperator->calc_endOfConstantInput(x) << std::endl;
+		}
+	}
+	delete locomotiveEventLog;
+
+}
+
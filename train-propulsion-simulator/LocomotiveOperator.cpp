@@ -3,11 +3,13 @@
 //////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
 
 
+#include <limits>
 #include "LocomotiveOperator.h"
 #include "Function.h"
 #include "InputFileReader_Simulation.h"
 #include "IntervalSmooth.h"
 #include "IntervalStep.h"
+#include "Point.h"
 #include "Simulation.h"
 #include "Track.h"
 #include "TrainConsist.h"
@@ -87,6 +89,7 @@ void LocomotiveOperator::convertToSI() {
 			physicalVariables[0]->intervals[i]->points[j]->y = y_si;
 		}
 	}
+	physicalVariables[0]->compile();
 	// Physical variable 1 (independent brake)
 	for (size_t i = 0; i <= (physicalVariables[1]->intervals.size() - 1); i++) {
 		for (size_t j = 0; j <= (physicalVariables[1]->intervals[i]->points.size() - 1); j++) {
@@ -104,6 +107,7 @@ void LocomotiveOperator::convertToSI() {
 			physicalVariables[1]->intervals[i]->points[j]->y = y_si;
 		}
 	}
+	physicalVariables[1]->compile();
 	// Physical variable 2 (throttle setting)
 	for (size_t i = 0; i <= (physicalVariables[2]->intervals.size() - 1); i++) {
 		for (size_t j = 0; j <= (physicalVariables[2]->intervals[i]->points.size() - 1); j++) {
@@ -120,8 +124,8 @@ void LocomotiveOperator::convertToSI() {
 			physicalVariables[2]->intervals[i]->points[j]->x = x_si;
 			physicalVariables[2]->intervals[i]->points[j]->y = y_si;
 		}
-		((IntervalSmooth*)physicalVariables[2]->intervals[i])->zvcb = false;
 	}
+	physicalVariables[2]->compile();
 	// Physical variable 3 (dynamic brake setting)
 	for (size_t i = 0; i <= (physicalVariables[3]->intervals.size() - 1); i++) {
 		for (size_t j = 0; j <= (physicalVariables[3]->intervals[i]->points.size() - 1); j++) {
@@ -138,8 +142,8 @@ void LocomotiveOperator::convertToSI() {
 			physicalVariables[3]->intervals[i]->points[j]->x = x_si;
 			physicalVariables[3]->intervals[i]->points[j]->y = y_si;
 		}
-		((IntervalSmooth*)physicalVariables[3]->intervals[i])->zvcb = false;
 	}
+	physicalVariables[3]->compile();
 }
 
 
@@ -291,6 +295,34 @@ void LocomotiveOperator::definePhysicalVariableLimits() {
 }
 
 
+double LocomotiveOperator::calc_endOfConstantInput(double xpt) {
+	double eci = std::numeric_limits<double>::max();  // end of constant input
+	for (size_t i = 0; i < physicalVariables.size(); i++) {
+		// Physical variable is constant until end of range of constant value containing independent variable value, and beyond while following ranges of
+		// constant value have same value (ranges are found from compiled function, so time taken does not depend on number of breakpoints beyond change)
+		double cv = physicalVariables[i]->interpolate(xpt, PVDMIN_SI[i], PVDMAX_SI[i]);  // current value
+		double pb = xpt;  // end of constant value
+		double rs;  // start of range of constant value
+		double re;  // end of range of constant value
+		physicalVariables[i]->calc_constantRange(xpt, &rs, &re);
+		while ((re > pb) && (re < std::numeric_limits<double>::infinity())) {
+			pb = re;
+			if (physicalVariables[i]->interpolate(re, PVDMIN_SI[i], PVDMAX_SI[i]) != cv) {
+				break;
+			}
+			physicalVariables[i]->calc_constantRange(re, &rs, &re);
+		}
+		if (re == std::numeric_limits<double>::infinity()) {
+			pb = std::numeric_limits<double>::max();
+		}
+		if (pb < eci) {
+			eci = pb;
+		}
+	}
+	return eci;
+}
+
+
 void LocomotiveOperator::loadPhysicalConstantAlternateNames() {
 	DISTANCE_VS_TIME_INDICATOR = (int)physicalConstants[0];
 }
@@ -31,6 +31,12 @@ public:
 	// Defines physical variable limits
 	void definePhysicalVariableLimits();
 
+	// Calculates end of period of constant operator input that contains independent variable value (returns independent variable value 
+	// if operator input is changing; returns maximum double value if operator input never changes)
+	// (Note: Independent variable is distance (meters) for distance-based operator and time (seconds) for time-based operator)
+	// xpt		-->	Independent variable value
+	double calc_endOfConstantInput(double xpt);
+
 protected:
 
 	void loadPhysicalConstantAlternateNames() override;
@@ -0,0 +1,188 @@
+//////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+// This file is part of the TRAIN PROPULSION SIMULATOR repository available at github.com/lnaz01/train-propulsion-simulator //
+//////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+
+#include <cmath>
+#include <iostream>
+#include <thread>
+#include "Parareal.h"
+#include "InputFileReader_ForcedSpeed.h"
+#include "InputFileReader_Simulation.h"
+#include "InputFileReader_SolverSettings.h"
+#include "Simulation.h"
+#include "SimulationState.h"
+#include "Track.h"
+
+
+Parareal::Parareal(Simulation* simulation, InputFileReader_SolverSettings* inputFileReader_SolverSettings) {
+	this->simulation = simulation;
+	this->inputFileReader_SolverSettings = inputFileReader_SolverSettings;
+	numberOfWindows = inputFileReader_SolverSettings->pararealNumberOfWindows;
+	numberOfImplicitSolverTimeStepsPerWindow = (int)std::round(inputFileReader_SolverSettings->pararealWindowDuration / simulation->IMPLICIT_SOLVER_FIXED_TIME_STEP);
+	// Create fine propagators (which write results for their time window to separate output results files)
+	for (int i = 0; i < numberOfWindows; i++) {
+		fineSimulations.push_back(createSimulation("_parareal_" + std::to_string(i), true));
+	}
+	// Create coarse propagator
+	coarseSimulation = createSimulation("", false);
+	// Allocate states
+	for (int i = 0; i <= numberOfWindows; i++) {
+		startStates.push_back(new SimulationState());
+	}
+	for (int i = 0; i < numberOfWindows; i++) {
+		fineStates.push_back(new SimulationState());
+		coarseStates.push_back(new SimulationState());
+		fineTerminationConditions.push_back(Simulation::TC_NONE);
+	}
+}
+
+
+Parareal::~Parareal() {
+	for (size_t i = 0; i < fineSimulations.size(); i++) {
+		fineSimulations[i]->removeResultsFiles();
+	}
+	for (size_t i = 0; i < inputFileReaders_Simulation.size(); i++) {
+		delete inputFileReaders_ForcedSpeed[i];
+		delete inputFileReaders_Simulation[i];
+	}
+	for (size_t i = 0; i < startStates.size(); i++) {
+		delete startStates[i];
+	}
+	for (size_t i = 0; i < fineStates.size(); i++) {
+		delete fineStates[i];
+		delete coarseStates[i];
+	}
+}
+
+
+int Parareal::simulate() {
+	int tc = Simulation::TC_NONE;  // termination condition
+	SimulationState* previousStartState = new SimulationState();
+	do {
+		// Number of time windows in current block (reduced if a propagator terminates inside the block)
+		int nb = numberOfWindows;
+		// Initial coarse prediction of window start states
+		startStates[0]->capture(simulation);
+		for (int n = 0; n < nb; n++) {
+			int ctc = propagateCoarse(startStates[n], coarseStates[n]);  // coarse termination condition
+			startStates[n + 1]->stateVariables = coarseStates[n]->stateVariables;
+			startStates[n + 1]->continuousBools = coarseStates[n]->continuousBools;
+			if (ctc != Simulation::TC_NONE) {
+				nb = n + 1;
+			}
+		}
+		// Parareal iterations
+		int k = 0;  // iteration index
+		bool convergedBool = false;
+		while (convergedBool == false) {
+			// Fine propagation of windows whose start state is not yet exact (concurrently)
+			std::vector<std::thread> threads;
+			for (int n = k; n < nb; n++) {
+				threads.push_back(std::thread(&Parareal::propagateFine, this, n));
+			}
+			for (size_t i = 0; i < threads.size(); i++) {
+				threads[i].join();
+			}
+			for (int n = k; n < nb; n++) {
+				if (fineTerminationConditions[n] != Simulation::TC_NONE) {
+					nb = n + 1;
+					break;
+				}
+			}
+			// Sequential coarse correction
+			double mrd = 0.0;  // maximum relative difference
+			startStates[k + 1]->stateVariables = fineStates[k]->stateVariables;
+			startStates[k + 1]->continuousBools = fineStates[k]->continuousBools;
+			for (int n = k + 1; n < nb; n++) {
+				SimulationState* coarseState = new SimulationState();
+				int ctc = propagateCoarse(startStates[n], coarseState);  // coarse termination condition
+				previousStartState->stateVariables = startStates[n + 1]->stateVariables;
+				previousStartState->continuousBools = startStates[n + 1]->continuousBools;
+				startStates[n + 1]->calc_pararealUpdate(coarseState, fineStates[n], coarseStates[n]);
+				delete coarseStates[n];
+				coarseStates[n] = coarseState;
+				mrd = std::max(mrd, startStates[n + 1]->maxRelativeDifference(previousStartState));
+				if (ctc != Simulation::TC_NONE) {
+					nb = n + 1;
+					break;
+				}
+			}
+			k++;
+			if ((mrd < inputFileReader_SolverSettings->pararealTolerance) || (k >= nb) || (k >= inputFileReader_SolverSettings->pararealMaximumIterations)) {
+				convergedBool = true;
+			}
+		}
+		// Append window results to output results files, and continue from end state of last window
+		for (int n = 0; n < nb; n++) {
+			simulation->appendResults(fineSimulations[n]);
+		}
+		fineStates[nb - 1]->restore(simulation);
+		tc = fineTerminationConditions[nb - 1];
+		// Update progress
+		int progress = (int)((simulation->implicitSolverTime / Simulation::MAX_NUMBER_OF_SIMULATED_SECONDS) * 100.0);
+		if (tc == Simulation::TC_NONE) {
+			std::cout << progress << "% complete" << std::endl;
+			std::cout << std::endl;
+		}
+	} while (tc == Simulation::TC_NONE);
+	delete previousStartState;
+	return tc;
+}
+
+
+Simulation* Parareal::createSimulation(std::string inputFileNameSuffix, bool writeResultsBool) {
+	InputFileReader_Simulation* inputFileReader_Simulation = new InputFileReader_Simulation(simulation->inputFileReader_Simulation->inputFileAbsolutePath);
+	inputFileReader_Simulation->load();
+	inputFileReader_Simulation->userDefinedTracks[0]->calc_trackLength();
+	inputFileReader_Simulation->inputFileName = simulation->inputFileReader_Simulation->inputFileName + inputFileNameSuffix;
+	InputFileReader_ForcedSpeed* inputFileReader_ForcedSpeed = new InputFileReader_ForcedSpeed(inputFileReader_Simulation);
+	if (inputFileReader_ForcedSpeed->inputFileExistsBool == true) {
+		inputFileReader_ForcedSpeed->load();
+	}
+	inputFileReaders_Simulation.push_back(inputFileReader_Simulation);
+	inputFileReaders_ForcedSpeed.push_back(inputFileReader_ForcedSpeed);
+	Simulation* replicaSimulation = inputFileReader_Simulation->userDefinedSimulations[0];
+	replicaSimulation->printProgressBool = false;
+	replicaSimulation->explicitSolverType = simulation->explicitSolverType;
+	replicaSimulation->explicitSolverFixedTimeStep = simulation->explicitSolverFixedTimeStep;
+	replicaSimulation->explicitSolverMaxErrorThreshold = simulation->explicitSolverMaxErrorThreshold;
+	replicaSimulation->brakePipeFiniteElementSize = simulation->brakePipeFiniteElementSize;
+	replicaSimulation->quasiStaticSteppingBool = simulation->quasiStaticSteppingBool;
+	replicaSimulation->quasiStaticVelocityTolerance = simulation->quasiStaticVelocityTolerance;
+	replicaSimulation->quasiStaticAccelerationTolerance = simulation->quasiStaticAccelerationTolerance;
+	replicaSimulation->quasiStaticSettlingTime = simulation->quasiStaticSettlingTime;
+	replicaSimulation->rainflowNumberOfBins = simulation->rainflowNumberOfBins;
+	replicaSimulation->rainflowBinWidth = simulation->rainflowBinWidth;
+	replicaSimulation->rainflowDamageExponent = simulation->rainflowDamageExponent;
+	replicaSimulation->rainflowDamageCoefficient = simulation->rainflowDamageCoefficient;
+	replicaSimulation->trackTableResolution = simulation->trackTableResolution;
+	replicaSimulation->trackTableMaxMemory = simulation->trackTableMaxMemory;
+	replicaSimulation->trackDatabaseBool = simulation->trackDatabaseBool;
+	replicaSimulation->trackDatabaseResolution = simulation->trackDatabaseResolution;
+	replicaSimulation->trackAveragingBool = simulation->trackAveragingBool;
+	if (writeResultsBool == false) {
+		// Coarse propagator uses fixed time step explicit solver with large time step
+		replicaSimulation->explicitSolverType = 0;
+		replicaSimulation->explicitSolverFixedTimeStep = inputFileReader_SolverSettings->pararealCoarseTimeStep;
+	}
+	replicaSimulation->initialize(inputFileReader_ForcedSpeed, writeResultsBool);
+	return replicaSimulation;
+}
+
+
+void Parareal::propagateFine(int windowIndex) {
+	startStates[windowIndex]->restore(fineSimulations[windowIndex]);
+	fineSimulations[windowIndex]->resetResultsWriters();
+	fineTerminationConditions[windowIndex] = fineSimulations[windowIndex]->simulateImplicitSolverTimeSteps(numberOfImplicitSolverTimeStepsPerWindow);
+	fineStates[windowIndex]->capture(fineSimulations[windowIndex]);
+}
+
+
+int Parareal::propagateCoarse(SimulationState* startState, SimulationState* endState) {
+	startState->restore(coarseSimulation);
+	int tc = coarseSimulation->simulateImplicitSolverTimeSteps(numberOfImplicitSolverTimeStepsPerWindow);  // termination condition
+	endState->capture(coarseSimulation);
+	return tc;
+}
+
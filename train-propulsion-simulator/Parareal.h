@@ -0,0 +1,89 @@
+//////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+// This file is part of the TRAIN PROPULSION SIMULATOR repository available at github.com/lnaz01/train-propulsion-simulator //
+//////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+#ifndef PARAREAL_DEF
+#define PARAREAL_DEF
+
+#include <string>
+#include <vector>
+
+class InputFileReader_ForcedSpeed;
+class InputFileReader_Simulation;
+class InputFileReader_SolverSettings;
+class Simulation;
+class SimulationState;
+
+// Parareal time-parallel integration
+// (The simulated time is split into blocks of consecutive time windows.  For each block, a cheap coarse propagator 
+// (fixed time step explicit solver with large time step) predicts the state at the start of each window, the accurate 
+// fine propagator (user-defined explicit solver) integrates all windows concurrently, and the predictions are corrected 
+// sequentially until the window boundary states converge.)
+class Parareal {
+
+public:
+
+	// simulation						-->	Simulation (must be initialized)
+	// inputFileReader_SolverSettings	-->	Solver settings input file reader
+	Parareal(Simulation* simulation, InputFileReader_SolverSettings* inputFileReader_SolverSettings);
+
+	virtual ~Parareal();
+
+	// Simulates train dynamics (returns termination condition)
+	int simulate();
+
+private:
+
+	// Simulation
+	Simulation* simulation;
+
+	// Solver settings input file reader
+	InputFileReader_SolverSettings* inputFileReader_SolverSettings;
+
+	// Number of time windows per block
+	int numberOfWindows;
+
+	// Number of implicit solver time steps per time window
+	int numberOfImplicitSolverTimeStepsPerWindow;
+
+	// Simulation input file readers for fine propagators (one per time window) and coarse propagator (last element)
+	std::vector<InputFileReader_Simulation*> inputFileReaders_Simulation;
+
+	// Forced speed input file readers for fine propagators (one per time window) and coarse propagator (last element)
+	std::vector<InputFileReader_ForcedSpeed*> inputFileReaders_ForcedSpeed;
+
+	// Fine propagators (one per time window)
+	std::vector<Simulation*> fineSimulations;
+
+	// Coarse propagator
+	Simulation* coarseSimulation;
+
+	// Window start states
+	std::vector<SimulationState*> startStates;
+
+	// Fine propagator window end states
+	std::vector<SimulationState*> fineStates;
+
+	// Coarse propagator window end states
+	std::vector<SimulationState*> coarseStates;
+
+	// Fine propagator termination conditions
+	std::vector<int> fineTerminationConditions;
+
+	// Creates simulation from same input file as 'simulation'
+	// inputFileNameSuffix	-->	Suffix appended to input file name (used for output results file names)
+	// writeResultsBool		-->	Write results boolean
+	Simulation* createSimulation(std::string inputFileNameSuffix, bool writeResultsBool);
+
+	// Integrates time window with fine propagator
+	// windowIndex	-->	Time window index
+	void propagateFine(int windowIndex);
+
+	// Integrates time window with coarse propagator (returns termination condition)
+	// startState	-->	Window start state
+	// endState		-->	Window end state
+	int propagateCoarse(SimulationState* startState, SimulationState* endState);
+
+};
+
+#endif
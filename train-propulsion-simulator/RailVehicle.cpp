@@ -3,6 +3,7 @@
 //////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
 
 
+#include <limits>
 #include "RailVehicle.h"
 #include "BrakeCylinder.h"
 #include "Coupler.h"
@@ -10,6 +11,7 @@
 #include "Function.h"
 #include "InputFileReader_Simulation.h"
 #include "LocomotiveOperator.h"
+#include "SimulationState.h"
 #include "Track.h"
 #include "TrainConsist.h"
 #include "VectorRotator.h"
@@ -20,6 +22,15 @@ RailVehicle::RailVehicle(InputFileReader_Simulation* inputFileReader_Simulation,
 	ssv[0] = 0.0;
 	ssv[1] = 0.0;
 	resultsWriter = NULL;
+	for (int i = 0; i < Track::NUMBER_OF_PROPERTIES; i++) {
+		trackSegmentIndices[i] = 0;
+		trackProperties[i] = 0.0;
+	}
+	trackPropertiesPosition = std::numeric_limits<double>::max();
+	trackAveragingBool = false;
+	for (int i = 0; i < (2 * (Track::NUMBER_OF_PROPERTIES - 1)); i++) {
+		trackWindowSegmentIndices[i] = 0;
+	}
 	couplers.push_back(new Coupler(inputFileReader_Simulation));  // the first coupler (index 0) is the leading coupler
 	couplers.push_back(new Coupler(inputFileReader_Simulation));  // the second coupler (index 1) is the trailing coupler
 	globalVector_globalGravitationalForce = new double[3];
@@ -185,6 +196,21 @@ void RailVehicle::calc_lOverVMax() {
 }
 
 
+void RailVehicle::calc_trackForcesAndLOverV() {
+	calc_forceOnTrackDueToLeadingTruck();
+	calc_forceOnTrackDueToTrailingTruck();
+	calc_verticalForceRightSideLeadingTruck();
+	calc_verticalForceLeftSideLeadingTruck();
+	calc_verticalForceRightSideTrailingTruck();
+	calc_verticalForceLeftSideTrailingTruck();
+	calc_lOverVForRightSideOfLeadingTruck();
+	calc_lOverVForLeftSideOfLeadingTruck();
+	calc_lOverVForRightSideOfTrailingTruck();
+	calc_lOverVForLeftSideOfTrailingTruck();
+	calc_lOverVMax();
+}
+
+
 void RailVehicle::calc_brakePipeLength() {
 	brakePipeLength = length * BRAKE_PIPE_LENGTH_OVER_CAR_LENGTH;
 }
@@ -220,6 +246,7 @@ void RailVehicle::calc_sumExternalTangentialForces() {
 		propulsionResistance = -propulsionResistance;
 	}
 	// Curving resistance
+	calc_trackProperties();
 	/*
 	double curvingResistance = 0.0004 * UnitConverter::kg_To_Lb(mass) *
 		std::abs(UnitConverter::gCurv_To_TrkCurv(inputFileReader_Simulation->userDefinedTracks[0]->physicalVariables[1]->
@@ -227,8 +254,7 @@ void RailVehicle::calc_sumExternalTangentialForces() {
 	curvingResistance = UnitConverter::lb_To_N(curvingResistance);
 	*/
 	double curvingResistance = 0.0004 * mass * TrainConsist::GRAVITATIONAL_CONSTANT *
-		std::abs(UnitConverter::gCurv_To_TrkCurv(inputFileReader_Simulation->userDefinedTracks[0]->physicalVariables[1]->
-			interpolate(ssv[0], inputFileReader_Simulation->userDefinedTracks[0]->PVDMIN_SI[1], inputFileReader_Simulation->userDefinedTracks[0]->PVDMAX_SI[1])));
+		std::abs(UnitConverter::gCurv_To_TrkCurv(trackProperties[1]));
 	if (ssv[1] > 0.0) {
 		curvingResistance = -curvingResistance;
 	}
@@ -238,7 +264,21 @@ void RailVehicle::calc_sumExternalTangentialForces() {
 
 
 void RailVehicle::calc_theta() {
-	theta = inputFileReader_Simulation->userDefinedTracks[0]->angle(ssv[0]);
+	calc_trackProperties();
+	theta = trackProperties[3];
+}
+
+
+void RailVehicle::calc_trackProperties() {
+	if (trackPropertiesPosition != ssv[0]) {
+		if (trackAveragingBool == true) {
+			inputFileReader_Simulation->userDefinedTracks[0]->calc_averagedProperties(ssv[0], length, trackSegmentIndices, trackWindowSegmentIndices, trackProperties);
+		}
+		else {
+			inputFileReader_Simulation->userDefinedTracks[0]->calc_properties(ssv[0], trackSegmentIndices, trackProperties);
+		}
+		trackPropertiesPosition = ssv[0];
+	}
 }
 
 
@@ -255,19 +295,18 @@ void RailVehicle::calc_globalVector_globalGravitationalForce() {
 
 
 void RailVehicle::calcLocal3DVecFromGlobalGravitationalForce() {
+	calc_trackProperties();
 	// Rotation due to superelevation
-	double xrot = inputFileReader_Simulation->userDefinedTracks[0]->physicalVariables[2]->
-		interpolate(ssv[0], inputFileReader_Simulation->userDefinedTracks[0]->PVDMIN_SI[2], inputFileReader_Simulation->userDefinedTracks[0]->PVDMAX_SI[2]);
+	double xrot = trackProperties[2];
 	// Rotation due to profile (grade)
-	double yrot = inputFileReader_Simulation->userDefinedTracks[0]->physicalVariables[0]->
-		interpolate(ssv[0], inputFileReader_Simulation->userDefinedTracks[0]->PVDMIN_SI[0], inputFileReader_Simulation->userDefinedTracks[0]->PVDMAX_SI[0]);
+	double yrot = trackProperties[0];
 	vectorRotator_globalGravitationalForce->rotateVector(globalVector_globalGravitationalForce, xrot, yrot, 0.0);
 }
 
 
 void RailVehicle::calc_globalReactiveCentrifugalForce() {
-	globalReactiveCentrifugalForce = (mass * pow(ssv[1], 2.0)) * inputFileReader_Simulation->userDefinedTracks[0]->physicalVariables[1]->interpolate(ssv[0],
-		inputFileReader_Simulation->userDefinedTracks[0]->PVDMIN_SI[1], inputFileReader_Simulation->userDefinedTracks[0]->PVDMAX_SI[1]);
+	calc_trackProperties();
+	globalReactiveCentrifugalForce = (mass * pow(ssv[1], 2.0)) * trackProperties[1];
 }
 
 
@@ -279,9 +318,9 @@ void RailVehicle::calc_globalVector_globalReactiveCentrifugalForce() {
 
 
 void RailVehicle::calcLocal3DVecFromGlobalReactiveCentrifugalForce() {
+	calc_trackProperties();
 	// Rotation due to superelevation
-	double xrot = inputFileReader_Simulation->userDefinedTracks[0]->physicalVariables[2]->
-		interpolate(ssv[0], inputFileReader_Simulation->userDefinedTracks[0]->PVDMIN_SI[2], inputFileReader_Simulation->userDefinedTracks[0]->PVDMAX_SI[2]);
+	double xrot = trackProperties[2];
 	vectorRotator_globalReactiveCentrifugalForce->rotateVector(globalVector_globalReactiveCentrifugalForce, xrot, 0.0, 0.0);
 }
 
@@ -291,8 +330,7 @@ void RailVehicle::calc_tangentialForceDueToLeadingCoupler() {
 		tangentialForceDueToLeadingCoupler = 0.0;
 	}
 	else {
-		tangentialForceDueToLeadingCoupler = -inputFileReader_Simulation->userDefinedTrainConsists[0]->couplingSystems[positionInTrainConsist - 1]->totalForceOnLeadingRailVehicle *
-			cos(alpha_leadingRailVehicle);
+		calc_tangentialForceDueToLeadingCoupler(inputFileReader_Simulation->userDefinedTrainConsists[0]->couplingSystems[positionInTrainConsist - 1]->totalForceOnLeadingRailVehicle);
 	}
 }
 
@@ -302,12 +340,32 @@ void RailVehicle::calc_tangentialForceDueToTrailingCoupler() {
 		tangentialForceDueToTrailingCoupler = 0.0;
 	}
 	else {
-		tangentialForceDueToTrailingCoupler = inputFileReader_Simulation->userDefinedTrainConsists[0]->couplingSystems[positionInTrainConsist]->totalForceOnLeadingRailVehicle *
-			cos(alpha_trailingRailVehicle);
+		calc_tangentialForceDueToTrailingCoupler(inputFileReader_Simulation->userDefinedTrainConsists[0]->couplingSystems[positionInTrainConsist]->totalForceOnLeadingRailVehicle);
 	}
 }
 
 
+void RailVehicle::calc_tangentialForceDueToLeadingCoupler(double couplingSystemForce) {
+	tangentialForceDueToLeadingCoupler = -couplingSystemForce * cos(alpha_leadingRailVehicle);
+}
+
+
+void RailVehicle::calc_tangentialForceDueToTrailingCoupler(double couplingSystemForce) {
+	tangentialForceDueToTrailingCoupler = couplingSystemForce * cos(alpha_trailingRailVehicle);
+}
+
+
+void RailVehicle::calc_totalTangentialForce() {
+	totalTangentialForce = sumExternalTangentialForces + tangentialForceDueToLeadingCoupler + tangentialForceDueToTrailingCoupler + brakingForce + throttleForce;
+}
+
+
+void RailVehicle::calc_restingForces() {
+	restingDrivingForce = sumExternalTangentialForces + throttleForce;
+	restingHoldingForce = std::abs(brakingForce);
+}
+
+
 void RailVehicle::calc_lateralForceDueToLeadingCoupler() {
 	if (positionInTrainConsist == 0) {
 		lateralForceDueToLeadingCoupler = 0.0;
@@ -333,7 +391,8 @@ void RailVehicle::calc_alpha_leadingRailVehicle() {
 		alpha_leadingRailVehicle = 0.0;
 	}
 	else {
-		alpha_leadingRailVehicle = theta - inputFileReader_Simulation->userDefinedTrainConsists[0]->railVehicles[positionInTrainConsist - 1]->theta;
+		RailVehicle* lrv = inputFileReader_Simulation->userDefinedTrainConsists[0]->railVehicles[positionInTrainConsist - 1];  // leading rail vehicle
+		alpha_leadingRailVehicle = inputFileReader_Simulation->userDefinedTracks[0]->integratedCurvature(lrv->ssv[0], ssv[0], &lrv->trackSegmentIndices[3], &trackSegmentIndices[3]);
 	}
 }
 
@@ -343,7 +402,30 @@ void RailVehicle:: calc_alpha_trailingRailVehicle() {
 		alpha_trailingRailVehicle = 0.0;
 	}
 	else {
-		alpha_trailingRailVehicle = theta - inputFileReader_Simulation->userDefinedTrainConsists[0]->railVehicles[positionInTrainConsist + 1]->theta;
+		RailVehicle* trv = inputFileReader_Simulation->userDefinedTrainConsists[0]->railVehicles[positionInTrainConsist + 1];  // trailing rail vehicle
+		alpha_trailingRailVehicle = inputFileReader_Simulation->userDefinedTracks[0]->integratedCurvature(trv->ssv[0], ssv[0], &trv->trackSegmentIndices[3], &trackSegmentIndices[3]);
+	}
+}
+
+
+void RailVehicle::saveState(SimulationState* simulationState) {
+	ExplicitSSComponent::saveState(simulationState);
+	simulationState->append(brakePipeAirPressure, true);
+	simulationState->append(brakePipeAirVelocity, true);
+	simulationState->append(brakeCylinder->pressure, true);
+	for (size_t i = 0; i < couplers.size(); i++) {
+		simulationState->append(couplers[i]->displacement, true);
+	}
+}
+
+
+void RailVehicle::loadState(SimulationState* simulationState) {
+	ExplicitSSComponent::loadState(simulationState);
+	brakePipeAirPressure = simulationState->next();
+	brakePipeAirVelocity = simulationState->next();
+	brakeCylinder->pressure = simulationState->next();
+	for (size_t i = 0; i < couplers.size(); i++) {
+		couplers[i]->displacement = simulationState->next();
 	}
 }
 
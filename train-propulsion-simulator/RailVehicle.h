@@ -8,12 +8,14 @@
 #include <string>
 #include <vector>
 #include "ExplicitSSComponent.h"
+#include "Track.h"
 
 class BrakeCylinder;
 class ControlValve;
 class Coupler;
 class ResultsWriter;
 class Simulation;
+class SimulationState;
 class VectorRotator;
 
 class RailVehicle : public ExplicitSSComponent {
@@ -51,6 +53,23 @@ public:
 	// Position (index) in train consist
 	int positionInTrainConsist;
 
+	// Indices of grade, curvature, and superelevation function segments and heading table segment found at last track query of rail vehicle position
+	// (search hints for track queries, since rail vehicle position changes little from one query to the next)
+	size_t trackSegmentIndices[Track::NUMBER_OF_PROPERTIES];
+
+	// Track grade (radians), geometric curvature (meters^-1), superelevation (radians), and angle (radians) at rail vehicle position
+	double trackProperties[Track::NUMBER_OF_PROPERTIES];
+
+	// Rail vehicle position (meters) at which track properties were calculated
+	double trackPropertiesPosition;
+
+	// Track averaging boolean ('true' if track grade, curvature, and superelevation are averaged over rail vehicle length instead of taken at rail vehicle position)
+	bool trackAveragingBool;
+
+	// Indices of grade, curvature, and superelevation function segments found at last track query of rear end of rail vehicle, followed by indices found at
+	// last track query of front end of rail vehicle (search hints for averaged track queries)
+	size_t trackWindowSegmentIndices[2 * (Track::NUMBER_OF_PROPERTIES - 1)];
+
 	// Mass (kilograms)
 	double mass;
 
@@ -72,6 +91,15 @@ public:
 	// Lateral force due to trailing coupler
 	double lateralForceDueToTrailingCoupler;
 
+	// Total tangential force (sum of external, coupler, braking, and throttle tangential forces)
+	double totalTangentialForce;
+
+	// Tangential force tending to move rail vehicle at rest (sum of external tangential forces and throttle force)
+	double restingDrivingForce;
+
+	// Tangential force available to hold rail vehicle at rest (magnitude of braking force)
+	double restingHoldingForce;
+
 	// Initializes results writer
 	// simulation		-->	Simulation
 	virtual void initialize_resultsWriter(Simulation* simulation) = 0;
@@ -86,6 +114,10 @@ public:
 	// Braking force
 	virtual void calc_brakingForce() = 0;
 
+	void saveState(SimulationState* simulationState) override;
+
+	void loadState(SimulationState* simulationState) override;
+
 	void calc_ssvDot() override;
 
 	// Calculates brake pipe length
@@ -97,6 +129,10 @@ public:
 	// Calculates rotation on z axis
 	void calc_theta();
 
+	// Calculates track properties at rail vehicle position, or averaged over rail vehicle length if track averaging is used
+	// (track is queried only if rail vehicle position changed since last calculation)
+	void calc_trackProperties();
+
 	// Calculates global gravitational force
 	void calc_globalGravitationalForce();
 
@@ -124,6 +160,20 @@ public:
 	// Calculates tangential force due to trailing coupler
 	void calc_tangentialForceDueToTrailingCoupler();
 
+	// Calculates tangential force due to leading coupler from given force of leading coupling system
+	// couplingSystemForce	-->	Total force of leading coupling system on its leading rail vehicle (newtons)
+	void calc_tangentialForceDueToLeadingCoupler(double couplingSystemForce);
+
+	// Calculates tangential force due to trailing coupler from given force of trailing coupling system
+	// couplingSystemForce	-->	Total force of trailing coupling system on its leading rail vehicle (newtons)
+	void calc_tangentialForceDueToTrailingCoupler(double couplingSystemForce);
+
+	// Calculates total tangential force
+	void calc_totalTangentialForce();
+
+	// Calculates tangential forces tending to move and available to hold rail vehicle at rest
+	void calc_restingForces();
+
 	// Calculates lateral force due to leading coupler
 	void calc_lateralForceDueToLeadingCoupler();
 
@@ -175,6 +225,10 @@ public:
 	// Calculates maximum L/V ratio
 	void calc_lOverVMax();
 
+	// Calculates forces applied on track by leading and trailing trucks, vertical force applied by each side of each truck, and L/V ratios (these do not
+	// affect train consist dynamics, so they are only calculated when results of rail vehicle are written)
+	void calc_trackForcesAndLOverV();
+
 	// Calculates angle with respect to leading rail vehicle (radians)
 	void calc_alpha_leadingRailVehicle();
 
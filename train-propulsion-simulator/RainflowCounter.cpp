@@ -0,0 +1,100 @@
+//////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+// This file is part of the TRAIN PROPULSION SIMULATOR repository available at github.com/lnaz01/train-propulsion-simulator //
+//////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+
+#include <cmath>
+#include "RainflowCounter.h"
+#include "SimulationState.h"
+
+
+RainflowCounter::RainflowCounter(int numberOfBins, double binWidth, double damageExponent, double damageCoefficient) {
+	this->numberOfBins = numberOfBins;
+	this->binWidth = binWidth;
+	this->damageExponent = damageExponent;
+	this->damageCoefficient = damageCoefficient;
+	cycles.assign(numberOfBins, 0.0);
+	damage = 0.0;
+	fullCycles.assign(numberOfBins, 0.0);
+	fullCycleDamage = 0.0;
+}
+
+
+RainflowCounter::~RainflowCounter() {}
+
+
+void RainflowCounter::add(double value) {
+	size_t n = reversals.size();
+	if (n == 0) {
+		reversals.push_back(value);
+		return;
+	}
+	if (value == reversals[n - 1]) {
+		return;
+	}
+	// Latest value continues in same direction (latest value is not reversal)
+	if ((n >= 2) && (((reversals[n - 1] - reversals[n - 2]) * (value - reversals[n - 1])) > 0.0)) {
+		reversals[n - 1] = value;
+		return;
+	}
+	// Latest value is reversal
+	reversals.push_back(value);
+	// Four-point rule on reversals (excluding new latest value)
+	while (reversals.size() >= 5) {
+		size_t k = reversals.size() - 1;  // number of reversals excluding latest value
+		double r0 = std::abs(reversals[k - 3] - reversals[k - 4]);  // range of first pair
+		double r1 = std::abs(reversals[k - 2] - reversals[k - 3]);  // range of inner pair
+		double r2 = std::abs(reversals[k - 1] - reversals[k - 2]);  // range of last pair
+		if ((r1 > r0) || (r1 > r2)) {
+			break;
+		}
+		addCycles(r1, 1.0, &fullCycles, &fullCycleDamage);
+		reversals.erase(reversals.begin() + (k - 3), reversals.begin() + (k - 1));
+	}
+}
+
+
+void RainflowCounter::calc_cycles() {
+	cycles = fullCycles;
+	damage = fullCycleDamage;
+	for (size_t i = 1; i < reversals.size(); i++) {
+		addCycles(std::abs(reversals[i] - reversals[i - 1]), 0.5, &cycles, &damage);
+	}
+}
+
+
+void RainflowCounter::saveState(SimulationState* simulationState) {
+	for (int i = 0; i < numberOfBins; i++) {
+		simulationState->append(fullCycles[i], false);
+	}
+	simulationState->append(fullCycleDamage, false);
+	simulationState->append((double)reversals.size(), false);
+	for (size_t i = 0; i < reversals.size(); i++) {
+		simulationState->append(reversals[i], false);
+	}
+}
+
+
+void RainflowCounter::loadState(SimulationState* simulationState) {
+	for (int i = 0; i < numberOfBins; i++) {
+		fullCycles[i] = simulationState->next();
+	}
+	fullCycleDamage = simulationState->next();
+	reversals.resize((size_t)simulationState->next());
+	for (size_t i = 0; i < reversals.size(); i++) {
+		reversals[i] = simulationState->next();
+	}
+}
+
+
+void RainflowCounter::addCycles(double range, double count, std::vector<double>* binCycles, double* damageSum) {
+	int bi = (int)(range / binWidth);  // bin index
+	if (bi >= numberOfBins) {
+		bi = numberOfBins - 1;
+	}
+	(*binCycles)[bi] = (*binCycles)[bi] + count;
+	if (damageExponent > 0.0) {
+		*damageSum = *damageSum + (count * pow(range, damageExponent) / damageCoefficient);
+	}
+}
+
@@ -0,0 +1,82 @@
+//////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+// This file is part of the TRAIN PROPULSION SIMULATOR repository available at github.com/lnaz01/train-propulsion-simulator //
+//////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+#ifndef RAINFLOW_COUNTER_DEF
+#define RAINFLOW_COUNTER_DEF
+
+#include <vector>
+
+class SimulationState;
+
+// Streaming rainflow cycle counter
+// (Reversals of the history are kept on a stack, and a full cycle is counted with the four-point rule as soon as the range of
+// the two inner reversals of the last four reversals is no larger than the ranges of the two outer pairs.  Reversals left on
+// the stack (residue) are counted as half cycles when the cycle histogram is calculated, so only the stack and the histogram
+// of full cycles are kept in memory.)
+class RainflowCounter {
+
+public:
+
+	// numberOfBins		-->	Number of cycle range bins (last bin also counts cycles with larger ranges)
+	// binWidth			-->	Width of cycle range bins
+	// damageExponent	-->	Exponent 'm' of S-N curve N = C / S^m ('0' for no damage sum)
+	// damageCoefficient	-->	Coefficient 'C' of S-N curve N = C / S^m
+	RainflowCounter(int numberOfBins, double binWidth, double damageExponent, double damageCoefficient);
+
+	virtual ~RainflowCounter();
+
+	// Number of cycle range bins
+	int numberOfBins;
+
+	// Width of cycle range bins
+	double binWidth;
+
+	// Exponent of S-N curve
+	double damageExponent;
+
+	// Coefficient of S-N curve
+	double damageCoefficient;
+
+	// Number of cycles in each cycle range bin (full cycles and half cycles of residue)
+	std::vector<double> cycles;
+
+	// Miner's rule damage sum (full cycles and half cycles of residue)
+	double damage;
+
+	// Adds next value of history
+	// value	-->	Value
+	void add(double value);
+
+	// Calculates cycles and damage sum (residue is counted as half cycles, but remains on stack so that counting may continue)
+	void calc_cycles();
+
+	// Saves state (reversal stack and full cycles)
+	// simulationState		-->	Simulation state
+	void saveState(SimulationState* simulationState);
+
+	// Loads state (reversal stack and full cycles)
+	// simulationState		-->	Simulation state
+	void loadState(SimulationState* simulationState);
+
+private:
+
+	// Reversals not yet paired into full cycles (last entry is latest value, which is not yet known to be reversal)
+	std::vector<double> reversals;
+
+	// Number of full cycles in each cycle range bin
+	std::vector<double> fullCycles;
+
+	// Miner's rule damage sum of full cycles
+	double fullCycleDamage;
+
+	// Adds cycles of given range to cycle range bins and damage sum
+	// range		-->	Cycle range
+	// count		-->	Number of cycles ('1' for full cycle, '0.5' for half cycle)
+	// binCycles	-->	Number of cycles in each cycle range bin
+	// damageSum	-->	Damage sum
+	void addCycles(double range, double count, std::vector<double>* binCycles, double* damageSum);
+
+};
+
+#endif
@@ -3,6 +3,7 @@
 //////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
 
 
+#include <fstream>
 #include <string>
 #include "ResultsWriter.h"
 #include "Point.h"
@@ -10,6 +11,7 @@
 
 ResultsWriter::ResultsWriter(std::string fp, bool appnd) {
 	this->fp = fp;
+	checkpointsBool = false;
 	ofs = new std::ofstream;
 	if (appnd == false) {
 		// Remove file with file path 'fp' if it already exists
@@ -39,9 +41,30 @@ ResultsWriter::~ResultsWriter() {
 }
 
 
+void ResultsWriter::checkpoint() {
+	if (checkpointsBool == true) {
+		*ofs << uncheckpointedResults.str();
+		uncheckpointedResults.str("");
+	}
+	ofs->flush();
+	checkpointsBool = true;
+}
+
+
+void ResultsWriter::rollBack() {
+	uncheckpointedResults.str("");
+	uncheckpointedResults.clear();
+}
+
+
 void ResultsWriter::writePoints(Point* points, int pointsSize) {
 	for (int i = 0; i < pointsSize; i++) {
 		*ofs << points[i].x << "," << points[i].y << std::endl;
 	}
 }
 
+
+void ResultsWriter::writePoint(double x, double y) {
+	*ofs << x << "," << y << "\n";
+}
+
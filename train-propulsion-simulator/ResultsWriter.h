@@ -6,6 +6,7 @@
 #define RESULTS_WRITER_DEF
 
 #include <fstream>
+#include <sstream>
 #include <string>
 #include <vector>
 
@@ -27,6 +28,18 @@ public:
 	// Output file stream
 	std::ofstream* ofs;
 
+	// Checkpoints used boolean ('true' after first checkpoint, from which point results are held in memory until next checkpoint)
+	bool checkpointsBool;
+
+	// Results written since last checkpoint (not yet written to output file stream)
+	std::ostringstream uncheckpointedResults;
+
+	// Writes results held since last checkpoint to output file stream, and holds following results in memory until next checkpoint
+	void checkpoint();
+
+	// Discards results written after last checkpoint (results held in memory are dropped, so file is never rewritten)
+	void rollBack();
+
 	// Write data vector to single line
 	template <typename T>
 	void writeLine(std::vector<T> d);
@@ -36,19 +49,25 @@ public:
 	// pointsSize	--> Size of array of points
 	void writePoints(Point* points, int pointsSize);
 
+	// Writes single point to single line (without flushing output file stream, so that many points can be written in sequence)
+	// x	-->	Independent variable value
+	// y	-->	Dependent variable value
+	void writePoint(double x, double y);
+
 };
 
 // Writes data vector to single line
 // d	-->	Data
 template <typename T>
 void ResultsWriter::writeLine(std::vector<T> d) {
+	std::ostream& os = (checkpointsBool == true) ? (std::ostream&)uncheckpointedResults : (std::ostream&)*ofs;  // output stream
 	for (size_t i = 0; i < d.size(); i++) {
-		*ofs << d[i];
+		os << d[i];
 		if (i == (d.size() - 1)) {
-			*ofs << std::endl;
+			os << std::endl;
 		}
 		else {
-			*ofs << ",";
+			os << ",";
 		}
 	}
 }
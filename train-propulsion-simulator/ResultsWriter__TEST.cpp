@@ -3,6 +3,7 @@
 //////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
 
 
+#include <fstream>
 #include <string>
 #include <iostream>
 #include "ResultsWriter.h"
@@ -12,6 +13,7 @@
 void writeLine__TEST1(ResultsWriter* resultsWriter);
 void writeLine__TEST2(ResultsWriter* resultsWriter);
 void writePoints__TEST(ResultsWriter* resultsWriter);
+void checkpoint__TEST(std::string filePath);
 
 
 int main() {
@@ -31,6 +33,8 @@ int main() {
 	myWriter->ofs->close();
 	// Delete results writer
 	delete myWriter;
+	// Test discarding results written after checkpoint
+	checkpoint__TEST("C:/Users/Leith/Desktop/myCheckpointTestFile.csv");
 
 }
 
@@ -66,3 +70,27 @@ void writePoints__TEST(ResultsWriter* resultsWriter) {
 	delete[] points;
 }
 
+
+void checkpoint__TEST(std::string filePath) {
+	ResultsWriter* resultsWriter = new ResultsWriter(filePath, false);
+	resultsWriter->writeLine(std::vector<double>{ 1.0, 10.0 });
+	resultsWriter->checkpoint();
+	resultsWriter->writeLine(std::vector<double>{ 2.0, 20.0 });
+	resultsWriter->writeLine(std::vector<double>{ 3.0, 30.0 });
+	// Lines written after checkpoint are discarded
+	resultsWriter->rollBack();
+	resultsWriter->writeLine(std::vector<double>{ 2.0, 21.0 });
+	resultsWriter->checkpoint();
+	resultsWriter->ofs->flush();
+	resultsWriter->ofs->close();
+	delete resultsWriter;
+	// File should hold lines '1,10' and '2,21'
+	std::cout << "checkpoint__TEST" << std::endl;
+	std::ifstream ifs(filePath);
+	std::string line;
+	while (std::getline(ifs, line)) {
+		std::cout << line << std::endl;
+	}
+	ifs.close();
+}
+
@@ -11,7 +11,6 @@
 #include "InputFileReader_Function.h"
 #include "InputFileReader_Simulation.h"
 #include "Locomotive.h"
-#include "Point.h"
 #include "ResultsWriter.h"
 #include "Track.h"
 
@@ -134,16 +133,8 @@ Session_Function::Session_Function() {
 	// Print results
 	std::string outputFilePath = inputFileReader_Function->inputFileDirectoryPath + "/" + FILE_NAME + ".csv";
 	resultsWriter = new ResultsWriter(outputFilePath, false);
-	inputFileReader_Function->userDefinedRailroadComponent->physicalVariables[fni]->interpolateMult(inputFileReader_Function->userDefinedRailroadComponent->PVDMIN_US[fni],
-		inputFileReader_Function->userDefinedRailroadComponent->PVDMAX_US[fni]);
-	double** d = inputFileReader_Function->userDefinedRailroadComponent->physicalVariables[fni]->interpPoints;
-	int dSize1 = inputFileReader_Function->userDefinedRailroadComponent->physicalVariables[fni]->numInterpPointsPlot;
-	Point* points = new Point[dSize1];
-	for (int i = 0; i < dSize1; i++) {
-		points[i].x = d[i][0];
-		points[i].y = d[i][1];
-	}
-	resultsWriter->writePoints(points, dSize1);
+	inputFileReader_Function->userDefinedRailroadComponent->physicalVariables[fni]->sample(inputFileReader_Function->userDefinedRailroadComponent->PVDMIN_US[fni],
+		inputFileReader_Function->userDefinedRailroadComponent->PVDMAX_US[fni], SAMPLING_TOLERANCE, resultsWriter);
 	resultsWriter->ofs->flush();
 	resultsWriter->ofs->close();
 	// Message user
@@ -152,8 +143,6 @@ Session_Function::Session_Function() {
 	std::cout << "Press 'Enter' to end program." << std::endl;
 	std::cin.ignore();
 	exit(EXIT_SUCCESS);
-	// Delete allocated memory
-	delete[] points;
 }
 
 
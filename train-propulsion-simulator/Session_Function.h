@@ -49,6 +49,9 @@ private:
 	// Output file name
 	const std::string FILE_NAME = "function";
 
+	// Maximum deviation of plotted polyline from function, relative to range of dependent variable values of function points
+	const double SAMPLING_TOLERANCE = 0.001;
+
 	// Version number
 	const std::string BUILD_ID = "1.01.01";
 
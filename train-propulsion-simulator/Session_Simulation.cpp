@@ -7,6 +7,7 @@
 #include "Session_Simulation.h"
 #include "InputFileReader_ForcedSpeed.h"
 #include "InputFileReader_Simulation.h"
+#include "InputFileReader_SolverSettings.h"
 #include "Simulation.h"
 #include "Track.h"
 
@@ -58,8 +59,20 @@ Session_Simulation::Session_Simulation() {
 			exit(EXIT_SUCCESS);
 		}
 	}
+	// Load solver settings file parameters
+	inputFileReader_SolverSettings = new InputFileReader_SolverSettings(inputFileReader_Simulation);
+	if (inputFileReader_SolverSettings->inputFileExistsBool == true) {
+		std::string ssval = inputFileReader_SolverSettings->load();
+		if (ssval.compare(InputFileReader::VALID_INPUT_STRING) != 0) {
+			std::cout << "Error on line " << inputFileReader_SolverSettings->currentLineNumber << " of solver settings file: " << ssval << std::endl;
+			std::cout << std::endl;
+			std::cout << "Press 'Enter' to end program." << std::endl;
+			std::cin.ignore();
+			exit(EXIT_SUCCESS);
+		}
+	}
 	// Run simulation
-	inputFileReader_Simulation->userDefinedSimulations[0]->simulate(inputFileReader_ForcedSpeed);
+	inputFileReader_Simulation->userDefinedSimulations[0]->simulate(inputFileReader_ForcedSpeed, inputFileReader_SolverSettings);
 	std::cin.ignore();
 	exit(EXIT_SUCCESS);
 }
@@ -68,5 +81,6 @@ Session_Simulation::Session_Simulation() {
 Session_Simulation::~Session_Simulation() {
 	delete inputFileReader_Simulation;
 	delete inputFileReader_ForcedSpeed;
+	delete inputFileReader_SolverSettings;
 }
 
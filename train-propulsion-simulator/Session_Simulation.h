@@ -9,6 +9,7 @@
 
 class InputFileReader_ForcedSpeed;
 class InputFileReader_Simulation;
+class InputFileReader_SolverSettings;
 
 class Session_Simulation {
 
@@ -26,6 +27,9 @@ private:
 	// Forced speed input file reader
 	InputFileReader_ForcedSpeed* inputFileReader_ForcedSpeed;
 
+	// Solver settings input file reader
+	InputFileReader_SolverSettings* inputFileReader_SolverSettings;
+
 	// Version number
 	const std::string buildID = "1.01.01";
 
@@ -3,31 +3,58 @@
 //////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
 
 
+#include <algorithm>
+#include <cmath>
+#include <fstream>
 #include <iostream>
+#include <limits>
+#include <string>
+#include <vector>
 #include "Simulation.h"
 #include "AuxiliaryReservoir.h"
 #include "BrakeCylinder.h"
 #include "BrakePipe_Cumulative.h"
 #include "BrakePipe_FiniteElement.h"
+#include "Calibration.h"
 #include "Car.h"
 #include "ControlValve_Car.h"
 #include "Coupler.h"
 #include "CouplingSystem.h"
+#include "CouplingSystemBatch.h"
+#include "DomainDecomposition.h"
 #include "EmergencyReservoir.h"
 #include "EndOfTrainDevice.h"
 #include "Function.h"
 #include "InputFileReader_ForcedSpeed.h"
+#include "InputFileReader_Route.h"
 #include "InputFileReader_Simulation.h"
+#include "InputFileReader_SolverSettings.h"
 #include "Interval.h"
 #include "LinearSystem.h"
 #include "Locomotive.h"
+#include "LocomotiveEventLog.h"
 #include "LocomotiveOperator.h"
+#include "Parareal.h"
 #include "Point.h"
+#include "RainflowCounter.h"
 #include "ResultsWriter.h"
+#include "SimulationState.h"
 #include "Track.h"
+#include "TrackDatabase.h"
+#include "TrackRoute.h"
 #include "TrainConsist.h"
 
 
+// Termination conditions (defined out of class, since they are bound to references, such as by 'push_back')
+constexpr int Simulation::TC_NONE;
+constexpr int Simulation::TC_TIME_STEP_TOO_SMALL;
+constexpr int Simulation::TC_EXCESSIVE_COUPLER_DISPLACEMENT;
+constexpr int Simulation::TC_END_OF_TRACK;
+constexpr int Simulation::TC_TRAIN_CONSIST_NOT_MOVING;
+constexpr int Simulation::TC_MAXIMUM_SPEED_EXCEEDED;
+constexpr int Simulation::TC_MAXIMUM_SIMULATED_SECONDS;
+
+
 Simulation::Simulation(InputFileReader_Simulation* inputFileReader_Simulation) : UserDefinedRRComponent(inputFileReader_Simulation, 20, 0) {
 	componentType = 6;
 	for (int i = 0; i < physicalVariablesSize; i++) {
@@ -58,7 +85,34 @@ Simulation::Simulation(InputFileReader_Simulation* inputFileReader_Simulation) :
 	START_UDRRC_STRING = "Simulation_";
 	END_UDRRC_STRING = "_Simulation";
 	railVehiclesToSaveCreatedBool = false;
+	resultsWritersCreatedBool = false;
 	explicitSolverNumSteps = 0;
+	explicitSolverFixedTimeStep = EXPLICIT_SOLVER_FIXED_TIME_STEP;
+	explicitSolverMaxErrorThreshold = EXPLICIT_SOLVER_MAX_ERROR_THRESHOLD;
+	explicitSolverMinTimeStep = EXPLICIT_SOLVER_MIN_TIME_STEP;
+	explicitSolverMaxTimeStep = EXPLICIT_SOLVER_MAX_TIME_STEP;
+	brakePipeFiniteElementSize = BrakePipe_FiniteElement::MAX_RAIL_VEHICLES_PER_BRAKE_PIPE_FE;
+	printProgressBool = true;
+	quasiStaticSteppingBool = false;
+	quasiStaticVelocityTolerance = UnitConverter::miph_To_Mps(0.01);
+	quasiStaticAccelerationTolerance = UnitConverter::miph_To_Mps(0.01);
+	quasiStaticSettlingTime = 5.0;
+	stoppedTrainFastForwardBool = false;
+	checkpointInterval = 0.0;
+	checkpointMaximumRetries = 0;
+	rainflowNumberOfBins = 0;
+	rainflowBinWidth = 5000.0;
+	rainflowDamageExponent = 0.0;
+	rainflowDamageCoefficient = 1.0;
+	trackTableResolution = 0.0;
+	trackTableMaxMemory = 256.0 * 1024.0 * 1024.0;
+	trackDatabaseBool = false;
+	trackDatabaseResolution = UnitConverter::ft_To_M(1.0);
+	trackAveragingBool = false;
+	inputFileReader_ForcedSpeed = NULL;
+	inputFileReader_SolverSettings = NULL;
+	domainDecomposition = NULL;
+	checkpointState = NULL;
 	// Physical constants US units
 	// Indices 0-19		--> Rail vehicle numbers (position in train consist)
 	for (int i = 0; i < physicalConstantsSize; i++) {
@@ -98,30 +152,120 @@ Simulation::~Simulation() {
 	if (railVehiclesToSaveCreatedBool == true) {
 		delete[] railVehiclesToSave;
 	}
-	delete resultsWriter_BrakePipes;
-	delete resultsWriter_CouplerForces;
-	delete resultsWriter_CouplerDisplacements;
+	if (resultsWritersCreatedBool == true) {
+		deleteResultsWriters();
+	}
+	if (domainDecomposition != NULL) {
+		delete domainDecomposition;
+	}
+	if (checkpointState != NULL) {
+		delete checkpointState;
+	}
+	deleteRainflowCounters();
 }
 
 
-void Simulation::simulate(InputFileReader_ForcedSpeed* inputFileReader_ForcedSpeed) {
+void Simulation::simulate(InputFileReader_ForcedSpeed* inputFileReader_ForcedSpeed, InputFileReader_SolverSettings* inputFileReader_SolverSettings) {
 	std::cout << "Simulation running..." << std::endl;
 	std::cout << std::endl;
+	this->inputFileReader_SolverSettings = inputFileReader_SolverSettings;
+	quasiStaticSteppingBool = inputFileReader_SolverSettings->quasiStaticSteppingBool;
+	quasiStaticVelocityTolerance = UnitConverter::miph_To_Mps(inputFileReader_SolverSettings->quasiStaticVelocityTolerance);
+	quasiStaticAccelerationTolerance = UnitConverter::miph_To_Mps(inputFileReader_SolverSettings->quasiStaticAccelerationTolerance);
+	quasiStaticSettlingTime = inputFileReader_SolverSettings->quasiStaticSettlingTime;
+	rainflowNumberOfBins = inputFileReader_SolverSettings->rainflowNumberOfBins;
+	rainflowBinWidth = inputFileReader_SolverSettings->rainflowBinWidth;
+	rainflowDamageExponent = inputFileReader_SolverSettings->rainflowDamageExponent;
+	rainflowDamageCoefficient = inputFileReader_SolverSettings->rainflowDamageCoefficient;
+	trackTableResolution = UnitConverter::ft_To_M(inputFileReader_SolverSettings->trackTableResolution);
+	trackTableMaxMemory = inputFileReader_SolverSettings->trackTableMaxMemory * 1024.0 * 1024.0;
+	trackDatabaseBool = inputFileReader_SolverSettings->trackDatabaseBool;
+	trackDatabaseResolution = UnitConverter::ft_To_M(inputFileReader_SolverSettings->trackDatabaseResolution);
+	trackAveragingBool = inputFileReader_SolverSettings->trackAveragingBool;
+	// Calibrate explicit solver and brake pipe finite element size on prefix of simulation (before brake pipe finite elements are created)
+	if (inputFileReader_SolverSettings->calibrationBool == true) {
+		Calibration* calibration = new Calibration(this, inputFileReader_SolverSettings);
+		calibration->calibrate();
+		delete calibration;
+	}
+	// Initialize simulation and output results file writers
+	initialize(inputFileReader_ForcedSpeed, true);
+	// Simulation loop
+	int tc = TC_NONE;  // termination condition
+	if (inputFileReader_SolverSettings->pararealNumberOfWindows > 1) {
+		Parareal* parareal = new Parareal(this, inputFileReader_SolverSettings);
+		tc = parareal->simulate();
+		delete parareal;
+	}
+	else {
+		// Fast-forward through stopped periods (only for sequential integration, since fast-forward skips many implicit solver time steps at once)
+		stoppedTrainFastForwardBool = inputFileReader_SolverSettings->stoppedTrainFastForwardBool;
+		if (inputFileReader_SolverSettings->domainDecompositionNumberOfBlocks > 1) {
+			domainDecomposition = new DomainDecomposition(this, inputFileReader_SolverSettings);
+		}
+		// Roll back to rolling checkpoint and retry on numerical instability (only for sequential integration)
+		checkpointInterval = inputFileReader_SolverSettings->checkpointInterval;
+		checkpointMaximumRetries = inputFileReader_SolverSettings->checkpointMaximumRetries;
+		if (checkpointInterval > 0.0) {
+			checkpointState = new SimulationState();
+			checkpointRetries = 0;
+			checkpointInstabilityTime = 0.0;
+			checkpointExplicitSolverFixedTimeStep = explicitSolverFixedTimeStep;
+			checkpointExplicitSolverMaxErrorThreshold = explicitSolverMaxErrorThreshold;
+			checkpointExplicitSolverMinTimeStep = explicitSolverMinTimeStep;
+			checkpointExplicitSolverMaxTimeStep = explicitSolverMaxTimeStep;
+			checkpointTime = -checkpointInterval;
+			updateCheckpoint();
+		}
+		do {
+			tc = implicitSolverIntegrationStep();
+			if (checkpointState != NULL) {
+				tc = rollBackToCheckpoint(tc);
+				if (tc == TC_NONE) {
+					updateCheckpoint();
+				}
+			}
+		} while (tc == TC_NONE);
+		if (domainDecomposition != NULL) {
+			if ((domainDecomposition->numberOfUnconvergedTimeSteps > 0) && (printProgressBool == true)) {
+				std::cout << "Interface forces of domain decomposition did not converge for " << domainDecomposition->numberOfUnconvergedTimeSteps << " explicit solver time steps";
+				if (explicitSolverType == 1) {
+					std::cout << " (time steps were rejected and retried with smaller time step)." << std::endl;
+				}
+				else {
+					std::cout << " (time steps were repeated with interface forces exchanged at every algorithm step)." << std::endl;
+				}
+				std::cout << std::endl;
+			}
+			delete domainDecomposition;
+			domainDecomposition = NULL;
+		}
+	}
+	// Close result writers and print message to console explaining why simulation was terminated
+	terminate(tc);
+}
+
+
+void Simulation::initialize(InputFileReader_ForcedSpeed* inputFileReader_ForcedSpeed, bool writeResultsBool) {
+	this->inputFileReader_ForcedSpeed = inputFileReader_ForcedSpeed;
+	this->writeResultsBool = writeResultsBool;
 	calc_explicitSolverNumSteps();
 	explicitSolverStepIndex = 0;
 	explicitSolverTime = 0.0;
-	explicitSolverTimeStep = EXPLICIT_SOLVER_FIXED_TIME_STEP;
+	explicitSolverTimeStep = explicitSolverFixedTimeStep;
 	implicitSolverTime = 0.0;
 	velocityApproxZeroBool = false;
 	startTimeVelocityApproxZero = 2.0 * MAX_NUMBER_OF_SIMULATED_SECONDS;
-	double implicitSolverTimeOfPreviousProgressUpdate = implicitSolverTime;
-	double explicitSolverTimeLastWrittenResults = explicitSolverTime;
-	bool headerLabelsWrittenBool = false;  // header labels written boolean
-	bool numericalInstabilityBool = false;  // numerical instability boolean
-	bool excessiveCouplerDisplacementBool = false;  // excessive coupler displacement boolean
-	bool consistInsideTrackBoundariesBool = true;  // consist inside track boundaries boolean
-	bool consistMovingForwardBool = true;  // consist moving forward boolean
-	bool trainSpeedUnderMaxSpeedBool = true;  // train speed under maximum allowable speed boolean
+	implicitSolverTimeOfPreviousProgressUpdate = implicitSolverTime;
+	explicitSolverTimeLastWrittenResults = explicitSolverTime;
+	headerLabelsWrittenBool = false;
+	firstImplicitStepBool = true;
+	quasiStaticBool = false;
+	quasiStaticSteadyTime = 0.0;
+	stoppedTrainBool = false;
+	stoppedTrainTime = 0.0;
+	stoppedTrainPneumaticsSettledBool = false;
+	stoppedTrainPreviousPressures.clear();
 	// Calculate rail vehicle types for train consist
 	inputFileReader_Simulation->userDefinedTrainConsists[0]->calc_railVehicleTypes();
 	// Calculate vector of cumulative brake pipes for train consist
@@ -132,7 +276,7 @@ void Simulation::simulate(InputFileReader_ForcedSpeed* inputFileReader_ForcedSpe
 	}
 	// Calculate vector of brake pipe finite elements for each cumulative brake pipe
 	for (size_t i = 0; i < inputFileReader_Simulation->userDefinedTrainConsists[0]->brakePipes_Cumulative.size(); i++) {
-		inputFileReader_Simulation->userDefinedTrainConsists[0]->brakePipes_Cumulative[i]->calc_brakePipe_FiniteElements();
+		inputFileReader_Simulation->userDefinedTrainConsists[0]->brakePipes_Cumulative[i]->calc_brakePipe_FiniteElements(brakePipeFiniteElementSize);
 	}
 	// Initialize system matrix and forcing vector for cumulative brake pipes
 	for (size_t i = 0; i < inputFileReader_Simulation->userDefinedTrainConsists[0]->brakePipes_Cumulative.size(); i++) {
@@ -164,6 +308,25 @@ void Simulation::simulate(InputFileReader_ForcedSpeed* inputFileReader_ForcedSpe
 	convertToSI();
 	// Calculate track length
 	inputFileReader_Simulation->userDefinedTracks[0]->calc_trackLength();
+	// Replace locomotive operator functions by recorded operator settings (if locomotive event log file exists for locomotive)
+	for (size_t i = 0; i < inputFileReader_Simulation->userDefinedTrainConsists[0]->locomotives.size(); i++) {
+		std::string lelfp = calc_companionFilePath("_locomotive_" + std::to_string(i + 1) + ".tel");  // locomotive event log file path
+		std::ifstream lelifs(lelfp);
+		if (lelifs.good() == false) {
+			continue;
+		}
+		lelifs.close();
+		LocomotiveEventLog locomotiveEventLog(lelfp);
+		std::string lelstr = locomotiveEventLog.load(inputFileReader_Simulation->userDefinedTrainConsists[0]->locomotives[i]->locomotiveOperator);  // locomotive event log validation string
+		if (lelstr.compare(InputFileReader::VALID_INPUT_STRING) == 0) {
+			locomotiveEventLog.attach(inputFileReader_Simulation->userDefinedTrainConsists[0]->locomotives[i]->locomotiveOperator);
+		}
+		else if (printProgressBool == true) {
+			// (Message is printed once, not by every parareal replica)
+			std::cout << lelstr << "  Locomotive operator functions are used." << std::endl;
+			std::cout << std::endl;
+		}
+	}
 	// Calculate air viscosity
 	inputFileReader_Simulation->userDefinedTrainConsists[0]->calc_airViscosity();
 	// Calculate brake rigging leverage ratios
@@ -227,8 +390,70 @@ void Simulation::simulate(InputFileReader_ForcedSpeed* inputFileReader_ForcedSpe
 			inputFileReader_Simulation->userDefinedTrainConsists[0]->brakePipes_Cumulative[i]->brakePipe_FiniteElements[j]->calculateBrakePipePressureForRailVehicles();
 		}
 	}
+	// Attach route assembled from track segment library (if route file exists)
+	bool trackRouteBool = false;  // track route attached boolean
+	InputFileReader_Route* inputFileReader_Route = new InputFileReader_Route(inputFileReader_Simulation);
+	if (inputFileReader_Route->inputFileExistsBool == true) {
+		std::string trstr = inputFileReader_Route->load();  // track route validation string
+		TrackRoute* trackRoute = new TrackRoute();
+		if (trstr.compare(InputFileReader::VALID_INPUT_STRING) == 0) {
+			inputFileReader_Route->convertToSI();
+			trstr = trackRoute->load(inputFileReader_Route);
+		}
+		if (trstr.compare(InputFileReader::VALID_INPUT_STRING) == 0) {
+			inputFileReader_Simulation->userDefinedTracks[0]->attach_route(trackRoute);
+			trackRouteBool = true;
+		}
+		else {
+			delete trackRoute;
+			std::cout << trstr << "  Track functions are used." << std::endl;
+			std::cout << std::endl;
+		}
+	}
+	delete inputFileReader_Route;
+	// Attach binary track database (converted from track functions if database file does not exist yet, or if it was converted from other track
+	// functions or at other resolution), or calculate track function lookup tables (unless route is attached)
+	if ((trackRouteBool == false) && (trackDatabaseBool == true)) {
+		std::string tdfp = calc_companionFilePath("_track.tdb");  // track database file path
+		std::string tdstr = InputFileReader::VALID_INPUT_STRING;  // track database validation string
+		std::ifstream tdifs(tdfp);
+		bool tdeb = tdifs.good();  // track database exists boolean
+		tdifs.close();
+		if (tdeb == false) {
+			tdstr = TrackDatabase::convert(inputFileReader_Simulation->userDefinedTracks[0], tdfp, trackDatabaseResolution);
+		}
+		else if (TrackDatabase::isStale(tdfp, inputFileReader_Simulation->userDefinedTracks[0], trackDatabaseResolution) == true) {
+			if (printProgressBool == true) {
+				std::cout << "Binary track database '" << tdfp << "' does not match track functions or track database resolution and is converted again." << std::endl;
+				std::cout << std::endl;
+			}
+			tdstr = TrackDatabase::convert(inputFileReader_Simulation->userDefinedTracks[0], tdfp, trackDatabaseResolution);
+		}
+		if (tdstr.compare(InputFileReader::VALID_INPUT_STRING) == 0) {
+			tdstr = inputFileReader_Simulation->userDefinedTracks[0]->attach_database(tdfp);
+		}
+		if (tdstr.compare(InputFileReader::VALID_INPUT_STRING) != 0) {
+			std::cout << tdstr << "  Track functions are used." << std::endl;
+			std::cout << std::endl;
+		}
+	}
+	else if ((trackRouteBool == false) && (trackTableResolution > 0.0)) {
+		inputFileReader_Simulation->userDefinedTracks[0]->calc_lookupTables(trackTableResolution, trackTableMaxMemory);
+	}
+	// Set track averaging for each rail vehicle (track properties calculated before are discarded)
+	for (size_t i = 0; i < inputFileReader_Simulation->userDefinedTrainConsists[0]->railVehicles.size(); i++) {
+		inputFileReader_Simulation->userDefinedTrainConsists[0]->railVehicles[i]->trackAveragingBool = trackAveragingBool;
+		inputFileReader_Simulation->userDefinedTrainConsists[0]->railVehicles[i]->trackPropertiesPosition = std::numeric_limits<double>::max();
+	}
 	// Configure coupling systems
 	inputFileReader_Simulation->userDefinedTrainConsists[0]->configureCouplingSystems();
+	// Create rainflow counter for coupler force history of each coupling system
+	deleteRainflowCounters();
+	if (rainflowNumberOfBins > 0) {
+		for (size_t i = 0; i < inputFileReader_Simulation->userDefinedTrainConsists[0]->couplingSystems.size(); i++) {
+			rainflowCounters.push_back(new RainflowCounter(rainflowNumberOfBins, rainflowBinWidth, rainflowDamageExponent, rainflowDamageCoefficient));
+		}
+	}
 	// Place train consist on track
 	placeTrainConsistOnTrack();
 	// Calculate angle between top of rail and coupler for each rail vehicle
@@ -247,8 +472,15 @@ void Simulation::simulate(InputFileReader_ForcedSpeed* inputFileReader_ForcedSpe
 	for (size_t i = 0; i < inputFileReader_Simulation->userDefinedTrainConsists[0]->railVehicles.size(); i++) {
 		inputFileReader_Simulation->userDefinedTrainConsists[0]->railVehicles[i]->calc_secondSquareRootTermForLOverVCalc();
 	}
+	// Calculate gravitational force (which is constant for each rail vehicle)
+	for (size_t i = 0; i < inputFileReader_Simulation->userDefinedTrainConsists[0]->railVehicles.size(); i++) {
+		inputFileReader_Simulation->userDefinedTrainConsists[0]->railVehicles[i]->calc_globalGravitationalForce();
+		inputFileReader_Simulation->userDefinedTrainConsists[0]->railVehicles[i]->calc_globalVector_globalGravitationalForce();
+	}
 	// Initialize output results file writers
-	initializeResultsWriters();
+	if (writeResultsBool == true) {
+		initializeResultsWriters();
+	}
 	// Set current index in forced speed file
 	if ((inputFileReader_ForcedSpeed->inputFileExistsBool == true) && (inputFileReader_ForcedSpeed->totalNumberOfForcedSpeeds > 0)) {
 		for (int i = 0; i < inputFileReader_ForcedSpeed->totalNumberOfForcedSpeeds; i++) {
@@ -264,33 +496,42 @@ void Simulation::simulate(InputFileReader_ForcedSpeed* inputFileReader_ForcedSpe
 			}
 		}
 	}
-	// First iteration boolean
-	bool firstIterBool = true;
-	// Simulation loop
-	do {
-		// Calculate train consist position
-		inputFileReader_Simulation->userDefinedTrainConsists[0]->calc_locationOnTrack();
-		// Check for forced speed
-		if ((inputFileReader_ForcedSpeed->inputFileExistsBool == true) && (inputFileReader_ForcedSpeed->totalNumberOfForcedSpeeds > 0)) {
-			if (inputFileReader_ForcedSpeed->curind < (inputFileReader_ForcedSpeed->totalNumberOfForcedSpeeds - 1)) {
-				if (inputFileReader_ForcedSpeed->DBTBIFS == 0) {
-					if (inputFileReader_Simulation->userDefinedTrainConsists[0]->locationOnTrack > inputFileReader_ForcedSpeed->fsiv[inputFileReader_ForcedSpeed->curind + 1]) {
-						inputFileReader_ForcedSpeed->curind = inputFileReader_ForcedSpeed->curind + 1;
-						for (size_t j = 0; j <= (inputFileReader_Simulation->userDefinedTrainConsists[0]->railVehicles.size() - 1); j++) {
-							inputFileReader_Simulation->userDefinedTrainConsists[0]->railVehicles[j]->ssv[1] = inputFileReader_ForcedSpeed->fsdv[inputFileReader_ForcedSpeed->curind];
-						}
+}
+
+
+int Simulation::implicitSolverIntegrationStep() {
+	// Fast-forward through period in which train consist is held at rest by brakes and pneumatics are settled
+	if ((stoppedTrainBool == true) && (stoppedTrainPneumaticsSettledBool == true)) {
+		fastForwardStoppedTrain();
+	}
+	// Calculate train consist position
+	inputFileReader_Simulation->userDefinedTrainConsists[0]->calc_locationOnTrack();
+	// Check for forced speed
+	if ((inputFileReader_ForcedSpeed->inputFileExistsBool == true) && (inputFileReader_ForcedSpeed->totalNumberOfForcedSpeeds > 0)) {
+		if (inputFileReader_ForcedSpeed->curind < (inputFileReader_ForcedSpeed->totalNumberOfForcedSpeeds - 1)) {
+			if (inputFileReader_ForcedSpeed->DBTBIFS == 0) {
+				if (inputFileReader_Simulation->userDefinedTrainConsists[0]->locationOnTrack > inputFileReader_ForcedSpeed->fsiv[inputFileReader_ForcedSpeed->curind + 1]) {
+					inputFileReader_ForcedSpeed->curind = inputFileReader_ForcedSpeed->curind + 1;
+					for (size_t j = 0; j <= (inputFileReader_Simulation->userDefinedTrainConsists[0]->railVehicles.size() - 1); j++) {
+						inputFileReader_Simulation->userDefinedTrainConsists[0]->railVehicles[j]->ssv[1] = inputFileReader_ForcedSpeed->fsdv[inputFileReader_ForcedSpeed->curind];
 					}
 				}
-				else if (inputFileReader_ForcedSpeed->DBTBIFS == 1) {
-					if (explicitSolverTime > inputFileReader_ForcedSpeed->fsiv[inputFileReader_ForcedSpeed->curind + 1]) {
-						inputFileReader_ForcedSpeed->curind = inputFileReader_ForcedSpeed->curind + 1;
-						for (size_t j = 0; j < inputFileReader_Simulation->userDefinedTrainConsists[0]->railVehicles.size(); j++) {
-							inputFileReader_Simulation->userDefinedTrainConsists[0]->railVehicles[j]->ssv[1] = inputFileReader_ForcedSpeed->fsdv[inputFileReader_ForcedSpeed->curind];
-						}
+			}
+			else if (inputFileReader_ForcedSpeed->DBTBIFS == 1) {
+				if (explicitSolverTime > inputFileReader_ForcedSpeed->fsiv[inputFileReader_ForcedSpeed->curind + 1]) {
+					inputFileReader_ForcedSpeed->curind = inputFileReader_ForcedSpeed->curind + 1;
+					for (size_t j = 0; j < inputFileReader_Simulation->userDefinedTrainConsists[0]->railVehicles.size(); j++) {
+						inputFileReader_Simulation->userDefinedTrainConsists[0]->railVehicles[j]->ssv[1] = inputFileReader_ForcedSpeed->fsdv[inputFileReader_ForcedSpeed->curind];
 					}
 				}
 			}
 		}
+	}
+	// Calculate control valves, reservoirs, and brake cylinders (concurrently for blocks of rail vehicles with domain decomposition)
+	if (domainDecomposition != NULL) {
+		domainDecomposition->calc_railVehiclePneumatics(firstImplicitStepBool);
+	}
+	else {
 		// Calculate control valve operating mode for every car in train consist
 		for (size_t i = 0; i < inputFileReader_Simulation->userDefinedTrainConsists[0]->railVehicles.size(); i++) {
 			if (inputFileReader_Simulation->userDefinedTrainConsists[0]->railVehicleTypes[i] == 0) {
@@ -312,289 +553,265 @@ void Simulation::simulate(InputFileReader_ForcedSpeed* inputFileReader_ForcedSpe
 		}
 		// Calculate brake cylinder pressures
 		for (size_t i = 0; i < inputFileReader_Simulation->userDefinedTrainConsists[0]->railVehicles.size(); i++) {
-			inputFileReader_Simulation->userDefinedTrainConsists[0]->railVehicles[i]->brakeCylinder->calc_pressure(firstIterBool);
-		}
-		// Calculate brake pipe leakage
-		for (size_t i = 0; i < inputFileReader_Simulation->userDefinedTrainConsists[0]->brakePipes_Cumulative.size(); i++) {
-			for (size_t j = 0; j < inputFileReader_Simulation->userDefinedTrainConsists[0]->brakePipes_Cumulative[i]->brakePipe_FiniteElements.size(); j++) {
-				inputFileReader_Simulation->userDefinedTrainConsists[0]->brakePipes_Cumulative[i]->brakePipe_FiniteElements[j]->calc_leakage();
-			}
-		}
-		// Calculate locomotive automatic brake setting and idealized relay valve pressure
-		for (size_t i = 0; i < inputFileReader_Simulation->userDefinedTrainConsists[0]->locomotives.size(); i++) {
-			inputFileReader_Simulation->userDefinedTrainConsists[0]->locomotives[i]->calc_currentAutomaticBrakeValveSetting(true);
-			inputFileReader_Simulation->userDefinedTrainConsists[0]->locomotives[i]->calc_idealizedRelayValvePressure();
-		}
-		// Calculate boundary condition for first and last rail vehicle in train consist (if first and/or last rail vehicles are cars)
-		if (inputFileReader_Simulation->userDefinedTrainConsists[0]->eotDeviceCapability == 2) {
-			if (inputFileReader_Simulation->userDefinedTrainConsists[0]->railVehicleTypes[0] == 0) {
-				((Car*)inputFileReader_Simulation->userDefinedTrainConsists[0]->railVehicles[0])->endOfTrainDevice->calc_pressureAfterTwoWayEOTActivation();
-			}
-			int numberOfRailVehicles = inputFileReader_Simulation->userDefinedTrainConsists[0]->railVehicles.size();
-			if (inputFileReader_Simulation->userDefinedTrainConsists[0]->railVehicleTypes[numberOfRailVehicles - 1] == 0) {
-				((Car*)inputFileReader_Simulation->userDefinedTrainConsists[0]->railVehicles[numberOfRailVehicles - 1])->endOfTrainDevice->calc_pressureAfterTwoWayEOTActivation();
-			}
+			inputFileReader_Simulation->userDefinedTrainConsists[0]->railVehicles[i]->brakeCylinder->calc_pressure(firstImplicitStepBool);
 		}
-		// Calculate reynolds number and wall friction factor for brake pipe nodes
-		for (size_t i = 0; i < inputFileReader_Simulation->userDefinedTrainConsists[0]->brakePipes_Cumulative.size(); i++) {
-			for (size_t j = 0; j < inputFileReader_Simulation->userDefinedTrainConsists[0]->brakePipes_Cumulative[i]->brakePipe_FiniteElements.size(); j++) {
-				inputFileReader_Simulation->userDefinedTrainConsists[0]->brakePipes_Cumulative[i]->brakePipe_FiniteElements[j]->calc_nodeReynoldsNumbers();
-				inputFileReader_Simulation->userDefinedTrainConsists[0]->brakePipes_Cumulative[i]->brakePipe_FiniteElements[j]->calc_nodeWallFrictionFactors();
-			}
-		}
-		// Calculate node 'C' values and effective 'C' value (this is the term related to the wall friction factor)
-		for (size_t i = 0; i < inputFileReader_Simulation->userDefinedTrainConsists[0]->brakePipes_Cumulative.size(); i++) {
-			for (size_t j = 0; j < inputFileReader_Simulation->userDefinedTrainConsists[0]->brakePipes_Cumulative[i]->brakePipe_FiniteElements.size(); j++) {
-				inputFileReader_Simulation->userDefinedTrainConsists[0]->brakePipes_Cumulative[i]->brakePipe_FiniteElements[j]->calc_nodeCValues();
-				inputFileReader_Simulation->userDefinedTrainConsists[0]->brakePipes_Cumulative[i]->brakePipe_FiniteElements[j]->calc_effCValue();
-			}
-		}
-		// Integration step for brake pipes
-		for (size_t i = 0; i < inputFileReader_Simulation->userDefinedTrainConsists[0]->brakePipes_Cumulative.size(); i++) {
-			// Calculate system matrix
-			inputFileReader_Simulation->userDefinedTrainConsists[0]->brakePipes_Cumulative[i]->calc_systemMatrix();
-			// Calculate forcing vector
-			inputFileReader_Simulation->userDefinedTrainConsists[0]->brakePipes_Cumulative[i]->calc_forcingVector();
-			// Calculate brake pipe pressures and 'm' values for next time step
-			inputFileReader_Simulation->userDefinedTrainConsists[0]->brakePipes_Cumulative[i]->linearSystem->
-				gaussElimination(inputFileReader_Simulation->userDefinedTrainConsists[0]->brakePipes_Cumulative[i]->systemMatrix,
-					inputFileReader_Simulation->userDefinedTrainConsists[0]->brakePipes_Cumulative[i]->forcingVector,
-					inputFileReader_Simulation->userDefinedTrainConsists[0]->brakePipes_Cumulative[i]->systemMatrixDim);
-			// Update pressure and velocity values at brake pipe finite element nodes
-			inputFileReader_Simulation->userDefinedTrainConsists[0]->brakePipes_Cumulative[i]->updatePressureAndVelocityAtBrakePipeFiniteElementNodes();
-		}
-		// Calculate brake pipe air density, brake pipe air velocity, and car brake pipe pressure values
-		for (size_t i = 0; i < inputFileReader_Simulation->userDefinedTrainConsists[0]->brakePipes_Cumulative.size(); i++) {
-			for (size_t j = 0; j < inputFileReader_Simulation->userDefinedTrainConsists[0]->brakePipes_Cumulative[i]->brakePipe_FiniteElements.size(); j++) {
-				inputFileReader_Simulation->userDefinedTrainConsists[0]->brakePipes_Cumulative[i]->brakePipe_FiniteElements[j]->calc_nodeDensities();
-				inputFileReader_Simulation->userDefinedTrainConsists[0]->brakePipes_Cumulative[i]->brakePipe_FiniteElements[j]->calc_nodeVelocities();
-				inputFileReader_Simulation->userDefinedTrainConsists[0]->brakePipes_Cumulative[i]->brakePipe_FiniteElements[j]->calculateBrakePipePressureForRailVehicles();
-			}
-		}
-		// Calculate reactive centrifugal force
-		for (size_t i = 0; i < inputFileReader_Simulation->userDefinedTrainConsists[0]->railVehicles.size(); i++) {
-			inputFileReader_Simulation->userDefinedTrainConsists[0]->railVehicles[i]->calc_globalReactiveCentrifugalForce();
-			inputFileReader_Simulation->userDefinedTrainConsists[0]->railVehicles[i]->calc_globalVector_globalReactiveCentrifugalForce();
-			inputFileReader_Simulation->userDefinedTrainConsists[0]->railVehicles[i]->calcLocal3DVecFromGlobalReactiveCentrifugalForce();
-		}
-		// Calculate gravitational force
-		for (size_t i = 0; i < inputFileReader_Simulation->userDefinedTrainConsists[0]->railVehicles.size(); i++) {
-			if (firstIterBool == true) {
-				inputFileReader_Simulation->userDefinedTrainConsists[0]->railVehicles[i]->calc_globalGravitationalForce();
-				inputFileReader_Simulation->userDefinedTrainConsists[0]->railVehicles[i]->calc_globalVector_globalGravitationalForce();
-			}
-			inputFileReader_Simulation->userDefinedTrainConsists[0]->railVehicles[i]->calcLocal3DVecFromGlobalGravitationalForce();
-		}
-		// Calculate sum of external tangential forces (due to reactive centrifugal force, gravity, propulsion resistance, and curving resistance) for each rail vehicle
-		for (size_t i = 0; i < inputFileReader_Simulation->userDefinedTrainConsists[0]->railVehicles.size(); i++) {
-			inputFileReader_Simulation->userDefinedTrainConsists[0]->railVehicles[i]->calc_sumExternalTangentialForces();
-		}
-		// Calculate locomotive throttle setting
-		for (size_t i = 0; i < inputFileReader_Simulation->userDefinedTrainConsists[0]->locomotives.size(); i++) {
-			inputFileReader_Simulation->userDefinedTrainConsists[0]->locomotives[i]->calc_currentThrottleSetting();
+	}
+	// Calculate brake pipe leakage
+	for (size_t i = 0; i < inputFileReader_Simulation->userDefinedTrainConsists[0]->brakePipes_Cumulative.size(); i++) {
+		for (size_t j = 0; j < inputFileReader_Simulation->userDefinedTrainConsists[0]->brakePipes_Cumulative[i]->brakePipe_FiniteElements.size(); j++) {
+			inputFileReader_Simulation->userDefinedTrainConsists[0]->brakePipes_Cumulative[i]->brakePipe_FiniteElements[j]->calc_leakage();
 		}
-		// Calculate throttle force of each rail vehicle (note that throttle force is set to zero for cars)
-		for (size_t i = 0; i < inputFileReader_Simulation->userDefinedTrainConsists[0]->railVehicles.size(); i++) {
-			inputFileReader_Simulation->userDefinedTrainConsists[0]->railVehicles[i]->calc_throttleForce();
+	}
+	// Calculate locomotive automatic brake setting and idealized relay valve pressure
+	for (size_t i = 0; i < inputFileReader_Simulation->userDefinedTrainConsists[0]->locomotives.size(); i++) {
+		inputFileReader_Simulation->userDefinedTrainConsists[0]->locomotives[i]->calc_currentAutomaticBrakeValveSetting(true);
+		inputFileReader_Simulation->userDefinedTrainConsists[0]->locomotives[i]->calc_idealizedRelayValvePressure();
+	}
+	// Calculate boundary condition for first and last rail vehicle in train consist (if first and/or last rail vehicles are cars)
+	if (inputFileReader_Simulation->userDefinedTrainConsists[0]->eotDeviceCapability == 2) {
+		if (inputFileReader_Simulation->userDefinedTrainConsists[0]->railVehicleTypes[0] == 0) {
+			((Car*)inputFileReader_Simulation->userDefinedTrainConsists[0]->railVehicles[0])->endOfTrainDevice->calc_pressureAfterTwoWayEOTActivation();
 		}
-		// Calculate locomotive independent brake and dynamic brake settings
-		for (size_t i = 0; i < inputFileReader_Simulation->userDefinedTrainConsists[0]->locomotives.size(); i++) {
-			inputFileReader_Simulation->userDefinedTrainConsists[0]->locomotives[i]->calc_currentIndependentBrakeValveSetting();
-			inputFileReader_Simulation->userDefinedTrainConsists[0]->locomotives[i]->calc_currentDynamicBrakeSetting();
+		int numberOfRailVehicles = inputFileReader_Simulation->userDefinedTrainConsists[0]->railVehicles.size();
+		if (inputFileReader_Simulation->userDefinedTrainConsists[0]->railVehicleTypes[numberOfRailVehicles - 1] == 0) {
+			((Car*)inputFileReader_Simulation->userDefinedTrainConsists[0]->railVehicles[numberOfRailVehicles - 1])->endOfTrainDevice->calc_pressureAfterTwoWayEOTActivation();
 		}
-		// Calculate brake cylinder piston force, normal force between brake shoe and wheel, and retarding brake force
-		for (size_t i = 0; i < inputFileReader_Simulation->userDefinedTrainConsists[0]->railVehicles.size(); i++) {
-			inputFileReader_Simulation->userDefinedTrainConsists[0]->railVehicles[i]->brakeCylinder->calc_pistonForce();
-			inputFileReader_Simulation->userDefinedTrainConsists[0]->railVehicles[i]->brakeCylinder->calc_normalShoeWheelForce();
-			inputFileReader_Simulation->userDefinedTrainConsists[0]->railVehicles[i]->brakeCylinder->calc_retardingBrakeForce();
+	}
+	// Calculate reynolds number and wall friction factor for brake pipe nodes
+	for (size_t i = 0; i < inputFileReader_Simulation->userDefinedTrainConsists[0]->brakePipes_Cumulative.size(); i++) {
+		for (size_t j = 0; j < inputFileReader_Simulation->userDefinedTrainConsists[0]->brakePipes_Cumulative[i]->brakePipe_FiniteElements.size(); j++) {
+			inputFileReader_Simulation->userDefinedTrainConsists[0]->brakePipes_Cumulative[i]->brakePipe_FiniteElements[j]->calc_nodeReynoldsNumbers();
+			inputFileReader_Simulation->userDefinedTrainConsists[0]->brakePipes_Cumulative[i]->brakePipe_FiniteElements[j]->calc_nodeWallFrictionFactors();
 		}
-		// Calculate braking force of each rail vehicle
-		for (size_t i = 0; i < inputFileReader_Simulation->userDefinedTrainConsists[0]->railVehicles.size(); i++) {
-			inputFileReader_Simulation->userDefinedTrainConsists[0]->railVehicles[i]->calc_brakingForce();
+	}
+	// Calculate node 'C' values and effective 'C' value (this is the term related to the wall friction factor)
+	for (size_t i = 0; i < inputFileReader_Simulation->userDefinedTrainConsists[0]->brakePipes_Cumulative.size(); i++) {
+		for (size_t j = 0; j < inputFileReader_Simulation->userDefinedTrainConsists[0]->brakePipes_Cumulative[i]->brakePipe_FiniteElements.size(); j++) {
+			inputFileReader_Simulation->userDefinedTrainConsists[0]->brakePipes_Cumulative[i]->brakePipe_FiniteElements[j]->calc_nodeCValues();
+			inputFileReader_Simulation->userDefinedTrainConsists[0]->brakePipes_Cumulative[i]->brakePipe_FiniteElements[j]->calc_effCValue();
 		}
-		// Calculate angle (rotation about z axis) of each rail vehicle
-		for (size_t i = 0; i < inputFileReader_Simulation->userDefinedTrainConsists[0]->railVehicles.size(); i++) {
-			inputFileReader_Simulation->userDefinedTrainConsists[0]->railVehicles[i]->calc_theta();
+	}
+	// Integration step for brake pipes
+	for (size_t i = 0; i < inputFileReader_Simulation->userDefinedTrainConsists[0]->brakePipes_Cumulative.size(); i++) {
+		// Calculate system matrix
+		inputFileReader_Simulation->userDefinedTrainConsists[0]->brakePipes_Cumulative[i]->calc_systemMatrix();
+		// Calculate forcing vector
+		inputFileReader_Simulation->userDefinedTrainConsists[0]->brakePipes_Cumulative[i]->calc_forcingVector();
+		// Calculate brake pipe pressures and 'm' values for next time step
+		inputFileReader_Simulation->userDefinedTrainConsists[0]->brakePipes_Cumulative[i]->linearSystem->
+			gaussElimination(inputFileReader_Simulation->userDefinedTrainConsists[0]->brakePipes_Cumulative[i]->systemMatrix,
+				inputFileReader_Simulation->userDefinedTrainConsists[0]->brakePipes_Cumulative[i]->forcingVector,
+				inputFileReader_Simulation->userDefinedTrainConsists[0]->brakePipes_Cumulative[i]->systemMatrixDim);
+		// Update pressure and velocity values at brake pipe finite element nodes
+		inputFileReader_Simulation->userDefinedTrainConsists[0]->brakePipes_Cumulative[i]->updatePressureAndVelocityAtBrakePipeFiniteElementNodes();
+	}
+	// Calculate brake pipe air density, brake pipe air velocity, and car brake pipe pressure values
+	for (size_t i = 0; i < inputFileReader_Simulation->userDefinedTrainConsists[0]->brakePipes_Cumulative.size(); i++) {
+		for (size_t j = 0; j < inputFileReader_Simulation->userDefinedTrainConsists[0]->brakePipes_Cumulative[i]->brakePipe_FiniteElements.size(); j++) {
+			inputFileReader_Simulation->userDefinedTrainConsists[0]->brakePipes_Cumulative[i]->brakePipe_FiniteElements[j]->calc_nodeDensities();
+			inputFileReader_Simulation->userDefinedTrainConsists[0]->brakePipes_Cumulative[i]->brakePipe_FiniteElements[j]->calc_nodeVelocities();
+			inputFileReader_Simulation->userDefinedTrainConsists[0]->brakePipes_Cumulative[i]->brakePipe_FiniteElements[j]->calculateBrakePipePressureForRailVehicles();
 		}
-		// Calculate angle between current rail vehicle and adjacent leading rail vehicle
-		for (size_t i = 0; i < inputFileReader_Simulation->userDefinedTrainConsists[0]->railVehicles.size(); i++) {
-			inputFileReader_Simulation->userDefinedTrainConsists[0]->railVehicles[i]->calc_alpha_leadingRailVehicle();
+	}
+	// Calculate track grade, curvature, and superelevation at position of each rail vehicle
+	inputFileReader_Simulation->userDefinedTrainConsists[0]->calc_trackProperties();
+	// Calculate reactive centrifugal force
+	for (size_t i = 0; i < inputFileReader_Simulation->userDefinedTrainConsists[0]->railVehicles.size(); i++) {
+		inputFileReader_Simulation->userDefinedTrainConsists[0]->railVehicles[i]->calc_globalReactiveCentrifugalForce();
+		inputFileReader_Simulation->userDefinedTrainConsists[0]->railVehicles[i]->calc_globalVector_globalReactiveCentrifugalForce();
+		inputFileReader_Simulation->userDefinedTrainConsists[0]->railVehicles[i]->calcLocal3DVecFromGlobalReactiveCentrifugalForce();
+	}
+	// Calculate gravitational force
+	for (size_t i = 0; i < inputFileReader_Simulation->userDefinedTrainConsists[0]->railVehicles.size(); i++) {
+		inputFileReader_Simulation->userDefinedTrainConsists[0]->railVehicles[i]->calcLocal3DVecFromGlobalGravitationalForce();
+	}
+	// Calculate sum of external tangential forces (due to reactive centrifugal force, gravity, propulsion resistance, and curving resistance) for each rail vehicle
+	for (size_t i = 0; i < inputFileReader_Simulation->userDefinedTrainConsists[0]->railVehicles.size(); i++) {
+		inputFileReader_Simulation->userDefinedTrainConsists[0]->railVehicles[i]->calc_sumExternalTangentialForces();
+	}
+	// Calculate locomotive throttle setting
+	for (size_t i = 0; i < inputFileReader_Simulation->userDefinedTrainConsists[0]->locomotives.size(); i++) {
+		inputFileReader_Simulation->userDefinedTrainConsists[0]->locomotives[i]->calc_currentThrottleSetting();
+	}
+	// Calculate throttle force of each rail vehicle (note that throttle force is set to zero for cars)
+	for (size_t i = 0; i < inputFileReader_Simulation->userDefinedTrainConsists[0]->railVehicles.size(); i++) {
+		inputFileReader_Simulation->userDefinedTrainConsists[0]->railVehicles[i]->calc_throttleForce();
+	}
+	// Calculate locomotive independent brake and dynamic brake settings
+	for (size_t i = 0; i < inputFileReader_Simulation->userDefinedTrainConsists[0]->locomotives.size(); i++) {
+		inputFileReader_Simulation->userDefinedTrainConsists[0]->locomotives[i]->calc_currentIndependentBrakeValveSetting();
+		inputFileReader_Simulation->userDefinedTrainConsists[0]->locomotives[i]->calc_currentDynamicBrakeSetting();
+	}
+	// Calculate brake cylinder piston force, normal force between brake shoe and wheel, and retarding brake force
+	for (size_t i = 0; i < inputFileReader_Simulation->userDefinedTrainConsists[0]->railVehicles.size(); i++) {
+		inputFileReader_Simulation->userDefinedTrainConsists[0]->railVehicles[i]->brakeCylinder->calc_pistonForce();
+		inputFileReader_Simulation->userDefinedTrainConsists[0]->railVehicles[i]->brakeCylinder->calc_normalShoeWheelForce();
+		inputFileReader_Simulation->userDefinedTrainConsists[0]->railVehicles[i]->brakeCylinder->calc_retardingBrakeForce();
+	}
+	// Calculate braking force of each rail vehicle
+	for (size_t i = 0; i < inputFileReader_Simulation->userDefinedTrainConsists[0]->railVehicles.size(); i++) {
+		inputFileReader_Simulation->userDefinedTrainConsists[0]->railVehicles[i]->calc_brakingForce();
+	}
+	// Calculate angle (rotation about z axis) of each rail vehicle
+	for (size_t i = 0; i < inputFileReader_Simulation->userDefinedTrainConsists[0]->railVehicles.size(); i++) {
+		inputFileReader_Simulation->userDefinedTrainConsists[0]->railVehicles[i]->calc_theta();
+	}
+	// Calculate angle between current rail vehicle and adjacent leading rail vehicle
+	for (size_t i = 0; i < inputFileReader_Simulation->userDefinedTrainConsists[0]->railVehicles.size(); i++) {
+		inputFileReader_Simulation->userDefinedTrainConsists[0]->railVehicles[i]->calc_alpha_leadingRailVehicle();
+	}
+	// Calculate angle between current rail vehicle and adjacent trailing rail vehicle
+	for (size_t i = 0; i < inputFileReader_Simulation->userDefinedTrainConsists[0]->railVehicles.size(); i++) {
+		inputFileReader_Simulation->userDefinedTrainConsists[0]->railVehicles[i]->calc_alpha_trailingRailVehicle();
+	}
+	// Enter or leave stopped train mode and quasi-static stepping
+	calc_stoppedTrainMode();
+	calc_quasiStaticMode();
+	// Update implicit solver time
+	implicitSolverTime = implicitSolverTime + IMPLICIT_SOLVER_FIXED_TIME_STEP;
+	// Explicit solver loop
+	do {
+		bool numericalInstabilityBool = false;  // numerical instability boolean
+		if (stoppedTrainBool == true) {
+			// Calculate next time step results for train consist held at rest
+			stoppedTrainIntegrationStep();
 		}
-		// Calculate angle between current rail vehicle and adjacent trailing rail vehicle
-		for (size_t i = 0; i < inputFileReader_Simulation->userDefinedTrainConsists[0]->railVehicles.size(); i++) {
-			inputFileReader_Simulation->userDefinedTrainConsists[0]->railVehicles[i]->calc_alpha_trailingRailVehicle();
+		else if (quasiStaticBool == true) {
+			// Calculate next time step results for train consist as a rigid body
+			quasiStaticIntegrationStep();
 		}
-		// Update implicit solver time
-		implicitSolverTime = implicitSolverTime + IMPLICIT_SOLVER_FIXED_TIME_STEP;
-		// Explicit solver loop
-		do {
+		else {
 			// Calculate force on leading rail vehicle for each coupling system
-			for (size_t i = 0; i < inputFileReader_Simulation->userDefinedTrainConsists[0]->couplingSystems.size(); i++) {
-				inputFileReader_Simulation->userDefinedTrainConsists[0]->couplingSystems[i]->calc_centerToCenterDistance(true);
-				inputFileReader_Simulation->userDefinedTrainConsists[0]->couplingSystems[i]->calc_displacement();
-				inputFileReader_Simulation->userDefinedTrainConsists[0]->couplingSystems[i]->calc_totalForceOnLeadingRailVehicle();  // also updates coupler displacements
+			if (domainDecomposition != NULL) {
+				domainDecomposition->calc_couplingSystemForces();
+			}
+			else {
+				inputFileReader_Simulation->userDefinedTrainConsists[0]->couplingSystemBatch->calc_totalForcesOnLeadingRailVehicles(0, inputFileReader_Simulation->userDefinedTrainConsists[0]->couplingSystems.size(), true);  // also updates coupler displacements
 			}
 			// Calculate next time step results
 			numericalInstabilityBool = explicitSolverIntegrationStep();
-			// Depending on boolean returned by 'explicitSolverIntegrationStep' method, either terminate simulation or update progress bar
-			if (numericalInstabilityBool == true) {
-				closeResultsWriters(true);
-				std::cout << "Simulation has been terminated due to the integration time step being too small." << std::endl;
-				std::cout << std::endl;
-				std::cout << "Press Enter to end program";
-				std::cin.ignore();
-				std::exit(EXIT_SUCCESS);
+		}
+		// Depending on boolean returned by 'explicitSolverIntegrationStep' method, either terminate simulation or update progress bar
+		if (numericalInstabilityBool == true) {
+			return TC_TIME_STEP_TOO_SMALL;
+		}
+		else {
+			// Calculate force on leading rail vehicle for each coupling system
+			inputFileReader_Simulation->userDefinedTrainConsists[0]->couplingSystemBatch->calc_totalForcesOnLeadingRailVehicles(0, inputFileReader_Simulation->userDefinedTrainConsists[0]->couplingSystems.size(), true);  // also updates coupler displacements
+			// Calculate tangential component of leading and trailing coupler for each rail vehicle
+			for (size_t i = 0; i < inputFileReader_Simulation->userDefinedTrainConsists[0]->railVehicles.size(); i++) {
+				inputFileReader_Simulation->userDefinedTrainConsists[0]->railVehicles[i]->calc_tangentialForceDueToLeadingCoupler();
+				inputFileReader_Simulation->userDefinedTrainConsists[0]->railVehicles[i]->calc_tangentialForceDueToTrailingCoupler();
 			}
-			else {
-				// Calculate force on leading rail vehicle for each coupling system
-				for (size_t i = 0; i < inputFileReader_Simulation->userDefinedTrainConsists[0]->couplingSystems.size(); i++) {
-					inputFileReader_Simulation->userDefinedTrainConsists[0]->couplingSystems[i]->calc_centerToCenterDistance(true);
-					inputFileReader_Simulation->userDefinedTrainConsists[0]->couplingSystems[i]->calc_displacement();
-					inputFileReader_Simulation->userDefinedTrainConsists[0]->couplingSystems[i]->calc_totalForceOnLeadingRailVehicle();  // also updates coupler displacements
-				}
-				// Calculate tangential component of leading and trailing coupler for each rail vehicle
-				for (size_t i = 0; i < inputFileReader_Simulation->userDefinedTrainConsists[0]->railVehicles.size(); i++) {
-					inputFileReader_Simulation->userDefinedTrainConsists[0]->railVehicles[i]->calc_tangentialForceDueToLeadingCoupler();
-					inputFileReader_Simulation->userDefinedTrainConsists[0]->railVehicles[i]->calc_tangentialForceDueToTrailingCoupler();
-				}
-				// Calculate lateral component of leading and trailing coupler for each rail vehicle
-				for (size_t i = 0; i < inputFileReader_Simulation->userDefinedTrainConsists[0]->railVehicles.size(); i++) {
-					inputFileReader_Simulation->userDefinedTrainConsists[0]->railVehicles[i]->calc_lateralForceDueToLeadingCoupler();
-					inputFileReader_Simulation->userDefinedTrainConsists[0]->railVehicles[i]->calc_lateralForceDueToTrailingCoupler();
-				}
-				// Calculate force of leading truck on track
-				for (size_t i = 0; i < inputFileReader_Simulation->userDefinedTrainConsists[0]->railVehicles.size(); i++) {
-					inputFileReader_Simulation->userDefinedTrainConsists[0]->railVehicles[i]->calc_forceOnTrackDueToLeadingTruck();
-				}
-				// Calculate force of trailing truck on track
-				for (size_t i = 0; i < inputFileReader_Simulation->userDefinedTrainConsists[0]->railVehicles.size(); i++) {
-					inputFileReader_Simulation->userDefinedTrainConsists[0]->railVehicles[i]->calc_forceOnTrackDueToTrailingTruck();
-				}
-				// Calculate vertical force on each side of leading truck and trailing truck
-				for (size_t i = 0; i < inputFileReader_Simulation->userDefinedTrainConsists[0]->railVehicles.size(); i++) {
-					inputFileReader_Simulation->userDefinedTrainConsists[0]->railVehicles[i]->calc_verticalForceRightSideLeadingTruck();
-					inputFileReader_Simulation->userDefinedTrainConsists[0]->railVehicles[i]->calc_verticalForceLeftSideLeadingTruck();
-					inputFileReader_Simulation->userDefinedTrainConsists[0]->railVehicles[i]->calc_verticalForceRightSideTrailingTruck();
-					inputFileReader_Simulation->userDefinedTrainConsists[0]->railVehicles[i]->calc_verticalForceLeftSideTrailingTruck();
-				}
-				// Calculate L/V ratio for each side of leading truck and trailing truck
-				for (size_t i = 0; i < inputFileReader_Simulation->userDefinedTrainConsists[0]->railVehicles.size(); i++) {
-					inputFileReader_Simulation->userDefinedTrainConsists[0]->railVehicles[i]->calc_lOverVForRightSideOfLeadingTruck();
-					inputFileReader_Simulation->userDefinedTrainConsists[0]->railVehicles[i]->calc_lOverVForLeftSideOfLeadingTruck();
-					inputFileReader_Simulation->userDefinedTrainConsists[0]->railVehicles[i]->calc_lOverVForRightSideOfTrailingTruck();
-					inputFileReader_Simulation->userDefinedTrainConsists[0]->railVehicles[i]->calc_lOverVForLeftSideOfTrailingTruck();
-				}
-				// Calculate maximum L/V ratio
-				for (size_t i = 0; i < inputFileReader_Simulation->userDefinedTrainConsists[0]->railVehicles.size(); i++) {
-					inputFileReader_Simulation->userDefinedTrainConsists[0]->railVehicles[i]->calc_lOverVMax();
-				}
-				// Calculate locomotive automatic brake setting (if locomotive operator is distance-based), independent brake setting, 
-				// dynamic brake setting, and throttle setting
-				for (size_t i = 0; i < inputFileReader_Simulation->userDefinedTrainConsists[0]->locomotives.size(); i++) {
-					inputFileReader_Simulation->userDefinedTrainConsists[0]->locomotives[i]->calc_currentAutomaticBrakeValveSetting(false);
-					inputFileReader_Simulation->userDefinedTrainConsists[0]->locomotives[i]->calc_currentIndependentBrakeValveSetting();
-					inputFileReader_Simulation->userDefinedTrainConsists[0]->locomotives[i]->calc_currentDynamicBrakeSetting();
-					inputFileReader_Simulation->userDefinedTrainConsists[0]->locomotives[i]->calc_currentThrottleSetting();
-				}
-				// Write single time step results, if necessary
-				if ((explicitSolverTime - explicitSolverTimeLastWrittenResults) >= (1.0 / sampleRate)) {
-					explicitSolverTimeLastWrittenResults = explicitSolverTime;
-					if (headerLabelsWrittenBool == false) {
-						for (size_t i = 0; i < inputFileReader_Simulation->userDefinedTrainConsists[0]->railVehicles.size(); i++) {
-							if (inputFileReader_Simulation->userDefinedTrainConsists[0]->railVehicles[i]->printResultsBool == true) {
-								inputFileReader_Simulation->userDefinedTrainConsists[0]->railVehicles[i]->results(this, true);
-							}
-						}
-						writeResults_BrakePipePressures(true);
-						writeResults_AuxiliaryReservoirPressures(true);
-						writeResults_EmergencyReservoirPressures(true);
-						writeResults_CouplerForces(true);
-						writeResults_CouplerDisplacements(true);
-						headerLabelsWrittenBool = true;
-					}
-					else {
-						for (size_t i = 0; i < inputFileReader_Simulation->userDefinedTrainConsists[0]->railVehicles.size(); i++) {
-							if (inputFileReader_Simulation->userDefinedTrainConsists[0]->railVehicles[i]->printResultsBool == true) {
-								inputFileReader_Simulation->userDefinedTrainConsists[0]->railVehicles[i]->results(this, false);
-							}
-						}
-						writeResults_BrakePipePressures(false);
-						writeResults_AuxiliaryReservoirPressures(false);
-						writeResults_EmergencyReservoirPressures(false);
-						writeResults_CouplerForces(false);
-						writeResults_CouplerDisplacements(false);
-						headerLabelsWrittenBool = true;
-					}
-				}
+			// Calculate lateral component of leading and trailing coupler for each rail vehicle
+			for (size_t i = 0; i < inputFileReader_Simulation->userDefinedTrainConsists[0]->railVehicles.size(); i++) {
+				inputFileReader_Simulation->userDefinedTrainConsists[0]->railVehicles[i]->calc_lateralForceDueToLeadingCoupler();
+				inputFileReader_Simulation->userDefinedTrainConsists[0]->railVehicles[i]->calc_lateralForceDueToTrailingCoupler();
 			}
-		} while (explicitSolverTime < implicitSolverTime);
-		// Update progress
-		if ((implicitSolverTime - implicitSolverTimeOfPreviousProgressUpdate) >= ELAPSED_TIME_FOR_UPDATE_PROGRESS) {
-			int progress = (int)((implicitSolverTime / MAX_NUMBER_OF_SIMULATED_SECONDS) * 100.0);
-			std::cout << progress << "% complete" << std::endl;
-			std::cout << std::endl;
-			implicitSolverTimeOfPreviousProgressUpdate = implicitSolverTime;
-		}
-		// Check if any coupler has excessive displacement
-		for (size_t i = 0; i < inputFileReader_Simulation->userDefinedTrainConsists[0]->couplingSystems.size(); i++) {
-			for (size_t j = 0; j < inputFileReader_Simulation->userDefinedTrainConsists[0]->couplingSystems[i]->couplers.size(); j++) {
-				int num_intervals = inputFileReader_Simulation->userDefinedTrainConsists[0]->couplingSystems[i]->couplers[j]->physicalVariables[0]->intervals.size();
-				if ((inputFileReader_Simulation->userDefinedTrainConsists[0]->couplingSystems[i]->couplers[j]->displacement > 
-					inputFileReader_Simulation->userDefinedTrainConsists[0]->couplingSystems[i]->couplers[j]->physicalVariables[0]->intervals[num_intervals - 1]->points[1]->x) || 
-					(inputFileReader_Simulation->userDefinedTrainConsists[0]->couplingSystems[i]->couplers[j]->displacement <
-						inputFileReader_Simulation->userDefinedTrainConsists[0]->couplingSystems[i]->couplers[j]->physicalVariables[0]->intervals[0]->points[0]->x)) {
-					excessiveCouplerDisplacementBool = true;
-					break;
-				}
+			// Calculate locomotive automatic brake setting (if locomotive operator is distance-based), independent brake setting, 
+			// dynamic brake setting, and throttle setting
+			for (size_t i = 0; i < inputFileReader_Simulation->userDefinedTrainConsists[0]->locomotives.size(); i++) {
+				inputFileReader_Simulation->userDefinedTrainConsists[0]->locomotives[i]->calc_currentAutomaticBrakeValveSetting(false);
+				inputFileReader_Simulation->userDefinedTrainConsists[0]->locomotives[i]->calc_currentIndependentBrakeValveSetting();
+				inputFileReader_Simulation->userDefinedTrainConsists[0]->locomotives[i]->calc_currentDynamicBrakeSetting();
+				inputFileReader_Simulation->userDefinedTrainConsists[0]->locomotives[i]->calc_currentThrottleSetting();
 			}
-			if (excessiveCouplerDisplacementBool == true) {
+			// Write single time step results, if necessary
+			writeSampledResults();
+		}
+		// Count coupler force cycles at every explicit solver time step
+		if (rainflowCounters.size() > 0) {
+			countCouplerForceCycles();
+		}
+	} while (explicitSolverTime < implicitSolverTime);
+	// Update progress
+	updateProgress();
+	// Check if any coupler has excessive displacement
+	bool excessiveCouplerDisplacementBool = false;  // excessive coupler displacement boolean
+	for (size_t i = 0; i < inputFileReader_Simulation->userDefinedTrainConsists[0]->couplingSystems.size(); i++) {
+		for (size_t j = 0; j < inputFileReader_Simulation->userDefinedTrainConsists[0]->couplingSystems[i]->couplers.size(); j++) {
+			int num_intervals = inputFileReader_Simulation->userDefinedTrainConsists[0]->couplingSystems[i]->couplers[j]->physicalVariables[0]->intervals.size();
+			if ((inputFileReader_Simulation->userDefinedTrainConsists[0]->couplingSystems[i]->couplers[j]->displacement > 
+				inputFileReader_Simulation->userDefinedTrainConsists[0]->couplingSystems[i]->couplers[j]->physicalVariables[0]->intervals[num_intervals - 1]->points[1]->x) || 
+				(inputFileReader_Simulation->userDefinedTrainConsists[0]->couplingSystems[i]->couplers[j]->displacement <
+					inputFileReader_Simulation->userDefinedTrainConsists[0]->couplingSystems[i]->couplers[j]->physicalVariables[0]->intervals[0]->points[0]->x)) {
+				excessiveCouplerDisplacementBool = true;
 				break;
 			}
 		}
 		if (excessiveCouplerDisplacementBool == true) {
-			closeResultsWriters(true);
-			std::cout << "Simulation has been terminated due to excessive coupler displacement." << std::endl;
-			std::cout << std::endl;
-			std::cout << "Press Enter to end program";
-			std::cin.ignore();
-			std::exit(EXIT_SUCCESS);
-		}
-		// Check if train consist is within track boundary limits
-		consistInsideTrackBoundariesBool = checkTrainConsistIsOnTrack();
-		if (consistInsideTrackBoundariesBool == false) {
-			closeResultsWriters(true);
-			std::cout << "Simulation has been terminated due to train consist reaching end of track." << std::endl;
-			std::cout << std::endl;
-			std::cout << "Press Enter to end program";
-			std::cin.ignore();
-			std::exit(EXIT_SUCCESS);
-		}
-		// Check if train consist has had zero or negative velocity for 30 seconds or more
-		consistMovingForwardBool = checkTrainConsistIsMoving();
-		if (consistMovingForwardBool == false) {
-			closeResultsWriters(true);
-			std::cout << "Simulation has been terminated due to train consist speed being below " << APPROX_ZERO_VELOCITY_US << " miles per hour for at least " << MAX_WAIT_POSITIVE_VELOCITY << " seconds." << std::endl;
-			std::cout << std::endl;
-			std::cout << "Press Enter to end program";
-			std::cin.ignore();
-			std::exit(EXIT_SUCCESS);
-		}
-		// Check if train speed exceeds maximum allowable train speed
-		trainSpeedUnderMaxSpeedBool = checkTrainSpeedIsUnderMaximumAllowableSpeed();
-		if (trainSpeedUnderMaxSpeedBool == false) {
-			closeResultsWriters(true);
-			std::cout << "Simulation has been terminated due to train consist speed exceeding maximum allowable speed of " << MAX_ALLOWABLE_TRAIN_SPEED_US << " miles per hour." << std::endl;
-			std::cout << std::endl;
-			std::cout << "Press Enter to end program";
-			std::cin.ignore();
-			std::exit(EXIT_SUCCESS);
-		}
-		// Update first iteration boolean
-		firstIterBool = false;
-	} while (implicitSolverTime < MAX_NUMBER_OF_SIMULATED_SECONDS);
-	// Close result writers and print message to console that simulation was completed successfully
+			break;
+		}
+	}
+	if (excessiveCouplerDisplacementBool == true) {
+		return TC_EXCESSIVE_COUPLER_DISPLACEMENT;
+	}
+	// Check if train consist is within track boundary limits
+	bool consistInsideTrackBoundariesBool = checkTrainConsistIsOnTrack();  // consist inside track boundaries boolean
+	if (consistInsideTrackBoundariesBool == false) {
+		return TC_END_OF_TRACK;
+	}
+	// Check if train consist has had zero or negative velocity for 30 seconds or more
+	bool consistMovingForwardBool = checkTrainConsistIsMoving();  // consist moving forward boolean
+	if (consistMovingForwardBool == false) {
+		return TC_TRAIN_CONSIST_NOT_MOVING;
+	}
+	// Check if train speed exceeds maximum allowable train speed
+	bool trainSpeedUnderMaxSpeedBool = checkTrainSpeedIsUnderMaximumAllowableSpeed();  // train speed under maximum allowable speed boolean
+	if (trainSpeedUnderMaxSpeedBool == false) {
+		return TC_MAXIMUM_SPEED_EXCEEDED;
+	}
+	// Update first implicit step boolean
+	firstImplicitStepBool = false;
+	// Check if maximum number of simulated seconds has been reached
+	if (implicitSolverTime >= MAX_NUMBER_OF_SIMULATED_SECONDS) {
+		return TC_MAXIMUM_SIMULATED_SECONDS;
+	}
+	return TC_NONE;
+}
+
+
+int Simulation::simulateImplicitSolverTimeSteps(int numberOfImplicitSolverTimeSteps) {
+	int tc = TC_NONE;  // termination condition
+	for (int i = 0; i < numberOfImplicitSolverTimeSteps; i++) {
+		tc = implicitSolverIntegrationStep();
+		if (tc != TC_NONE) {
+			break;
+		}
+	}
+	return tc;
+}
+
+
+void Simulation::terminate(int terminationCondition) {
+	if (rainflowCounters.size() > 0) {
+		writeResults_CouplerForceCycles();
+	}
 	closeResultsWriters(true);
-	std::cout << "Simulation has been terminated due to the maximum number of simulated seconds (" << MAX_NUMBER_OF_SIMULATED_SECONDS << " seconds) being exceeded." << std::endl;
+	// Update progress
+	if ((terminationCondition == TC_END_OF_TRACK) || (terminationCondition == TC_TRAIN_CONSIST_NOT_MOVING) || (terminationCondition == TC_MAXIMUM_SPEED_EXCEEDED)) {
+		int progress = 100;
+		std::cout << progress << "% complete" << std::endl;
+		std::cout << std::endl;
+	}
+	if (terminationCondition == TC_TIME_STEP_TOO_SMALL) {
+		std::cout << "Simulation has been terminated due to the integration time step being too small." << std::endl;
+	}
+	else if (terminationCondition == TC_EXCESSIVE_COUPLER_DISPLACEMENT) {
+		std::cout << "Simulation has been terminated due to excessive coupler displacement." << std::endl;
+	}
+	else if (terminationCondition == TC_END_OF_TRACK) {
+		std::cout << "Simulation has been terminated due to train consist reaching end of track." << std::endl;
+	}
+	else if (terminationCondition == TC_TRAIN_CONSIST_NOT_MOVING) {
+		std::cout << "Simulation has been terminated due to train consist speed being below " << APPROX_ZERO_VELOCITY_US << " miles per hour for at least " << MAX_WAIT_POSITIVE_VELOCITY << " seconds." << std::endl;
+	}
+	else if (terminationCondition == TC_MAXIMUM_SPEED_EXCEEDED) {
+		std::cout << "Simulation has been terminated due to train consist speed exceeding maximum allowable speed of " << MAX_ALLOWABLE_TRAIN_SPEED_US << " miles per hour." << std::endl;
+	}
+	else {
+		std::cout << "Simulation has been terminated due to the maximum number of simulated seconds (" << MAX_NUMBER_OF_SIMULATED_SECONDS << " seconds) being exceeded." << std::endl;
+	}
 	std::cout << std::endl;
 	std::cout << "Press Enter to end program";
 	std::cin.ignore();
@@ -602,81 +819,473 @@ void Simulation::simulate(InputFileReader_ForcedSpeed* inputFileReader_ForcedSpe
 }
 
 
+void Simulation::saveState(SimulationState* simulationState) {
+	simulationState->append(implicitSolverTime, false);
+	simulationState->append(explicitSolverTime, false);
+	simulationState->append(explicitSolverTimeStep, false);
+	simulationState->append(explicitSolverTimeLastWrittenResults, false);
+	simulationState->append(velocityApproxZeroBool, false);
+	simulationState->append(startTimeVelocityApproxZero, false);
+	simulationState->append(firstImplicitStepBool, false);
+	simulationState->append(quasiStaticBool, false);
+	simulationState->append(quasiStaticSteadyTime, false);
+	simulationState->append(stoppedTrainBool, false);
+	simulationState->append(stoppedTrainTime, false);
+	simulationState->append(inputFileReader_ForcedSpeed->curind, false);
+	inputFileReader_Simulation->userDefinedTrainConsists[0]->saveState(simulationState);
+	// Rainflow counters are saved last, since size of their state varies
+	for (size_t i = 0; i < rainflowCounters.size(); i++) {
+		rainflowCounters[i]->saveState(simulationState);
+	}
+}
+
+
+void Simulation::loadState(SimulationState* simulationState) {
+	implicitSolverTime = simulationState->next();
+	explicitSolverTime = simulationState->next();
+	explicitSolverTimeStep = simulationState->next();
+	explicitSolverTimeLastWrittenResults = simulationState->next();
+	velocityApproxZeroBool = (simulationState->next() != 0.0);
+	startTimeVelocityApproxZero = simulationState->next();
+	firstImplicitStepBool = (simulationState->next() != 0.0);
+	quasiStaticBool = (simulationState->next() != 0.0);
+	quasiStaticSteadyTime = simulationState->next();
+	stoppedTrainBool = (simulationState->next() != 0.0);
+	stoppedTrainTime = simulationState->next();
+	stoppedTrainPneumaticsSettledBool = false;
+	stoppedTrainPreviousPressures.clear();
+	inputFileReader_ForcedSpeed->curind = (int)simulationState->next();
+	inputFileReader_Simulation->userDefinedTrainConsists[0]->loadState(simulationState);
+	for (size_t i = 0; i < rainflowCounters.size(); i++) {
+		rainflowCounters[i]->loadState(simulationState);
+	}
+	// Fixed time step explicit solver does not adopt time step of state (which may have been saved by another solver)
+	if (explicitSolverType == 0) {
+		explicitSolverTimeStep = explicitSolverFixedTimeStep;
+	}
+}
+
+
+void Simulation::resetResultsWriters() {
+	if (resultsWritersCreatedBool == true) {
+		closeResultsWriters(true);
+		deleteResultsWriters();
+	}
+	initializeResultsWriters();
+	headerLabelsWrittenBool = false;
+}
+
+
+void Simulation::appendResults(Simulation* simulation) {
+	// Skip simulation if it has not written any results
+	if (simulation->headerLabelsWrittenBool == false) {
+		return;
+	}
+	simulation->closeResultsWriters(true);
+	for (size_t i = 0; i < inputFileReader_Simulation->userDefinedTrainConsists[0]->railVehicles.size(); i++) {
+		if (inputFileReader_Simulation->userDefinedTrainConsists[0]->railVehicles[i]->printResultsBool == true) {
+			appendResultsFile(inputFileReader_Simulation->userDefinedTrainConsists[0]->railVehicles[i]->resultsWriter,
+				simulation->inputFileReader_Simulation->userDefinedTrainConsists[0]->railVehicles[i]->resultsWriter);
+		}
+	}
+	appendResultsFile(resultsWriter_BrakePipes, simulation->resultsWriter_BrakePipes);
+	appendResultsFile(resultsWriter_AuxiliaryReservoirs, simulation->resultsWriter_AuxiliaryReservoirs);
+	appendResultsFile(resultsWriter_EmergencyReservoirs, simulation->resultsWriter_EmergencyReservoirs);
+	appendResultsFile(resultsWriter_CouplerForces, simulation->resultsWriter_CouplerForces);
+	appendResultsFile(resultsWriter_CouplerDisplacements, simulation->resultsWriter_CouplerDisplacements);
+	headerLabelsWrittenBool = true;
+}
+
+
+void Simulation::removeResultsFiles() {
+	if (resultsWritersCreatedBool == true) {
+		closeResultsWriters(false);
+		deleteResultsWriters();
+	}
+}
+
+
+void Simulation::updateCheckpoint() {
+	if ((implicitSolverTime - checkpointTime) < checkpointInterval) {
+		return;
+	}
+	// Restore user-defined explicit solver settings once numerical instability has been passed
+	if ((checkpointRetries > 0) && (implicitSolverTime > checkpointInstabilityTime)) {
+		explicitSolverFixedTimeStep = checkpointExplicitSolverFixedTimeStep;
+		explicitSolverMaxErrorThreshold = checkpointExplicitSolverMaxErrorThreshold;
+		explicitSolverMinTimeStep = checkpointExplicitSolverMinTimeStep;
+		explicitSolverMaxTimeStep = checkpointExplicitSolverMaxTimeStep;
+		if (explicitSolverType == 0) {
+			explicitSolverTimeStep = explicitSolverFixedTimeStep;
+		}
+		checkpointRetries = 0;
+		if (printProgressBool == true) {
+			std::cout << "Numerical instability passed at " << implicitSolverTime << " seconds.  User-defined explicit solver settings restored." << std::endl;
+			std::cout << std::endl;
+		}
+	}
+	checkpointState->capture(this);
+	checkpointTime = implicitSolverTime;
+	checkpointHeaderLabelsWrittenBool = headerLabelsWrittenBool;
+	checkpointResultsWriters();
+}
+
+
+int Simulation::rollBackToCheckpoint(int terminationCondition) {
+	if (((terminationCondition != TC_TIME_STEP_TOO_SMALL) && (terminationCondition != TC_EXCESSIVE_COUPLER_DISPLACEMENT)) ||
+		(checkpointRetries >= checkpointMaximumRetries)) {
+		return terminationCondition;
+	}
+	checkpointRetries++;
+	checkpointInstabilityTime = std::max(checkpointInstabilityTime, implicitSolverTime);
+	// Restore simulation state and output results files
+	checkpointState->restore(this);
+	headerLabelsWrittenBool = checkpointHeaderLabelsWrittenBool;
+	rollBackResultsWriters();
+	// More robust explicit solver settings
+	if (terminationCondition == TC_TIME_STEP_TOO_SMALL) {
+		// One hundredth of minimum time step, and (for variable time step explicit solver) user-defined error tolerance with half of maximum time step
+		// (a tighter error tolerance would only make time step too small sooner)
+		explicitSolverMinTimeStep = explicitSolverMinTimeStep * 0.01;
+		if (explicitSolverType == 1) {
+			explicitSolverMaxErrorThreshold = checkpointExplicitSolverMaxErrorThreshold;
+			explicitSolverMaxTimeStep = explicitSolverMaxTimeStep * 0.5;
+			if (explicitSolverTimeStep > explicitSolverMaxTimeStep) {
+				explicitSolverTimeStep = explicitSolverMaxTimeStep;
+			}
+		}
+	}
+	else if (explicitSolverType == 0) {
+		// Half time step for fixed time step explicit solver
+		explicitSolverFixedTimeStep = explicitSolverFixedTimeStep * 0.5;
+		explicitSolverTimeStep = explicitSolverFixedTimeStep;
+	}
+	else {
+		// One hundredth of error tolerance for variable time step explicit solver
+		explicitSolverMaxErrorThreshold = explicitSolverMaxErrorThreshold * 0.01;
+	}
+	if (printProgressBool == true) {
+		std::cout << "Numerical instability at " << checkpointInstabilityTime << " seconds.  Simulation rolled back to " << checkpointTime << " seconds (retry " << checkpointRetries << 
+			" of " << checkpointMaximumRetries << ")";
+		if (terminationCondition == TC_TIME_STEP_TOO_SMALL) {
+			std::cout << " with minimum explicit solver time step of " << explicitSolverMinTimeStep << " seconds";
+			if (explicitSolverType == 1) {
+				std::cout << " and maximum explicit solver time step of " << explicitSolverMaxTimeStep << " seconds";
+			}
+			std::cout << "." << std::endl;
+		}
+		else if (explicitSolverType == 0) {
+			std::cout << " with explicit solver time step of " << explicitSolverFixedTimeStep << " seconds." << std::endl;
+		}
+		else {
+			std::cout << " with explicit solver error tolerance of " << explicitSolverMaxErrorThreshold << "." << std::endl;
+		}
+		std::cout << std::endl;
+	}
+	return TC_NONE;
+}
+
+
 bool Simulation::explicitSolverIntegrationStep() {
 	double tcs = inputFileReader_Simulation->userDefinedTrainConsists[0]->railVehicles[0]->ssv[1];  // train consist speed
 	double curr_est_err = 0.0;  // current estimated error
 	// Loop through RK4 or RKF45 algorithm steps and loop through state space components
 	do {
-		if ((explicitSolverTimeStep < EXPLICIT_SOLVER_MIN_TIME_STEP)) {
+		if ((explicitSolverTimeStep < explicitSolverMinTimeStep)) {
 			return true;
 		}
-		for (int l = 0; l < explicitSolverNumSteps; l++) {
-			// Update explicit solver step index
-			explicitSolverStepIndex = l;
-			// Calculate state space variables
-			for (size_t i = 0; i < inputFileReader_Simulation->userDefinedTrainConsists[0]->railVehicles.size(); i++) {
-				inputFileReader_Simulation->userDefinedTrainConsists[0]->railVehicles[i]->calc_ssvApp(inputFileReader_Simulation);
-			}
-			// Calculate force on leading rail vehicle
-			for (size_t i = 0; i < inputFileReader_Simulation->userDefinedTrainConsists[0]->couplingSystems.size(); i++) {
-				inputFileReader_Simulation->userDefinedTrainConsists[0]->couplingSystems[i]->calc_centerToCenterDistance(false);
-				inputFileReader_Simulation->userDefinedTrainConsists[0]->couplingSystems[i]->calc_displacement();
-				inputFileReader_Simulation->userDefinedTrainConsists[0]->couplingSystems[i]->calc_totalForceOnLeadingRailVehicle();  // also updates coupler displacements
-			}
-			// Calculate tangential component of leading and trailing coupler for each rail vehicle
-			for (size_t i = 0; i < inputFileReader_Simulation->userDefinedTrainConsists[0]->railVehicles.size(); i++) {
-				inputFileReader_Simulation->userDefinedTrainConsists[0]->railVehicles[i]->calc_tangentialForceDueToLeadingCoupler();
-				inputFileReader_Simulation->userDefinedTrainConsists[0]->railVehicles[i]->calc_tangentialForceDueToTrailingCoupler();
-			}
-			// Calculate state space variable rates of change
-			for (size_t i = 0; i < inputFileReader_Simulation->userDefinedTrainConsists[0]->railVehicles.size(); i++) {
-				inputFileReader_Simulation->userDefinedTrainConsists[0]->railVehicles[i]->calc_ssvDot();
-			}
-			// Calculate k values for current algorithm step (to be used in next algorithm step)
-			for (size_t i = 0; i < inputFileReader_Simulation->userDefinedTrainConsists[0]->railVehicles.size(); i++) {
-				inputFileReader_Simulation->userDefinedTrainConsists[0]->railVehicles[i]->calc_kVals();
-			}
-			// Calculate result and error
-			if (l == (explicitSolverNumSteps - 1)) {
+		// Blocks of rail vehicles are integrated concurrently for domain decomposition
+		// (state space variables are updated in same pass for fixed time step explicit solver, since time step is never revised)
+		if (domainDecomposition != NULL) {
+			curr_est_err = domainDecomposition->calc_explicitSolverSteps(explicitSolverType == 0);
+		}
+		else {
+			for (int l = 0; l < explicitSolverNumSteps; l++) {
+				// Update explicit solver step index
+				explicitSolverStepIndex = l;
+				// Calculate state space variables
 				for (size_t i = 0; i < inputFileReader_Simulation->userDefinedTrainConsists[0]->railVehicles.size(); i++) {
-					inputFileReader_Simulation->userDefinedTrainConsists[0]->railVehicles[i]->calc_res4();
-					if (explicitSolverType == 1) {
-						// Rail vehicle error
-						inputFileReader_Simulation->userDefinedTrainConsists[0]->railVehicles[i]->calc_res5();
-						curr_est_err = inputFileReader_Simulation->userDefinedTrainConsists[0]->railVehicles[i]->calc_ee();
-						if (curr_est_err > EXPLICIT_SOLVER_MAX_ERROR_THRESHOLD) {
-							break;
+					inputFileReader_Simulation->userDefinedTrainConsists[0]->railVehicles[i]->calc_ssvApp(inputFileReader_Simulation);
+				}
+				// Calculate force on leading rail vehicle
+				inputFileReader_Simulation->userDefinedTrainConsists[0]->couplingSystemBatch->calc_totalForcesOnLeadingRailVehicles(0, inputFileReader_Simulation->userDefinedTrainConsists[0]->couplingSystems.size(), false);  // also updates coupler displacements
+				// Calculate tangential component of leading and trailing coupler for each rail vehicle
+				for (size_t i = 0; i < inputFileReader_Simulation->userDefinedTrainConsists[0]->railVehicles.size(); i++) {
+					inputFileReader_Simulation->userDefinedTrainConsists[0]->railVehicles[i]->calc_tangentialForceDueToLeadingCoupler();
+					inputFileReader_Simulation->userDefinedTrainConsists[0]->railVehicles[i]->calc_tangentialForceDueToTrailingCoupler();
+				}
+				// Calculate state space variable rates of change
+				for (size_t i = 0; i < inputFileReader_Simulation->userDefinedTrainConsists[0]->railVehicles.size(); i++) {
+					inputFileReader_Simulation->userDefinedTrainConsists[0]->railVehicles[i]->calc_ssvDot();
+				}
+				// Calculate k values for current algorithm step (to be used in next algorithm step)
+				for (size_t i = 0; i < inputFileReader_Simulation->userDefinedTrainConsists[0]->railVehicles.size(); i++) {
+					inputFileReader_Simulation->userDefinedTrainConsists[0]->railVehicles[i]->calc_kVals();
+				}
+				// Calculate result and error
+				if (l == (explicitSolverNumSteps - 1)) {
+					for (size_t i = 0; i < inputFileReader_Simulation->userDefinedTrainConsists[0]->railVehicles.size(); i++) {
+						inputFileReader_Simulation->userDefinedTrainConsists[0]->railVehicles[i]->calc_res4();
+						if (explicitSolverType == 1) {
+							// Rail vehicle error
+							inputFileReader_Simulation->userDefinedTrainConsists[0]->railVehicles[i]->calc_res5();
+							curr_est_err = inputFileReader_Simulation->userDefinedTrainConsists[0]->railVehicles[i]->calc_ee();
+							if (curr_est_err > explicitSolverMaxErrorThreshold) {
+								break;
+							}
 						}
 					}
 				}
 			}
 		}
 		// Calculate revised time step, if necessary
-		if ((explicitSolverType == 1) && (curr_est_err > EXPLICIT_SOLVER_MAX_ERROR_THRESHOLD)) {
+		if ((explicitSolverType == 1) && (curr_est_err > explicitSolverMaxErrorThreshold)) {
 			explicitSolverTimeStep = explicitSolverTimeStep * 0.75;
 		}
-	} while (curr_est_err > EXPLICIT_SOLVER_MAX_ERROR_THRESHOLD);
+	} while (curr_est_err > explicitSolverMaxErrorThreshold);
 	// Update current time
 	explicitSolverTime = explicitSolverTime + explicitSolverTimeStep;
 	// Update state space variables
-	for (size_t i = 0; i < inputFileReader_Simulation->userDefinedTrainConsists[0]->railVehicles.size(); i++) {
-		inputFileReader_Simulation->userDefinedTrainConsists[0]->railVehicles[i]->update_ssv();
+	if (domainDecomposition == NULL) {
+		for (size_t i = 0; i < inputFileReader_Simulation->userDefinedTrainConsists[0]->railVehicles.size(); i++) {
+			inputFileReader_Simulation->userDefinedTrainConsists[0]->railVehicles[i]->update_ssv();
+		}
+	}
+	else if (explicitSolverType == 1) {
+		domainDecomposition->update_ssv();
 	}
 	// Calculate time step for next integration iteration
 	if (explicitSolverType == 1) {
 		explicitSolverTimeStep = explicitSolverTimeStep * 1.25;
-		if (explicitSolverTimeStep > EXPLICIT_SOLVER_MAX_TIME_STEP) {
-			explicitSolverTimeStep = EXPLICIT_SOLVER_MAX_TIME_STEP;
+		if (explicitSolverTimeStep > explicitSolverMaxTimeStep) {
+			explicitSolverTimeStep = explicitSolverMaxTimeStep;
 		}
 	}
 	else {
-		explicitSolverTimeStep = EXPLICIT_SOLVER_FIXED_TIME_STEP;
+		explicitSolverTimeStep = explicitSolverFixedTimeStep;
 	}
 	// Return 'false'
 	return false;
 }
 
 
+void Simulation::quasiStaticIntegrationStep() {
+	double dt = calc_macroTimeStep();  // time step
+	// Speed and acceleration of train consist
+	double tcmom = 0.0;  // train consist momentum
+	double tctf = 0.0;  // train consist total tangential force
+	double tcm = 0.0;  // train consist mass
+	for (size_t i = 0; i < inputFileReader_Simulation->userDefinedTrainConsists[0]->railVehicles.size(); i++) {
+		inputFileReader_Simulation->userDefinedTrainConsists[0]->railVehicles[i]->calc_totalTangentialForce();
+		tcmom = tcmom + (inputFileReader_Simulation->userDefinedTrainConsists[0]->railVehicles[i]->mass * inputFileReader_Simulation->userDefinedTrainConsists[0]->railVehicles[i]->ssv[1]);
+		tctf = tctf + inputFileReader_Simulation->userDefinedTrainConsists[0]->railVehicles[i]->totalTangentialForce;
+		tcm = tcm + inputFileReader_Simulation->userDefinedTrainConsists[0]->railVehicles[i]->mass;
+	}
+	double tcs = tcmom / tcm;  // train consist speed
+	double tca = tctf / tcm;  // train consist acceleration
+	// Update current time
+	explicitSolverTime = explicitSolverTime + dt;
+	// Update state space variables (every rail vehicle has same speed and acceleration, so coupler displacements do not change)
+	for (size_t i = 0; i < inputFileReader_Simulation->userDefinedTrainConsists[0]->railVehicles.size(); i++) {
+		inputFileReader_Simulation->userDefinedTrainConsists[0]->railVehicles[i]->ssv[0] = inputFileReader_Simulation->userDefinedTrainConsists[0]->railVehicles[i]->ssv[0] +
+			(tcs * dt) + (0.5 * tca * dt * dt);
+		inputFileReader_Simulation->userDefinedTrainConsists[0]->railVehicles[i]->ssv[1] = tcs + (tca * dt);
+	}
+}
+
+
+void Simulation::calc_quasiStaticMode() {
+	if (quasiStaticSteppingBool == false) {
+		return;
+	}
+	if (checkTrainConsistIsSteady() == false) {
+		quasiStaticBool = false;
+		quasiStaticSteadyTime = 0.0;
+	}
+	else if (quasiStaticBool == false) {
+		quasiStaticSteadyTime = quasiStaticSteadyTime + IMPLICIT_SOLVER_FIXED_TIME_STEP;
+		if (quasiStaticSteadyTime >= quasiStaticSettlingTime) {
+			quasiStaticBool = true;
+		}
+	}
+}
+
+
+bool Simulation::checkTrainConsistIsSteady() {
+	// Train consist must be moving
+	double tcs = inputFileReader_Simulation->userDefinedTrainConsists[0]->railVehicles[0]->ssv[1];  // train consist speed
+	if (std::abs(tcs) < APPROX_ZERO_VELOCITY) {
+		return false;
+	}
+	// Acceleration of train consist
+	double tctf = 0.0;  // train consist total tangential force
+	double tcm = 0.0;  // train consist mass
+	for (size_t i = 0; i < inputFileReader_Simulation->userDefinedTrainConsists[0]->railVehicles.size(); i++) {
+		inputFileReader_Simulation->userDefinedTrainConsists[0]->railVehicles[i]->calc_totalTangentialForce();
+		tctf = tctf + inputFileReader_Simulation->userDefinedTrainConsists[0]->railVehicles[i]->totalTangentialForce;
+		tcm = tcm + inputFileReader_Simulation->userDefinedTrainConsists[0]->railVehicles[i]->mass;
+	}
+	double tca = tctf / tcm;  // train consist acceleration
+	// Every rail vehicle must move at speed of train consist with acceleration of train consist (i.e., couplers at force equilibrium)
+	for (size_t i = 0; i < inputFileReader_Simulation->userDefinedTrainConsists[0]->railVehicles.size(); i++) {
+		if (std::abs(inputFileReader_Simulation->userDefinedTrainConsists[0]->railVehicles[i]->ssv[1] - tcs) > quasiStaticVelocityTolerance) {
+			return false;
+		}
+		if (std::abs((inputFileReader_Simulation->userDefinedTrainConsists[0]->railVehicles[i]->totalTangentialForce /
+			inputFileReader_Simulation->userDefinedTrainConsists[0]->railVehicles[i]->mass) - tca) > quasiStaticAccelerationTolerance) {
+			return false;
+		}
+	}
+	return true;
+}
+
+
+void Simulation::stoppedTrainIntegrationStep() {
+	// Update current time (state space variables are frozen)
+	explicitSolverTime = explicitSolverTime + calc_macroTimeStep();
+}
+
+
+double Simulation::calc_macroTimeStep() {
+	// Time of next sample (smallest time for which results are written)
+	double tns = explicitSolverTimeLastWrittenResults + (1.0 / sampleRate);  // time of next sample
+	while ((tns - explicitSolverTimeLastWrittenResults) < (1.0 / sampleRate)) {
+		tns = std::nextafter(tns, 2.0 * tns);
+	}
+	// Time step ends at next implicit solver time or at next sample, whichever comes first
+	double dt = implicitSolverTime - explicitSolverTime;
+	if ((tns - explicitSolverTime) < dt) {
+		dt = tns - explicitSolverTime;
+	}
+	if (dt < 0.0) {
+		dt = 0.0;
+	}
+	return dt;
+}
+
+
+void Simulation::calc_stoppedTrainMode() {
+	if (stoppedTrainFastForwardBool == false) {
+		return;
+	}
+	if (checkTrainConsistIsHeld() == false) {
+		stoppedTrainBool = false;
+		stoppedTrainTime = 0.0;
+		stoppedTrainPneumaticsSettledBool = false;
+		stoppedTrainPreviousPressures.clear();
+		return;
+	}
+	if (stoppedTrainBool == false) {
+		stoppedTrainTime = stoppedTrainTime + IMPLICIT_SOLVER_FIXED_TIME_STEP;
+		if (stoppedTrainTime >= STOPPED_TRAIN_SETTLING_TIME) {
+			// Freeze train consist dynamics
+			stoppedTrainBool = true;
+			for (size_t i = 0; i < inputFileReader_Simulation->userDefinedTrainConsists[0]->railVehicles.size(); i++) {
+				inputFileReader_Simulation->userDefinedTrainConsists[0]->railVehicles[i]->ssv[1] = 0.0;
+			}
+		}
+	}
+	stoppedTrainPneumaticsSettledBool = checkPneumaticsAreSettled();
+}
+
+
+bool Simulation::checkTrainConsistIsHeld() {
+	double tcdf = 0.0;  // train consist resting driving force
+	double tchf = 0.0;  // train consist resting holding force
+	for (size_t i = 0; i < inputFileReader_Simulation->userDefinedTrainConsists[0]->railVehicles.size(); i++) {
+		if (std::abs(inputFileReader_Simulation->userDefinedTrainConsists[0]->railVehicles[i]->ssv[1]) >= APPROX_ZERO_VELOCITY) {
+			return false;
+		}
+		inputFileReader_Simulation->userDefinedTrainConsists[0]->railVehicles[i]->calc_restingForces();
+		tcdf = tcdf + inputFileReader_Simulation->userDefinedTrainConsists[0]->railVehicles[i]->restingDrivingForce;
+		tchf = tchf + inputFileReader_Simulation->userDefinedTrainConsists[0]->railVehicles[i]->restingHoldingForce;
+	}
+	return (std::abs(tcdf) < tchf);
+}
+
+
+bool Simulation::checkPneumaticsAreSettled() {
+	// Current brake pipe, reservoir, and brake cylinder pressures
+	std::vector<double> cp;  // current pressures
+	for (size_t i = 0; i < inputFileReader_Simulation->userDefinedTrainConsists[0]->railVehicles.size(); i++) {
+		cp.push_back(inputFileReader_Simulation->userDefinedTrainConsists[0]->railVehicles[i]->brakePipeAirPressure);
+		cp.push_back(inputFileReader_Simulation->userDefinedTrainConsists[0]->railVehicles[i]->brakeCylinder->pressure);
+		if (inputFileReader_Simulation->userDefinedTrainConsists[0]->railVehicleTypes[i] == 0) {
+			cp.push_back(((Car*)inputFileReader_Simulation->userDefinedTrainConsists[0]->railVehicles[i])->auxiliaryReservoir->pressure);
+			cp.push_back(((Car*)inputFileReader_Simulation->userDefinedTrainConsists[0]->railVehicles[i])->emergencyReservoir->pressure);
+		}
+	}
+	// Compare with pressures of previous implicit solver time step
+	bool psb = (cp.size() == stoppedTrainPreviousPressures.size());  // pneumatics settled boolean
+	for (size_t i = 0; (psb == true) && (i < cp.size()); i++) {
+		if (std::abs(cp[i] - stoppedTrainPreviousPressures[i]) > STOPPED_TRAIN_PRESSURE_TOLERANCE) {
+			psb = false;
+		}
+	}
+	stoppedTrainPreviousPressures = cp;
+	return psb;
+}
+
+
+void Simulation::fastForwardStoppedTrain() {
+	if (velocityApproxZeroBool == false) {
+		return;
+	}
+	// End of fast-forward (time of next event that could change state of train consist)
+	double tff = startTimeVelocityApproxZero + MAX_WAIT_POSITIVE_VELOCITY;  // time of end of fast-forward
+	if (tff > MAX_NUMBER_OF_SIMULATED_SECONDS) {
+		tff = MAX_NUMBER_OF_SIMULATED_SECONDS;
+	}
+	// Next change in time-based locomotive operator input (distance-based locomotive operator input does not change while train consist is at rest)
+	for (size_t i = 0; i < inputFileReader_Simulation->userDefinedTrainConsists[0]->locomotives.size(); i++) {
+		if (inputFileReader_Simulation->userDefinedTrainConsists[0]->locomotives[i]->locomotiveOperator->DISTANCE_VS_TIME_INDICATOR == 1) {
+			double eci = inputFileReader_Simulation->userDefinedTrainConsists[0]->locomotives[i]->locomotiveOperator->calc_endOfConstantInput(explicitSolverTime);  // end of constant input
+			if (eci < tff) {
+				tff = eci;
+			}
+		}
+	}
+	// Next time-based forced speed
+	if ((inputFileReader_ForcedSpeed->inputFileExistsBool == true) && (inputFileReader_ForcedSpeed->totalNumberOfForcedSpeeds > 0) && (inputFileReader_ForcedSpeed->DBTBIFS == 1)) {
+		if (inputFileReader_ForcedSpeed->curind < (inputFileReader_ForcedSpeed->totalNumberOfForcedSpeeds - 1)) {
+			if (inputFileReader_ForcedSpeed->fsiv[inputFileReader_ForcedSpeed->curind + 1] < tff) {
+				tff = inputFileReader_ForcedSpeed->fsiv[inputFileReader_ForcedSpeed->curind + 1];
+			}
+		}
+	}
+	// Skip implicit solver time steps (last implicit solver time step before end of fast-forward is simulated)
+	int nff = (int)((tff - implicitSolverTime) / IMPLICIT_SOLVER_FIXED_TIME_STEP) - 1;  // number of implicit solver time steps to fast-forward
+	for (int i = 0; i < nff; i++) {
+		implicitSolverTime = implicitSolverTime + IMPLICIT_SOLVER_FIXED_TIME_STEP;
+		do {
+			stoppedTrainIntegrationStep();
+			writeSampledResults();
+		} while (explicitSolverTime < implicitSolverTime);
+		updateProgress();
+	}
+}
+
+
+void Simulation::writeSampledResults() {
+	if ((explicitSolverTime - explicitSolverTimeLastWrittenResults) >= (1.0 / sampleRate)) {
+		explicitSolverTimeLastWrittenResults = explicitSolverTime;
+		if (writeResultsBool == true) {
+			writeResults();
+		}
+	}
+}
+
+
+void Simulation::updateProgress() {
+	if ((printProgressBool == true) && ((implicitSolverTime - implicitSolverTimeOfPreviousProgressUpdate) >= ELAPSED_TIME_FOR_UPDATE_PROGRESS)) {
+		int progress = (int)((implicitSolverTime / MAX_NUMBER_OF_SIMULATED_SECONDS) * 100.0);
+		std::cout << progress << "% complete" << std::endl;
+		std::cout << std::endl;
+		implicitSolverTimeOfPreviousProgressUpdate = implicitSolverTime;
+	}
+}
+
+
 void Simulation::calc_explicitSolverNumSteps() {
 	if (explicitSolverType == 0) {
 		explicitSolverNumSteps = 4;
@@ -845,6 +1454,12 @@ void Simulation::loadPhysicalConstantAlternateNames() {
 }
 
 
+std::string Simulation::calc_companionFilePath(std::string suffix) {
+	std::string ifap = inputFileReader_Simulation->inputFileAbsolutePath;  // input file absolute path
+	return ifap.substr(0, ifap.find_last_of(".")) + suffix;
+}
+
+
 void Simulation::placeTrainConsistOnTrack() {
 	double cp = 0.0;  // current position
 	for (int i = (inputFileReader_Simulation->userDefinedTrainConsists[0]->railVehicles.size() - 1); i >= 0; i--) {
@@ -881,10 +1496,6 @@ bool Simulation::checkTrainConsistIsOnTrack() {
 	double tvlen;  // trailing vehicle length
 	tvlen = inputFileReader_Simulation->userDefinedTrainConsists[0]->railVehicles[nrvs - 1]->length;
 	if (((lvloc + (lvlen / 2.0)) > tel) || ((tvloc - (tvlen / 2.0)) < tsl)) {
-		// Update progress
-		int progress = 100;
-		std::cout << progress << "% complete" << std::endl;
-		std::cout << std::endl;
 		return false;
 	}
 	else {
@@ -896,10 +1507,6 @@ bool Simulation::checkTrainConsistIsOnTrack() {
 bool Simulation::checkTrainConsistIsMoving() {
 	if ((velocityApproxZeroBool == true) && (inputFileReader_Simulation->userDefinedTrainConsists[0]->railVehicles[0]->ssv[1] < APPROX_ZERO_VELOCITY)) {
 		if ((explicitSolverTime - startTimeVelocityApproxZero) > MAX_WAIT_POSITIVE_VELOCITY) {
-			// Update progress
-			int progress = 100;
-			std::cout << progress << "% complete" << std::endl;
-			std::cout << std::endl;
 			return false;
 		}
 	}
@@ -917,10 +1524,6 @@ bool Simulation::checkTrainConsistIsMoving() {
 
 bool Simulation::checkTrainSpeedIsUnderMaximumAllowableSpeed() {
 	if (inputFileReader_Simulation->userDefinedTrainConsists[0]->railVehicles[0]->ssv[1] > MAX_ALLOWABLE_TRAIN_SPEED) {
-		// Update progress
-		int progress = 100;
-		std::cout << progress << "% complete" << std::endl;
-		std::cout << std::endl;
 		return false;
 	}
 	else {
@@ -929,6 +1532,23 @@ bool Simulation::checkTrainSpeedIsUnderMaximumAllowableSpeed() {
 }
 
 
+void Simulation::writeResults() {
+	bool whb = (headerLabelsWrittenBool == false);  // write headers boolean
+	for (size_t i = 0; i < inputFileReader_Simulation->userDefinedTrainConsists[0]->railVehicles.size(); i++) {
+		if (inputFileReader_Simulation->userDefinedTrainConsists[0]->railVehicles[i]->printResultsBool == true) {
+			inputFileReader_Simulation->userDefinedTrainConsists[0]->railVehicles[i]->calc_trackForcesAndLOverV();
+			inputFileReader_Simulation->userDefinedTrainConsists[0]->railVehicles[i]->results(this, whb);
+		}
+	}
+	writeResults_BrakePipePressures(whb);
+	writeResults_AuxiliaryReservoirPressures(whb);
+	writeResults_EmergencyReservoirPressures(whb);
+	writeResults_CouplerForces(whb);
+	writeResults_CouplerDisplacements(whb);
+	headerLabelsWrittenBool = true;
+}
+
+
 void Simulation::writeResults_BrakePipePressures(bool whb) {
 	if (whb == true) {
 		std::vector<std::string> headers_BrakePipes;
@@ -1075,6 +1695,63 @@ void Simulation::writeResults_CouplerDisplacements(bool whb) {
 }
 
 
+void Simulation::countCouplerForceCycles() {
+	for (size_t i = 0; i < rainflowCounters.size(); i++) {
+		rainflowCounters[i]->add(UnitConverter::n_To_Lb(inputFileReader_Simulation->userDefinedTrainConsists[0]->couplingSystems[i]->totalForceOnLeadingRailVehicle));
+	}
+}
+
+
+void Simulation::writeResults_CouplerForceCycles() {
+	ResultsWriter* resultsWriter_CouplerForceCycles = new ResultsWriter(inputFileReader_Simulation->inputFileDirectoryPath + "/" + inputFileReader_Simulation->inputFileName + 
+		"_coupler_force_cycles.csv", false);
+	for (size_t i = 0; i < rainflowCounters.size(); i++) {
+		rainflowCounters[i]->calc_cycles();
+	}
+	// Headers (coupling systems are in same order as in coupler force results)
+	std::vector<std::string> headers_CouplerForceCycles;
+	headers_CouplerForceCycles.push_back("Force range lower bound (pounds)");
+	for (int i = ((int)rainflowCounters.size() - 1); i >= 0; i--) {
+		if (inputFileReader_Simulation->userDefinedTrainConsists[0]->railVehicleTypes[i] == 0) {
+			headers_CouplerForceCycles.push_back(std::to_string(i + 1) + std::string(". Car trailing coupler cycles"));
+		}
+		else {
+			headers_CouplerForceCycles.push_back(std::to_string(i + 1) + std::string(". Locomotive trailing coupler cycles"));
+		}
+	}
+	resultsWriter_CouplerForceCycles->writeLine(headers_CouplerForceCycles);
+	// Cycle histograms (one line per cycle range bin)
+	for (int j = 0; j < rainflowNumberOfBins; j++) {
+		std::vector<std::string> results_CouplerForceCycles;
+		results_CouplerForceCycles.push_back(std::to_string(j * rainflowBinWidth));
+		for (int i = ((int)rainflowCounters.size() - 1); i >= 0; i--) {
+			results_CouplerForceCycles.push_back(std::to_string(rainflowCounters[i]->cycles[j]));
+		}
+		resultsWriter_CouplerForceCycles->writeLine(results_CouplerForceCycles);
+	}
+	// Damage sums
+	if (rainflowDamageExponent > 0.0) {
+		std::vector<std::string> results_CouplerForceDamage;
+		results_CouplerForceDamage.push_back("Damage");
+		for (int i = ((int)rainflowCounters.size() - 1); i >= 0; i--) {
+			results_CouplerForceDamage.push_back(std::to_string(rainflowCounters[i]->damage));
+		}
+		resultsWriter_CouplerForceCycles->writeLine(results_CouplerForceDamage);
+	}
+	resultsWriter_CouplerForceCycles->ofs->flush();
+	resultsWriter_CouplerForceCycles->ofs->close();
+	delete resultsWriter_CouplerForceCycles;
+}
+
+
+void Simulation::deleteRainflowCounters() {
+	for (size_t i = 0; i < rainflowCounters.size(); i++) {
+		delete rainflowCounters[i];
+	}
+	rainflowCounters.clear();
+}
+
+
 void Simulation::initializeResultsWriters() {
 	for (size_t i = 0; i <= (inputFileReader_Simulation->userDefinedTrainConsists[0]->railVehicles.size() - 1); i++) {
 		if (inputFileReader_Simulation->userDefinedTrainConsists[0]->railVehicles[i]->printResultsBool == true) {
@@ -1086,10 +1763,74 @@ void Simulation::initializeResultsWriters() {
 	resultsWriter_EmergencyReservoirs = new ResultsWriter(inputFileReader_Simulation->inputFileDirectoryPath + "/" + inputFileReader_Simulation->inputFileName + "_emergency_reservoir_pressures.csv", false);
 	resultsWriter_CouplerForces = new ResultsWriter(inputFileReader_Simulation->inputFileDirectoryPath + "/" + inputFileReader_Simulation->inputFileName + "_coupler_forces.csv", false);
 	resultsWriter_CouplerDisplacements = new ResultsWriter(inputFileReader_Simulation->inputFileDirectoryPath + "/" + inputFileReader_Simulation->inputFileName + "_coupler_displacements.csv", false);
+	resultsWritersCreatedBool = true;
+}
+
+
+void Simulation::deleteResultsWriters() {
+	for (size_t i = 0; i < inputFileReader_Simulation->userDefinedTrainConsists[0]->railVehicles.size(); i++) {
+		if (inputFileReader_Simulation->userDefinedTrainConsists[0]->railVehicles[i]->printResultsBool == true) {
+			delete inputFileReader_Simulation->userDefinedTrainConsists[0]->railVehicles[i]->resultsWriter;
+			inputFileReader_Simulation->userDefinedTrainConsists[0]->railVehicles[i]->resultsWriter = NULL;
+		}
+	}
+	delete resultsWriter_BrakePipes;
+	delete resultsWriter_AuxiliaryReservoirs;
+	delete resultsWriter_EmergencyReservoirs;
+	delete resultsWriter_CouplerForces;
+	delete resultsWriter_CouplerDisplacements;
+	resultsWritersCreatedBool = false;
+}
+
+
+void Simulation::appendResultsFile(ResultsWriter* resultsWriter, ResultsWriter* resultsWriter_Window) {
+	std::ifstream ifs(resultsWriter_Window->fp);
+	std::string line;
+	bool firstLineBool = true;
+	while (std::getline(ifs, line)) {
+		// Header labels are only written once
+		if ((firstLineBool == false) || (headerLabelsWrittenBool == false)) {
+			*(resultsWriter->ofs) << line << std::endl;
+		}
+		firstLineBool = false;
+	}
+	ifs.close();
+}
+
+
+void Simulation::checkpointResultsWriters() {
+	for (size_t i = 0; i < inputFileReader_Simulation->userDefinedTrainConsists[0]->railVehicles.size(); i++) {
+		if (inputFileReader_Simulation->userDefinedTrainConsists[0]->railVehicles[i]->printResultsBool == true) {
+			inputFileReader_Simulation->userDefinedTrainConsists[0]->railVehicles[i]->resultsWriter->checkpoint();
+		}
+	}
+	resultsWriter_BrakePipes->checkpoint();
+	resultsWriter_AuxiliaryReservoirs->checkpoint();
+	resultsWriter_EmergencyReservoirs->checkpoint();
+	resultsWriter_CouplerForces->checkpoint();
+	resultsWriter_CouplerDisplacements->checkpoint();
+}
+
+
+void Simulation::rollBackResultsWriters() {
+	for (size_t i = 0; i < inputFileReader_Simulation->userDefinedTrainConsists[0]->railVehicles.size(); i++) {
+		if (inputFileReader_Simulation->userDefinedTrainConsists[0]->railVehicles[i]->printResultsBool == true) {
+			inputFileReader_Simulation->userDefinedTrainConsists[0]->railVehicles[i]->resultsWriter->rollBack();
+		}
+	}
+	resultsWriter_BrakePipes->rollBack();
+	resultsWriter_AuxiliaryReservoirs->rollBack();
+	resultsWriter_EmergencyReservoirs->rollBack();
+	resultsWriter_CouplerForces->rollBack();
+	resultsWriter_CouplerDisplacements->rollBack();
 }
 
 
 void Simulation::closeResultsWriters(bool simulationSuccessfulBool) {
+	// Results written since last checkpoint
+	if (checkpointState != NULL) {
+		checkpointResultsWriters();
+	}
 	for (size_t i = 0; i < inputFileReader_Simulation->userDefinedTrainConsists[0]->railVehicles.size(); i++) {
 		if (inputFileReader_Simulation->userDefinedTrainConsists[0]->railVehicles[i]->printResultsBool == true) {
 			inputFileReader_Simulation->userDefinedTrainConsists[0]->railVehicles[i]->resultsWriter->ofs->flush();
@@ -6,12 +6,17 @@
 #define SIMULATION_DEF
 
 #include <string>
+#include <vector>
 #include "UserDefinedRRComponent.h"
 #include "UnitConverter.h"
 
+class DomainDecomposition;
 class InputFileReader_ForcedSpeed;
 class InputFileReader_Simulation;
+class InputFileReader_SolverSettings;
+class RainflowCounter;
 class ResultsWriter;
+class SimulationState;
 
 class Simulation : public UserDefinedRRComponent {
 
@@ -30,6 +35,15 @@ public:
 	// Fixed time step (seconds) for implicit solver
 	const double IMPLICIT_SOLVER_FIXED_TIME_STEP = 0.02;
 
+	// Termination conditions (returned by 'implicitSolverIntegrationStep' method)
+	static constexpr int TC_NONE = 0;  // simulation not terminated
+	static constexpr int TC_TIME_STEP_TOO_SMALL = 1;  // integration time step too small
+	static constexpr int TC_EXCESSIVE_COUPLER_DISPLACEMENT = 2;  // excessive coupler displacement
+	static constexpr int TC_END_OF_TRACK = 3;  // train consist reached end of track
+	static constexpr int TC_TRAIN_CONSIST_NOT_MOVING = 4;  // train consist not moving
+	static constexpr int TC_MAXIMUM_SPEED_EXCEEDED = 5;  // maximum allowable speed exceeded
+	static constexpr int TC_MAXIMUM_SIMULATED_SECONDS = 6;  // maximum number of simulated seconds exceeded
+
 	// Current simulation time for implicit solver (seconds)
 	double implicitSolverTime;
 
@@ -42,6 +56,26 @@ public:
 	// Explicit solver integration type ('0' for fixed time step; '1' for variable time step)
 	int explicitSolverType;
 
+	// Fixed time step (seconds) for fixed time step explicit solver
+	// (defaults to 'EXPLICIT_SOLVER_FIXED_TIME_STEP'; coarse propagators use a larger time step)
+	double explicitSolverFixedTimeStep;
+
+	// Maximum error tolerance for variable time step explicit solver
+	// (defaults to 'EXPLICIT_SOLVER_MAX_ERROR_THRESHOLD'; may be revised by solver settings calibration)
+	double explicitSolverMaxErrorThreshold;
+
+	// Minimum time step (seconds) of explicit solver
+	// (defaults to 'EXPLICIT_SOLVER_MIN_TIME_STEP'; lowered while retrying after time step became too small)
+	double explicitSolverMinTimeStep;
+
+	// Maximum time step (seconds) for variable time step explicit solver
+	// (defaults to 'EXPLICIT_SOLVER_MAX_TIME_STEP'; lowered while retrying after time step became too small)
+	double explicitSolverMaxTimeStep;
+
+	// Maximum number of rail vehicles per brake pipe finite element
+	// (defaults to 'BrakePipe_FiniteElement::MAX_RAIL_VEHICLES_PER_BRAKE_PIPE_FE'; may be revised by solver settings calibration)
+	int brakePipeFiniteElementSize;
+
 	// Number of steps for explicit solver
 	int explicitSolverNumSteps;
 
@@ -51,13 +85,107 @@ public:
 	// Sampling rate (hertz)
 	int sampleRate;
 
+	// Print progress boolean
+	bool printProgressBool;
+
+	// Quasi-static stepping boolean (if 'true', then train consist is advanced as a rigid body during steady running)
+	bool quasiStaticSteppingBool;
+
+	// Quasi-static stepping velocity tolerance (meters / second)
+	double quasiStaticVelocityTolerance;
+
+	// Quasi-static stepping acceleration tolerance (meters / second^2)
+	double quasiStaticAccelerationTolerance;
+
+	// Quasi-static stepping settling time (seconds)
+	double quasiStaticSettlingTime;
+
+	// Stopped train fast-forward boolean 
+	// (if 'true', then dynamics are frozen while train consist is held at rest by brakes, and simulation skips ahead to next event once pneumatics are settled)
+	bool stoppedTrainFastForwardBool;
+
+	// Checkpoint interval (seconds) 
+	// (simulated time between rolling in-memory checkpoints of simulation state; '0' for no checkpoints)
+	double checkpointInterval;
+
+	// Maximum number of consecutive retries after numerical instability
+	int checkpointMaximumRetries;
+
+	// Number of coupler force cycle range bins for rainflow counting ('0' for no rainflow counting)
+	int rainflowNumberOfBins;
+
+	// Width of coupler force cycle range bins (pounds)
+	double rainflowBinWidth;
+
+	// Exponent of coupler S-N curve for damage sum ('0' for no damage sum)
+	double rainflowDamageExponent;
+
+	// Coefficient of coupler S-N curve for damage sum (cycles to failure at coupler force range of one pound)
+	double rainflowDamageCoefficient;
+
+	// Resolution of track function lookup tables (meters) ('0' for no lookup tables)
+	double trackTableResolution;
+
+	// Maximum memory of track function lookup tables (bytes)
+	double trackTableMaxMemory;
+
+	// Binary track database boolean ('true' if track properties are read from binary track database)
+	bool trackDatabaseBool;
+
+	// Resolution of binary track database converted from track functions (meters)
+	double trackDatabaseResolution;
+
+	// Track averaging boolean ('true' if track grade, curvature, and superelevation are averaged over length of each rail vehicle)
+	bool trackAveragingBool;
+
+	// Forced speed input file reader
+	InputFileReader_ForcedSpeed* inputFileReader_ForcedSpeed;
+
+	// Solver settings input file reader
+	InputFileReader_SolverSettings* inputFileReader_SolverSettings;
+
 	void convertToSI() override;
 
 	std::string load() override;
 
 	// Simulates train dynamics
+	// inputFileReader_ForcedSpeed		-->	Forced speed input file reader
+	// inputFileReader_SolverSettings	-->	Solver settings input file reader
+	void simulate(InputFileReader_ForcedSpeed* inputFileReader_ForcedSpeed, InputFileReader_SolverSettings* inputFileReader_SolverSettings);
+
+	// Initializes simulation (train consist, brake pipes, track placement, and output results file writers)
 	// inputFileReader_ForcedSpeed	-->	Forced speed input file reader
-	void simulate(InputFileReader_ForcedSpeed* inputFileReader_ForcedSpeed);
+	// writeResultsBool				-->	Write results boolean
+	void initialize(InputFileReader_ForcedSpeed* inputFileReader_ForcedSpeed, bool writeResultsBool);
+
+	// Performs single implicit solver time step (returns termination condition)
+	int implicitSolverIntegrationStep();
+
+	// Performs implicit solver time steps until number of time steps is reached or simulation is terminated (returns termination condition)
+	// numberOfImplicitSolverTimeSteps	-->	Number of implicit solver time steps
+	int simulateImplicitSolverTimeSteps(int numberOfImplicitSolverTimeSteps);
+
+	// Closes output results file writers, prints message explaining why simulation was terminated, and ends program
+	// terminationCondition		-->	Termination condition
+	void terminate(int terminationCondition);
+
+	// Saves state of simulation and train consist
+	// simulationState		-->	Simulation state
+	void saveState(SimulationState* simulationState);
+
+	// Loads state of simulation and train consist
+	// simulationState		-->	Simulation state
+	void loadState(SimulationState* simulationState);
+
+	// Closes and reopens output results file writers (discarding results written so far)
+	void resetResultsWriters();
+
+	// Appends results written by another simulation of same train consist to output results files
+	// simulation	-->	Simulation
+	void appendResults(Simulation* simulation);
+
+	// Closes output results file writers and removes output results files
+	void removeResultsFiles();
 
 protected:
 
@@ -107,12 +235,51 @@ private:
 	// Maximum error tolerance (used in variable time-step solver)
 	const double EXPLICIT_SOLVER_MAX_ERROR_THRESHOLD = 1.0 * pow(10.0, -9.0);
 
+	// Duration of rest before train consist dynamics are frozen (seconds)
+	const double STOPPED_TRAIN_SETTLING_TIME = 5.0;
+
+	// Maximum change in any pressure over one implicit solver time step for pneumatics to be settled (pascals)
+	const double STOPPED_TRAIN_PRESSURE_TOLERANCE = 0.001;
+
 	// Velocity approximately zero or below boolean
 	bool velocityApproxZeroBool;
 
 	// Start time of approximately zero or below velocity
 	double startTimeVelocityApproxZero;
 
+	// Implicit solver time of previous progress update (seconds)
+	double implicitSolverTimeOfPreviousProgressUpdate;
+
+	// Explicit solver time of last written results (seconds)
+	double explicitSolverTimeLastWrittenResults;
+
+	// Header labels written boolean
+	bool headerLabelsWrittenBool;
+
+	// First implicit solver time step boolean
+	bool firstImplicitStepBool;
+
+	// Write results boolean
+	bool writeResultsBool;
+
+	// Quasi-static boolean (if 'true', then train consist is currently advanced as a rigid body)
+	bool quasiStaticBool;
+
+	// Duration of current period of steady running (seconds)
+	double quasiStaticSteadyTime;
+
+	// Stopped train boolean (if 'true', then train consist dynamics are currently frozen)
+	bool stoppedTrainBool;
+
+	// Duration of current period in which train consist is held at rest (seconds)
+	double stoppedTrainTime;
+
+	// Pneumatics settled boolean for stopped train consist
+	bool stoppedTrainPneumaticsSettledBool;
+
+	// Brake pipe, reservoir, and brake cylinder pressures of previous implicit solver time step (pascals)
+	std::vector<double> stoppedTrainPreviousPressures;
+
 	// Point-in-train consist of rail vehicles to save
 	int* railVehiclesToSave;
 
@@ -137,16 +304,103 @@ private:
 	// Output results file writer for coupler displacement results
 	ResultsWriter* resultsWriter_CouplerDisplacements;
 
+	// Output results file writers created boolean
+	bool resultsWritersCreatedBool;
+
+	// Rolling checkpoint of simulation state ('NULL' if checkpoints are not used)
+	SimulationState* checkpointState;
+
+	// Implicit solver time of checkpoint (seconds)
+	double checkpointTime;
+
+	// Header labels written boolean at checkpoint
+	bool checkpointHeaderLabelsWrittenBool;
+
+	// Number of consecutive retries since numerical instability was last passed
+	int checkpointRetries;
+
+	// Rainflow counters of coupler force histories (one for each coupling system; empty if rainflow counting is not used)
+	std::vector<RainflowCounter*> rainflowCounters;
+
+	// Implicit solver time (seconds) of latest numerical instability (user-defined explicit solver settings are restored at first checkpoint after this time)
+	double checkpointInstabilityTime;
+
+	// User-defined fixed time step (seconds) for fixed time step explicit solver (restored after retries)
+	double checkpointExplicitSolverFixedTimeStep;
+
+	// User-defined maximum error tolerance for variable time step explicit solver (restored after retries)
+	double checkpointExplicitSolverMaxErrorThreshold;
+
+	// Minimum time step (seconds) of explicit solver before retries (restored after retries)
+	double checkpointExplicitSolverMinTimeStep;
+
+	// Maximum time step (seconds) for variable time step explicit solver before retries (restored after retries)
+	double checkpointExplicitSolverMaxTimeStep;
+
+	// Spatial domain decomposition of explicit solver ('NULL' if explicit solver integrates entire train consist on calling thread)
+	DomainDecomposition* domainDecomposition;
+
+	// Captures checkpoint of simulation state and output results files if checkpoint interval has elapsed since previous checkpoint
+	// (restores user-defined explicit solver settings once simulation has passed numerical instability that caused retries)
+	void updateCheckpoint();
+
+	// Rolls back simulation to checkpoint and retries with more robust explicit solver settings (returns termination condition)
+	// (If time step became too small, minimum time step is lowered, and variable time step explicit solver retries with user-defined 
+	// error tolerance and a lower maximum time step.  If coupler displacement was excessive, fixed time step is halved, or error 
+	// tolerance of variable time step explicit solver is tightened.)
+	// (returns 'terminationCondition' unchanged if it is not caused by numerical instability or if maximum number of retries is reached)
+	// terminationCondition		-->	Termination condition
+	int rollBackToCheckpoint(int terminationCondition);
+
 	// Performs single time step integration using RKF45 algorithm
 	// (returns 'true' if:	1. Time step is too small or 2. Coupler tension/compression is too large)
 	bool explicitSolverIntegrationStep();
 
+	// Performs single time step integration of train consist as a rigid body (couplers held at current displacements)
+	void quasiStaticIntegrationStep();
+
+	// Enters or leaves quasi-static stepping depending on whether train consist is running steadily
+	void calc_quasiStaticMode();
+
+	// Checks if train consist is running steadily (all rail vehicles moving at same speed with couplers at force equilibrium)
+	bool checkTrainConsistIsSteady();
+
+	// Performs single time step for train consist held at rest (dynamics are frozen)
+	void stoppedTrainIntegrationStep();
+
+	// Calculates time step for quasi-static and stopped train time steps (time step ends at next implicit solver time or at next sample)
+	double calc_macroTimeStep();
+
+	// Enters or leaves stopped train mode depending on whether train consist is held at rest by brakes
+	void calc_stoppedTrainMode();
+
+	// Checks if train consist is held at rest by brakes (all rail vehicles stopped and braking forces exceed driving forces)
+	bool checkTrainConsistIsHeld();
+
+	// Checks if brake pipe, reservoir, and brake cylinder pressures have settled
+	bool checkPneumaticsAreSettled();
+
+	// Skips implicit solver time steps until next event that could change state of train consist held at rest
+	// (next change of time-based operator input, next time-based forced speed, or termination due to train consist not moving)
+	void fastForwardStoppedTrain();
+
+	// Writes time step results if sampling period has elapsed
+	void writeSampledResults();
+
+	// Updates progress printed to console
+	void updateProgress();
+
 	// Calculate number of steps for explicit solver
 	void calc_explicitSolverNumSteps();
 
 	// Places train consist on track
 	void placeTrainConsistOnTrack();
 
+	// Returns path of file accompanying input file, such as locomotive event log or binary track database
+	// (derived from input file absolute path, since input file name of parareal replicas has a suffix)
+	// suffix	-->	Suffix appended to input file name (including file extension)
+	std::string calc_companionFilePath(std::string suffix);
+
 	// Checks if train consist is inside track segment boundaries
 	bool checkTrainConsistIsOnTrack();
 
@@ -176,9 +430,35 @@ private:
 	// whb		-->	Write headers boolean
 	void writeResults_CouplerDisplacements(bool whb);
 
+	// Writes time step results for saved rail vehicles, brake pipes, reservoirs, and couplers
+	void writeResults();
+
+	// Adds current coupler forces to rainflow counters
+	void countCouplerForceCycles();
+
+	// Writes rainflow cycle histograms (and damage sums) of coupler forces at end of simulation
+	void writeResults_CouplerForceCycles();
+
+	// Deletes rainflow counters
+	void deleteRainflowCounters();
+
 	// Initializes output results file writer
 	void initializeResultsWriters();
 
+	// Deletes output results file writers
+	void deleteResultsWriters();
+
+	// Appends contents of results file written by another simulation to results file
+	// resultsWriter			-->	Output results file writer
+	// resultsWriter_Window		-->	Output results file writer of other simulation
+	void appendResultsFile(ResultsWriter* resultsWriter, ResultsWriter* resultsWriter_Window);
+
+	// Records output results file positions at checkpoint
+	void checkpointResultsWriters();
+
+	// Discards results written to output results files after checkpoint
+	void rollBackResultsWriters();
+
 	// Closes (and flushes) results writers
 	// simulationSuccessfulBool		-->	Simulation successful boolean
 	void closeResultsWriters(bool simulationSuccessfulBool);
@@ -0,0 +1,73 @@
+//////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+// This file is part of the TRAIN PROPULSION SIMULATOR repository available at github.com/lnaz01/train-propulsion-simulator //
+//////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+
+#include <algorithm>
+#include <cmath>
+#include "SimulationState.h"
+#include "Simulation.h"
+
+
+SimulationState::SimulationState() {
+	currentIndex = 0;
+}
+
+
+SimulationState::~SimulationState() {}
+
+
+void SimulationState::append(double stateVariable, bool continuousBool) {
+	stateVariables.push_back(stateVariable);
+	continuousBools.push_back(continuousBool);
+}
+
+
+double SimulationState::next() {
+	double stateVariable = stateVariables[currentIndex];
+	currentIndex++;
+	return stateVariable;
+}
+
+
+void SimulationState::capture(Simulation* simulation) {
+	stateVariables.clear();
+	continuousBools.clear();
+	simulation->saveState(this);
+}
+
+
+void SimulationState::restore(Simulation* simulation) {
+	currentIndex = 0;
+	simulation->loadState(this);
+}
+
+
+void SimulationState::calc_pararealUpdate(SimulationState* predictedState, SimulationState* correctedState, SimulationState* previousPredictedState) {
+	stateVariables.resize(correctedState->stateVariables.size());
+	continuousBools = correctedState->continuousBools;
+	for (size_t i = 0; i < stateVariables.size(); i++) {
+		if (continuousBools[i] == true) {
+			stateVariables[i] = predictedState->stateVariables[i] + correctedState->stateVariables[i] - previousPredictedState->stateVariables[i];
+		}
+		else {
+			stateVariables[i] = correctedState->stateVariables[i];
+		}
+	}
+}
+
+
+double SimulationState::maxRelativeDifference(SimulationState* simulationState) {
+	double mrd = 0.0;  // maximum relative difference
+	for (size_t i = 0; i < stateVariables.size(); i++) {
+		if (continuousBools[i] == true) {
+			double scale = std::max(1.0, std::max(std::abs(stateVariables[i]), std::abs(simulationState->stateVariables[i])));
+			double rd = std::abs(stateVariables[i] - simulationState->stateVariables[i]) / scale;  // relative difference
+			if (rd > mrd) {
+				mrd = rd;
+			}
+		}
+	}
+	return mrd;
+}
+
@@ -0,0 +1,59 @@
+//////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+// This file is part of the TRAIN PROPULSION SIMULATOR repository available at github.com/lnaz01/train-propulsion-simulator //
+//////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+#ifndef SIMULATION_STATE_DEF
+#define SIMULATION_STATE_DEF
+
+#include <vector>
+
+class Simulation;
+
+class SimulationState {
+
+public:
+
+	SimulationState();
+
+	virtual ~SimulationState();
+
+	// State variables (all variables that persist from one implicit solver time step to the next)
+	std::vector<double> stateVariables;
+
+	// Continuous state variable booleans
+	// ('true' for continuous state variables; 'false' for discrete state variables, such as operating modes, flags, and bookkeeping times)
+	std::vector<bool> continuousBools;
+
+	// Index of next state variable to be read
+	size_t currentIndex;
+
+	// Appends state variable
+	// stateVariable		-->	State variable
+	// continuousBool		-->	'true' if state variable is continuous; 'false' if state variable is discrete
+	void append(double stateVariable, bool continuousBool);
+
+	// Returns next state variable and increments current index
+	double next();
+
+	// Captures state of simulation (and train consist)
+	// simulation			-->	Simulation
+	void capture(Simulation* simulation);
+
+	// Restores state of simulation (and train consist)
+	// simulation			-->	Simulation
+	void restore(Simulation* simulation);
+
+	// Sets state to parareal update of states ('predictedState' + 'correctedState' - 'previousPredictedState')
+	// (Note: Discrete state variables are taken from 'correctedState')
+	// predictedState			-->	Coarse propagator state starting from current iteration
+	// correctedState			-->	Fine propagator state starting from previous iteration
+	// previousPredictedState	-->	Coarse propagator state starting from previous iteration
+	void calc_pararealUpdate(SimulationState* predictedState, SimulationState* correctedState, SimulationState* previousPredictedState);
+
+	// Calculates maximum relative difference between continuous state variables of this state and another state
+	// simulationState		-->	Other state
+	double maxRelativeDifference(SimulationState* simulationState);
+
+};
+
+#endif
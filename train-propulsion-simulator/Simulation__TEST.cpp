@@ -7,13 +7,22 @@
 #include "Simulation.h"
 #include "Car.h"
 #include "Coupler.h"
+#include "InputFileReader_ForcedSpeed.h"
 #include "InputFileReader_Simulation.h"
+#include "InputFileReader_SolverSettings.h"
 #include "Locomotive.h"
 #include "LocomotiveOperator.h"
 #include "Track.h"
 #include "TrainConsist.h"
 
 
+// Tests retry after time step of variable time step explicit solver becomes too small
+// (failure is injected by raising minimum explicit solver time step; simulation terminates, so test is run last)
+// inputFileAbsolutePath	-->	Absolute path of simulation input file with variable time step explicit solver
+// injectedMinTimeStep		-->	Minimum explicit solver time step (seconds) before first retry
+void rollBackToCheckpoint__TEST(std::string inputFileAbsolutePath, double injectedMinTimeStep);
+
+
 int main() {
 
 	// Track
@@ -143,5 +152,40 @@ int main() {
 	inputFileReader_Simulation_SIMULATION->userDefinedSimulations[0]->console();
 	std::cout << std::endl;
 
+	// Roll back to checkpoint
+	rollBackToCheckpoint__TEST("C:/Users/Leith/Desktop/MySimulationVariableTimeStep__test.txt", 0.01);
+
 }
 
+
+void rollBackToCheckpoint__TEST(std::string inputFileAbsolutePath, double injectedMinTimeStep) {
+	InputFileReader_Simulation* ifrsim = new InputFileReader_Simulation(inputFileAbsolutePath);
+	std::string simval = ifrsim->load();
+	if (simval.compare(InputFileReader::VALID_INPUT_STRING) != 0) {
+		std::cout << "Line " << ifrsim->currentLineNumber << ": " << simval << std::endl;
+		std::cout << "rollBackToCheckpoint__TEST failed" << std::endl;
+		return;
+	}
+	ifrsim->userDefinedTracks[0]->calc_trackLength();
+	Simulation* simulation = ifrsim->userDefinedSimulations[0];
+	if (simulation->explicitSolverType != 1) {
+		std::cout << "rollBackToCheckpoint__TEST failed (input file must use variable time step explicit solver)" << std::endl;
+		return;
+	}
+	InputFileReader_ForcedSpeed* ifrfs = new InputFileReader_ForcedSpeed(ifrsim);
+	if (ifrfs->inputFileExistsBool == true) {
+		ifrfs->load();
+	}
+	// Default solver settings with rolling checkpoints (solver settings file is not loaded)
+	InputFileReader_SolverSettings* ifrss = new InputFileReader_SolverSettings(ifrsim);
+	ifrss->checkpointInterval = 10.0;
+	ifrss->checkpointMaximumRetries = 3;
+	// Inject failure
+	simulation->explicitSolverMinTimeStep = injectedMinTimeStep;
+	std::cout << "rollBackToCheckpoint__TEST" << std::endl;
+	std::cout << "Expected: 'Numerical instability' message(s) with minimum explicit solver time step of " << (injectedMinTimeStep * 0.01) << " seconds, ";
+	std::cout << "followed by termination that is not caused by time step becoming too small" << std::endl;
+	std::cout << std::endl;
+	// (Simulation prints termination condition and ends program)
+	simulation->simulate(ifrfs, ifrss);
+}
@@ -3,9 +3,14 @@
 //////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
 
 
+#include <algorithm>
+#include <cmath>
 #include "Track.h"
 #include "Function.h"
+#include "InputFileReader.h"
 #include "IntervalSmooth.h"
+#include "TrackDatabase.h"
+#include "TrackRoute.h"
 
 
 const double Track::TrackGaugeSI = UnitConverter::in_To_M(56.5);
@@ -16,7 +21,9 @@ Track::Track(InputFileReader_Simulation* inputFileReader_Simulation) : UserDefin
 	for (int i = 0; i < physicalVariablesSize; i++) {
 		physicalVariables.push_back(new Function(this, i));
 	}
-	slopeEquationCoefficientsCalculatedBool = false;
+	headingTableCalculatedBool = false;
+	lookupTablesCalculatedBool = false;
+	trackSource = NULL;
 	START_UDRRC_STRING = "Track_";
 	END_UDRRC_STRING = "_Track";
 	// User-inputted physical variables
@@ -111,7 +118,11 @@ Track::Track(InputFileReader_Simulation* inputFileReader_Simulation) : UserDefin
 }
 
 
-Track::~Track() {}
+Track::~Track() {
+	if (trackSource != NULL) {
+		delete trackSource;
+	}
+}
 
 
 void Track::calc_trackLength() {
@@ -121,24 +132,218 @@ void Track::calc_trackLength() {
 }
 
 
+std::string Track::attach_database(std::string filePath) {
+	if (trackSource != NULL) {
+		delete trackSource;
+		trackSource = NULL;
+	}
+	TrackDatabase* td = new TrackDatabase(filePath);  // track database
+	std::string tdstr = td->open();  // track database validation string
+	if (tdstr.compare(InputFileReader::VALID_INPUT_STRING) != 0) {
+		delete td;
+		return tdstr;
+	}
+	trackSource = td;
+	trackLength = trackSource->end();
+	return InputFileReader::VALID_INPUT_STRING;
+}
+
+
+void Track::attach_route(TrackRoute* trackRoute) {
+	if (trackSource != NULL) {
+		delete trackSource;
+	}
+	trackSource = trackRoute;
+	trackLength = trackSource->end();
+}
+
+
 double Track::angle(double longPosition) {
-	if (slopeEquationCoefficientsCalculatedBool == false) {
-		slopeEquationCoefficients();
+	size_t si = 0;  // segment index (search hint)
+	return angle(longPosition, &si);
+}
+
+
+double Track::angle(double longPosition, size_t* segmentIndex) {
+	if (trackSource != NULL) {
+		if ((longPosition < trackSource->start()) || (longPosition > trackSource->end())) {
+			return std::numeric_limits<double>::max();
+		}
+		return trackSource->interpolate(3, longPosition);
 	}
-	double ypnt = std::numeric_limits<double>::max();
-	for (size_t i = 0; i < physicalVariables[1]->intervals.size(); i++) {
-		double x0 = physicalVariables[1]->intervals[i]->points[0]->x;
-		double xf = physicalVariables[1]->intervals[i]->points[1]->x;
-		if ((longPosition >= x0) && (longPosition <= xf)) {
-			ypnt = (coef2[i] * pow(longPosition, 2.0)) + (coef1[i] * longPosition) + coef0[i];
-			break;
+	if (headingTableCalculatedBool == false) {
+		calc_headingTable();
+	}
+	size_t i = calc_headingSegmentIndex(longPosition, *segmentIndex);
+	if (i == headingSegmentCurvatures.size()) {
+		return std::numeric_limits<double>::max();
+	}
+	*segmentIndex = i;
+	double t = longPosition - headingKnotPositions[i];  // distance from start of segment
+	return headingKnotAngles[i] + (t * (headingSegmentCurvatures[i] + (0.5 * headingSegmentCurvatureSlopes[i] * t)));
+}
+
+
+double Track::integratedCurvature(double longPosition0, double longPosition1, size_t* segmentIndex0, size_t* segmentIndex1) {
+	if (trackSource != NULL) {
+		return angle(longPosition1, segmentIndex1) - angle(longPosition0, segmentIndex0);
+	}
+	if (headingTableCalculatedBool == false) {
+		calc_headingTable();
+	}
+	size_t i0 = calc_headingSegmentIndex(longPosition0, *segmentIndex0);
+	size_t i1 = calc_headingSegmentIndex(longPosition1, *segmentIndex1);
+	if ((i0 == headingSegmentCurvatures.size()) || (i1 == headingSegmentCurvatures.size())) {
+		return std::numeric_limits<double>::max();
+	}
+	*segmentIndex0 = i0;
+	*segmentIndex1 = i1;
+	if (i0 == i1) {
+		// Both positions on same segment, so integral is calculated directly (without differencing angles measured from start of track)
+		double t0 = longPosition0 - headingKnotPositions[i0];  // distance of first position from start of segment
+		double t1 = longPosition1 - headingKnotPositions[i0];  // distance of second position from start of segment
+		return (t1 - t0) * (headingSegmentCurvatures[i0] + (0.5 * headingSegmentCurvatureSlopes[i0] * (t0 + t1)));
+	}
+	return angle(longPosition1, segmentIndex1) - angle(longPosition0, segmentIndex0);
+}
+
+
+void Track::calc_properties(double longPosition, size_t* segmentIndices, double* properties) {
+	for (int k = 0; k < 3; k++) {
+		properties[k] = interpolate(k, longPosition, &segmentIndices[k]);
+	}
+	properties[3] = angle(longPosition, &segmentIndices[3]);
+}
+
+
+void Track::calc_properties(const double* longPositions, size_t numberOfPositions, size_t* segmentIndices, double* const* properties) {
+	if (trackSource != NULL) {
+		for (size_t i = 0; i < numberOfPositions; i++) {
+			for (int k = 0; k < 3; k++) {
+				properties[k][i] = trackSource->interpolate(k, longPositions[i]);
+			}
+			properties[3][i] = angle(longPositions[i]);
+		}
+		return;
+	}
+	// Track functions (lookup tables are already evaluated in constant time per position)
+	for (int k = 0; k < 3; k++) {
+		if (lookupTablesCalculatedBool == false) {
+			physicalVariables[k]->interpolateSweep(longPositions, numberOfPositions, PVDMIN_SI[k], PVDMAX_SI[k], &segmentIndices[k], properties[k]);
+		}
+		else {
+			for (size_t i = 0; i < numberOfPositions; i++) {
+				properties[k][i] = interpolate(k, longPositions[i], &segmentIndices[k]);
+			}
+		}
+	}
+	// Heading table (cursor moves from segment of one position to segment of next position)
+	if (headingTableCalculatedBool == false) {
+		calc_headingTable();
+	}
+	size_t ns = headingSegmentCurvatures.size();  // number of segments
+	size_t i = std::min(segmentIndices[3], ns - 1);  // segment cursor
+	for (size_t j = 0; j < numberOfPositions; j++) {
+		double x = longPositions[j];  // longitudinal position
+		if ((x < headingKnotPositions[0]) || (x > headingKnotPositions[ns])) {
+			properties[3][j] = std::numeric_limits<double>::max();
+			continue;
+		}
+		while ((i > 0) && (headingKnotPositions[i] > x)) {
+			i = i - 1;
 		}
+		while ((i < (ns - 1)) && (headingKnotPositions[i + 1] <= x)) {
+			i = i + 1;
+		}
+		if (j == 0) {
+			segmentIndices[3] = i;
+		}
+		double t = x - headingKnotPositions[i];  // distance from start of segment
+		properties[3][j] = headingKnotAngles[i] + (t * (headingSegmentCurvatures[i] + (0.5 * headingSegmentCurvatureSlopes[i] * t)));
 	}
-	return ypnt;
+}
+
+
+void Track::calc_averagedProperties(double longPosition, double windowLength, size_t* segmentIndices, size_t* windowSegmentIndices, double* properties) {
+	if ((trackSource != NULL) || (windowLength <= 0.0)) {
+		calc_properties(longPosition, segmentIndices, properties);
+		return;
+	}
+	double x0 = longPosition - (0.5 * windowLength);  // rear end of window
+	double x1 = longPosition + (0.5 * windowLength);  // front end of window
+	for (int k = 0; k < 3; k++) {
+		properties[k] = average(k, x0, x1, &windowSegmentIndices[k], &windowSegmentIndices[3 + k]);
+	}
+	properties[3] = angle(longPosition, &segmentIndices[3]);
+}
+
+
+double Track::average(int functionIndex, double longPosition0, double longPosition1, size_t* segmentIndex0, size_t* segmentIndex1) {
+	if (longPosition1 == longPosition0) {
+		return physicalVariables[functionIndex]->interpolate(longPosition0, PVDMIN_SI[functionIndex], PVDMAX_SI[functionIndex], segmentIndex0);
+	}
+	double i0 = physicalVariables[functionIndex]->integrate(longPosition0, segmentIndex0);  // integral from start of track function to first position
+	double i1 = physicalVariables[functionIndex]->integrate(longPosition1, segmentIndex1);  // integral from start of track function to second position
+	double r = (i1 - i0) / (longPosition1 - longPosition0);
+	return std::min(std::max(r, PVDMIN_SI[functionIndex]), PVDMAX_SI[functionIndex]);
+}
+
+
+void Track::calc_lookupTables(double resolution, double maxMemory) {
+	// Number of entries of all lookup tables at requested resolution
+	double ne = 0.0;
+	for (int k = 0; k < physicalVariablesSize; k++) {
+		int niml = physicalVariables[k]->intervals.size();
+		int npml = physicalVariables[k]->intervals[niml - 1]->points.size();
+		ne = ne + std::ceil((physicalVariables[k]->intervals[niml - 1]->points[npml - 1]->x - physicalVariables[k]->intervals[0]->points[0]->x) / resolution) + 1.0;
+	}
+	// Coarsen resolution to stay within memory budget
+	double mne = maxMemory / sizeof(double);  // maximum number of entries
+	if (ne > mne) {
+		resolution = resolution * (ne / (mne - physicalVariablesSize));
+	}
+	for (int k = 0; k < physicalVariablesSize; k++) {
+		int niml = physicalVariables[k]->intervals.size();
+		int npml = physicalVariables[k]->intervals[niml - 1]->points.size();
+		double x0 = physicalVariables[k]->intervals[0]->points[0]->x;  // first longitudinal position
+		double xf = physicalVariables[k]->intervals[niml - 1]->points[npml - 1]->x;  // last longitudinal position
+		size_t n = (size_t)std::ceil((xf - x0) / resolution);  // number of table intervals
+		lookupTableStarts[k] = x0;
+		lookupTableResolutions[k] = resolution;
+		lookupTables[k].resize(n + 1);
+		size_t si = 0;  // segment index (search hint)
+		for (size_t j = 0; j <= n; j++) {
+			lookupTables[k][j] = physicalVariables[k]->interpolate(x0 + (j * resolution), PVDMIN_SI[k], PVDMAX_SI[k], &si);
+		}
+	}
+	lookupTablesCalculatedBool = true;
+}
+
+
+double Track::interpolate(int functionIndex, double longPosition, size_t* segmentIndex) {
+	if (trackSource != NULL) {
+		return trackSource->interpolate(functionIndex, longPosition);
+	}
+	if (lookupTablesCalculatedBool == false) {
+		return physicalVariables[functionIndex]->interpolate(longPosition, PVDMIN_SI[functionIndex], PVDMAX_SI[functionIndex], segmentIndex);
+	}
+	const std::vector<double>& lt = lookupTables[functionIndex];  // lookup table
+	double u = (longPosition - lookupTableStarts[functionIndex]) / lookupTableResolutions[functionIndex];  // position in table entries
+	if (u <= 0.0) {
+		return lt[0];
+	}
+	size_t j = (size_t)u;
+	if (j >= (lt.size() - 1)) {
+		return lt[lt.size() - 1];
+	}
+	double w = u - j;  // interpolation weight
+	return lt[j] + (w * (lt[j + 1] - lt[j]));
 }
 
 
 void Track::convertToSI() {
+	// Lookup tables (if any) were calculated for previous units
+	lookupTablesCalculatedBool = false;
 	// Physical variable 0 -- grade
 	for (size_t i = 0; i < physicalVariables[0]->intervals.size(); i++) {
 		for (size_t j = 0; j < physicalVariables[0]->intervals[i]->points.size(); j++) {
@@ -149,8 +354,8 @@ void Track::convertToSI() {
 			physicalVariables[0]->intervals[i]->points[j]->x = x_si;
 			physicalVariables[0]->intervals[i]->points[j]->y = y_si;
 		}
-		((IntervalSmooth*)physicalVariables[0]->intervals[i])->zvcb = false;
 	}
+	physicalVariables[0]->compile();
 	// Physical variable 1 -- curvature
 	for (size_t i = 0; i < physicalVariables[1]->intervals.size(); i++) {
 		for (size_t j = 0; j < physicalVariables[1]->intervals[i]->points.size(); j++) {
@@ -161,8 +366,8 @@ void Track::convertToSI() {
 			physicalVariables[1]->intervals[i]->points[j]->x = x_si;
 			physicalVariables[1]->intervals[i]->points[j]->y = y_si;
 		}
-		((IntervalSmooth*)physicalVariables[1]->intervals[i])->zvcb = false;
 	}
+	physicalVariables[1]->compile();
 	// Physical variable 2 -- superelevation
 	for (size_t i = 0; i < physicalVariables[2]->intervals.size(); i++) {
 		for (size_t j = 0; j < physicalVariables[2]->intervals[i]->points.size(); j++) {
@@ -173,42 +378,55 @@ void Track::convertToSI() {
 			physicalVariables[2]->intervals[i]->points[j]->x = x_si;
 			physicalVariables[2]->intervals[i]->points[j]->y = y_si;
 		}
-		((IntervalSmooth*)physicalVariables[2]->intervals[i])->zvcb = false;
 	}
+	physicalVariables[2]->compile();
+	// Heading table (from curvature in SI units)
+	calc_headingTable();
 }
 
 
 void Track::loadPhysicalConstantAlternateNames() {}
 
 
-void Track::slopeEquationCoefficients() {
-	slopeEquationCoefficientsCalculatedBool = true;
+void Track::calc_headingTable() {
+	headingKnotPositions.clear();
+	headingKnotAngles.clear();
+	headingSegmentCurvatures.clear();
+	headingSegmentCurvatureSlopes.clear();
+	// Curvature is linear along each interval, so angle is quadratic along each interval
+	double a = 0.0;  // angle at start of interval
 	for (size_t i = 0; i < physicalVariables[1]->intervals.size(); i++) {
 		double x0 = physicalVariables[1]->intervals[i]->points[0]->x;
 		double xf = physicalVariables[1]->intervals[i]->points[1]->x;
 		double y0 = physicalVariables[1]->intervals[i]->points[0]->y;
 		double yf = physicalVariables[1]->intervals[i]->points[1]->y;
 		double m = (yf - y0) / (xf - x0);
-		coef2.push_back(0.5 * m);
-		coef1.push_back(-(x0 * m) + y0);
-		coef0.push_back(std::numeric_limits<double>::max());
-		if (i == 0) {
-			coef0[coef0.size() - 1] =
-				0.0
-				- (coef2[coef2.size() - 1] * pow(x0, 2.0))
-				- (coef1[coef1.size() - 1] * x0);
-		}
-		else {
-			double pifv;  // final value of previous interval
-			pifv =
-				(coef2[coef2.size() - 2] * pow(x0, 2.0))
-				+ (coef1[coef1.size() - 2] * x0)
-				+ coef0[coef0.size() - 2];
-			coef0[coef0.size() - 1] =
-				pifv
-				- (coef2[coef2.size() - 1] * pow(x0, 2.0))
-				- (coef1[coef1.size() - 1] * x0);
+		headingKnotPositions.push_back(x0);
+		headingKnotAngles.push_back(a);
+		headingSegmentCurvatures.push_back(y0);
+		headingSegmentCurvatureSlopes.push_back(m);
+		a = a + ((xf - x0) * (y0 + (0.5 * m * (xf - x0))));
+		if (i == (physicalVariables[1]->intervals.size() - 1)) {
+			headingKnotPositions.push_back(xf);
+			headingKnotAngles.push_back(a);
 		}
 	}
+	headingTableCalculatedBool = true;
+}
+
+
+size_t Track::calc_headingSegmentIndex(double longPosition, size_t segmentIndex) {
+	size_t ns = headingSegmentCurvatures.size();  // number of segments
+	if ((longPosition < headingKnotPositions[0]) || (longPosition > headingKnotPositions[ns])) {
+		return ns;
+	}
+	// Previous segment is checked before binary search, since longitudinal position usually changes little between calls
+	size_t i = std::min(segmentIndex, ns - 1);
+	if ((headingKnotPositions[i] <= longPosition) && (longPosition <= headingKnotPositions[i + 1])) {
+		return i;
+	}
+	// Last segment whose start is not greater than longitudinal position
+	size_t k = std::upper_bound(headingKnotPositions.begin(), headingKnotPositions.end() - 1, longPosition) - headingKnotPositions.begin();
+	return (k > 0) ? (k - 1) : 0;
 }
 
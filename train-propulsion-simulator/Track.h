@@ -5,11 +5,14 @@
 #ifndef TRACK_DEF
 #define TRACK_DEF
 
+#include <string>
 #include <vector>
 #include "UnitConverter.h"
 #include "UserDefinedRRComponent.h"
 
 class InputFileReader_Simulation;
+class TrackRoute;
+class TrackSource;
 
 class Track : public UserDefinedRRComponent {
 
@@ -31,13 +34,89 @@ public:
 	// Track length (meters)
 	double trackLength;
 
+	// Source from which all track properties are read instead of track functions ('NULL' if track properties are calculated from track functions)
+	TrackSource* trackSource;
+
+	// Attaches binary track database as track source (returns error message if database is not valid)
+	// (Track length is set to longitudinal position of last entry of database)
+	// filePath		-->	Absolute path of binary track database file
+	std::string attach_database(std::string filePath);
+
+	// Attaches route assembled from track segment library as track source (track takes ownership of route)
+	// (Track length is set to longitudinal position of end of route)
+	// trackRoute	-->	Track route
+	void attach_route(TrackRoute* trackRoute);
+
 	// Calculates track length
 	void calc_trackLength();
 
-	// Track angle
+	// Track angle (heading, which is integral of curvature from start of track)
 	// longPosition		-->	Longitudinal position (meters)
 	double angle(double longPosition);
 
+	// Track angle (heading, which is integral of curvature from start of track), starting search for heading table segment from segment of previous call
+	// longPosition		-->	Longitudinal position (meters)
+	// segmentIndex		-->	Index of heading table segment found by previous call (updated to index of segment found by this call)
+	double angle(double longPosition, size_t* segmentIndex);
+
+	// Integral of curvature between two longitudinal positions (angle of track at second position relative to track at first position)
+	// longPosition0	-->	First longitudinal position (meters)
+	// longPosition1	-->	Second longitudinal position (meters)
+	// segmentIndex0	-->	Index of heading table segment found by previous call for first longitudinal position (search hint)
+	// segmentIndex1	-->	Index of heading table segment found by previous call for second longitudinal position (search hint)
+	double integratedCurvature(double longPosition0, double longPosition1, size_t* segmentIndex0, size_t* segmentIndex1);
+
+	// Number of track properties calculated by single track query (grade, curvature, superelevation, and angle)
+	static constexpr int NUMBER_OF_PROPERTIES = 4;
+
+	// Calculates all track properties at longitudinal position in single query
+	// longPosition		-->	Longitudinal position (meters)
+	// segmentIndices	-->	Indices of grade, curvature, and superelevation function segments and heading table segment found by previous call
+	//						(search hints, updated to indices of segments found by this call)
+	// properties		-->	Grade (radians), geometric curvature (meters^-1), superelevation (radians), and angle (radians)
+	void calc_properties(double longPosition, size_t* segmentIndices, double* properties);
+
+	// Calculates all track properties at multiple longitudinal positions in single sweep along track (see 'Function::interpolateSweep')
+	// longPositions		-->	Longitudinal positions (meters) (ordered along track, such as rail vehicle positions along train consist, for single sweep)
+	// numberOfPositions	-->	Number of longitudinal positions
+	// segmentIndices		-->	Indices of grade, curvature, and superelevation function segments and heading table segment found by previous call at first
+	//							position (starting cursors of sweep, updated to indices of segments found by this call at first position)
+	// properties			-->	Arrays of grade (radians), geometric curvature (meters^-1), superelevation (radians), and angle (radians) at each position
+	void calc_properties(const double* longPositions, size_t numberOfPositions, size_t* segmentIndices, double* const* properties);
+
+	// Calculates all track properties averaged over longitudinal position window in single query (angle is calculated at center of window)
+	// (Grade, curvature, and superelevation are averaged from prefix integrals of track functions, or taken at center of window if track source is attached)
+	// longPosition			-->	Longitudinal position of center of window (meters)
+	// windowLength			-->	Length of window (meters)
+	// segmentIndices		-->	Indices of track function segments and heading table segment found by previous call at center of window
+	//							(search hints, updated to indices of segments found by this call)
+	// windowSegmentIndices	-->	Indices of grade, curvature, and superelevation function segments found by previous call at rear end of window, followed by
+	//							indices at front end of window (search hints, updated to indices of segments found by this call)
+	// properties			-->	Grade (radians), geometric curvature (meters^-1), superelevation (radians), and angle (radians)
+	void calc_averagedProperties(double longPosition, double windowLength, size_t* segmentIndices, size_t* windowSegmentIndices, double* properties);
+
+	// Calculates average of track function between two longitudinal positions from prefix integrals of track function (independent of lookup tables)
+	// functionIndex	-->	Track function index (0 for grade, 1 for curvature, 2 for superelevation)
+	// longPosition0	-->	First longitudinal position (meters)
+	// longPosition1	-->	Second longitudinal position (meters)
+	// segmentIndex0	-->	Index of track function segment found by previous call for first longitudinal position (search hint)
+	// segmentIndex1	-->	Index of track function segment found by previous call for second longitudinal position (search hint)
+	double average(int functionIndex, double longPosition0, double longPosition1, size_t* segmentIndex0, size_t* segmentIndex1);
+
+	// Calculates heading table from curvature function (called after conversion to SI)
+	void calc_headingTable();
+
+	// Calculates uniform-resolution lookup tables of track functions (grade, curvature, and superelevation)
+	// resolution	-->	Distance between table entries (meters)
+	// maxMemory	-->	Maximum memory of all lookup tables (bytes) (resolution is coarsened if necessary to stay within this budget)
+	void calc_lookupTables(double resolution, double maxMemory);
+
+	// Calculates value of track function at longitudinal position (linear interpolation in lookup table, if lookup tables have been calculated)
+	// functionIndex	-->	Track function index (0 for grade, 1 for curvature, 2 for superelevation)
+	// longPosition		-->	Longitudinal position (meters)
+	// segmentIndex		-->	Index of track function segment found by previous call (search hint, only used without lookup tables)
+	double interpolate(int functionIndex, double longPosition, size_t* segmentIndex);
+
 	void convertToSI() override;
 
 protected:
@@ -52,20 +131,37 @@ private:
 	// Maximum track length in US units (feet)
 	static constexpr double MAXTL = 1056000.0;  // 1,056,000 feet = 200 miles
 
-	// Coefficient of second order term for slope equation
-	std::vector<double> coef2;
+	// Heading table calculated boolean
+	bool headingTableCalculatedBool;
+
+	// Longitudinal positions of heading table knots (first point of each curvature interval, followed by last point of last curvature interval) (meters)
+	std::vector<double> headingKnotPositions;
+
+	// Track angles at heading table knots (radians)
+	std::vector<double> headingKnotAngles;
 
-	// Coefficient of first order term for slope equation
-	std::vector<double> coef1;
+	// Curvatures at start of each heading table segment (meters^-1)
+	std::vector<double> headingSegmentCurvatures;
 
-	// Coefficient of zero order term for slope equation
-	std::vector<double> coef0;
+	// Rates of change of curvature along each heading table segment (meters^-2)
+	std::vector<double> headingSegmentCurvatureSlopes;
 
-	// Coefficients of slope equation calculated boolean
-	bool slopeEquationCoefficientsCalculatedBool;
+	// Lookup tables calculated boolean
+	bool lookupTablesCalculatedBool;
 
-	// Calculates coefficients of piecewise-smooth slope equation
-	void slopeEquationCoefficients();
+	// Longitudinal position of first entry of each lookup table (meters)
+	double lookupTableStarts[3];
+
+	// Distance between entries of each lookup table (meters)
+	double lookupTableResolutions[3];
+
+	// Lookup tables of track function values (entry 'j' is value at 'lookupTableStarts + (j * lookupTableResolutions)')
+	std::vector<double> lookupTables[3];
+
+	// Calculates index of heading table segment containing longitudinal position (returns number of segments if longitudinal position is not on track)
+	// longPosition		-->	Longitudinal position (meters)
+	// segmentIndex		-->	Index of heading table segment found by previous call (search hint)
+	size_t calc_headingSegmentIndex(double longPosition, size_t segmentIndex);
 
 };
 
@@ -0,0 +1,196 @@
+//////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+// This file is part of the TRAIN PROPULSION SIMULATOR repository available at github.com/lnaz01/train-propulsion-simulator //
+//////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+
+#include <algorithm>
+#include <cmath>
+#include <fstream>
+#include "TrackDatabase.h"
+#include "Function.h"
+#include "InputFileReader.h"
+#include "Interval.h"
+#include "Point.h"
+#include "Track.h"
+
+
+const std::string TrackDatabase::FILE_SIGNATURE = "TPSTRKDB";
+
+
+const std::streamoff TrackDatabase::HEADER_SIZE = 8 + (2 * sizeof(unsigned int)) + (2 * sizeof(double)) + (2 * sizeof(unsigned long long));
+
+
+TrackDatabase::TrackDatabase(std::string filePath) {
+	this->filePath = filePath;
+	startPosition = 0.0;
+	resolution = 0.0;
+	numberOfEntries = 0;
+	sourceFingerprint = 0;
+	inputFileStream = NULL;
+	for (size_t i = 0; i < NUMBER_OF_CACHED_PAGES; i++) {
+		pageIndices[i] = 0;
+	}
+}
+
+
+TrackDatabase::~TrackDatabase() {
+	if (inputFileStream != NULL) {
+		inputFileStream->close();
+		delete inputFileStream;
+	}
+}
+
+
+std::string TrackDatabase::convert(Track* track, std::string filePath, double resolution) {
+	std::ofstream ofs(filePath, std::ios::trunc | std::ios::binary);
+	if (ofs.is_open() == false) {
+		return std::string("Binary track database file '") + filePath + std::string("' could not be written.");
+	}
+	double x0 = track->physicalVariables[0]->intervals[0]->points[0]->x;  // track start location
+	unsigned long long ne = (unsigned long long)std::ceil((track->trackLength - x0) / resolution) + 1;  // number of entries
+	unsigned long long sfp = calc_fingerprint(track);  // source fingerprint
+	// Header
+	unsigned int fv = FILE_VERSION;  // file format version
+	unsigned int np = NUMBER_OF_PROPERTIES;  // number of properties
+	ofs.write(FILE_SIGNATURE.c_str(), 8);
+	ofs.write((const char*)&fv, sizeof(unsigned int));
+	ofs.write((const char*)&np, sizeof(unsigned int));
+	ofs.write((const char*)&x0, sizeof(double));
+	ofs.write((const char*)&resolution, sizeof(double));
+	ofs.write((const char*)&ne, sizeof(unsigned long long));
+	ofs.write((const char*)&sfp, sizeof(unsigned long long));
+	// Entries (last entry may lie beyond end of track, where track properties are those of end of track)
+	size_t si[Track::NUMBER_OF_PROPERTIES] = { 0, 0, 0, 0 };  // segment indices (search hints)
+	double p[Track::NUMBER_OF_PROPERTIES];  // track properties
+	for (unsigned long long j = 0; j < ne; j++) {
+		double x = std::min(x0 + (j * resolution), track->trackLength);
+		track->calc_properties(x, si, p);
+		ofs.write((const char*)p, NUMBER_OF_PROPERTIES * sizeof(double));
+	}
+	if (ofs.good() == false) {
+		return std::string("Binary track database file '") + filePath + std::string("' could not be written.");
+	}
+	return InputFileReader::VALID_INPUT_STRING;
+}
+
+
+bool TrackDatabase::isStale(std::string filePath, Track* track, double resolution) {
+	TrackDatabase trackDatabase(filePath);
+	std::ifstream ifs(filePath, std::ios::binary);
+	if ((ifs.is_open() == false) || (trackDatabase.readHeader(&ifs) == false) || (trackDatabase.sourceFingerprint == 0)) {
+		return false;
+	}
+	return (trackDatabase.sourceFingerprint != calc_fingerprint(track)) || (trackDatabase.resolution != resolution);
+}
+
+
+std::string TrackDatabase::open() {
+	inputFileStream = new std::ifstream(filePath, std::ios::binary);
+	if (inputFileStream->is_open() == false) {
+		return std::string("Binary track database file '") + filePath + std::string("' could not be opened.");
+	}
+	if (readHeader(inputFileStream) == false) {
+		return std::string("File '") + filePath + std::string("' is not a valid binary track database.");
+	}
+	if ((resolution <= 0.0) || (numberOfEntries < 2)) {
+		return std::string("Binary track database '") + filePath + std::string("' must have positive resolution and at least two entries.");
+	}
+	// Check that file holds all entries
+	inputFileStream->seekg(0, std::ios::end);
+	if ((unsigned long long)(inputFileStream->tellg() - HEADER_SIZE) < (numberOfEntries * NUMBER_OF_PROPERTIES * sizeof(double))) {
+		return std::string("Binary track database '") + filePath + std::string("' is truncated.");
+	}
+	// Empty page slots
+	for (size_t i = 0; i < NUMBER_OF_CACHED_PAGES; i++) {
+		pageIndices[i] = numberOfEntries;
+	}
+	return InputFileReader::VALID_INPUT_STRING;
+}
+
+
+double TrackDatabase::start() {
+	return startPosition;
+}
+
+
+double TrackDatabase::end() {
+	return startPosition + ((numberOfEntries - 1) * resolution);
+}
+
+
+double TrackDatabase::interpolate(int propertyIndex, double longPosition) {
+	double u = (longPosition - startPosition) / resolution;  // position in entries
+	if (u <= 0.0) {
+		return entry(0)[propertyIndex];
+	}
+	unsigned long long j = (unsigned long long)u;
+	if (j >= (numberOfEntries - 1)) {
+		return entry(numberOfEntries - 1)[propertyIndex];
+	}
+	double w = u - j;  // interpolation weight
+	double y0 = entry(j)[propertyIndex];
+	double y1 = entry(j + 1)[propertyIndex];
+	return y0 + (w * (y1 - y0));
+}
+
+
+unsigned long long TrackDatabase::calc_fingerprint(Track* track) {
+	unsigned long long h = 14695981039346656037ULL;  // hash (FNV-1a offset basis)
+	for (size_t k = 0; k < track->physicalVariables.size(); k++) {
+		Function* f = track->physicalVariables[k];
+		unsigned char sfb = (f->stepFunctionBool == true) ? 1 : 0;  // step function boolean (interval type)
+		unsigned long long ni = f->intervals.size();  // number of intervals
+		hashBytes(&h, &sfb, sizeof(unsigned char));
+		hashBytes(&h, &ni, sizeof(unsigned long long));
+		for (size_t i = 0; i < f->intervals.size(); i++) {
+			unsigned long long npts = f->intervals[i]->points.size();  // number of points
+			hashBytes(&h, &npts, sizeof(unsigned long long));
+			for (size_t j = 0; j < f->intervals[i]->points.size(); j++) {
+				hashBytes(&h, &f->intervals[i]->points[j]->x, sizeof(double));
+				hashBytes(&h, &f->intervals[i]->points[j]->y, sizeof(double));
+			}
+		}
+	}
+	hashBytes(&h, &track->trackLength, sizeof(double));
+	// ('0' marks databases written by other tools)
+	return (h == 0) ? 1 : h;
+}
+
+
+void TrackDatabase::hashBytes(unsigned long long* hash, const void* bytes, size_t numberOfBytes) {
+	for (size_t i = 0; i < numberOfBytes; i++) {
+		*hash = (*hash ^ ((const unsigned char*)bytes)[i]) * 1099511628211ULL;  // (FNV-1a prime)
+	}
+}
+
+
+bool TrackDatabase::readHeader(std::ifstream* ifs) {
+	char fs[8];  // file signature
+	unsigned int fv;  // file format version
+	unsigned int np;  // number of properties
+	ifs->read(fs, 8);
+	ifs->read((char*)&fv, sizeof(unsigned int));
+	ifs->read((char*)&np, sizeof(unsigned int));
+	ifs->read((char*)&startPosition, sizeof(double));
+	ifs->read((char*)&resolution, sizeof(double));
+	ifs->read((char*)&numberOfEntries, sizeof(unsigned long long));
+	ifs->read((char*)&sourceFingerprint, sizeof(unsigned long long));
+	return (ifs->good() == true) && (std::string(fs, 8).compare(FILE_SIGNATURE) == 0) && (fv == FILE_VERSION) && (np == NUMBER_OF_PROPERTIES);
+}
+
+
+const double* TrackDatabase::entry(unsigned long long entryIndex) {
+	unsigned long long pi = entryIndex / ENTRIES_PER_PAGE;  // page index
+	size_t slot = pi % NUMBER_OF_CACHED_PAGES;  // page slot
+	if (pageIndices[slot] != pi) {
+		unsigned long long fe = pi * ENTRIES_PER_PAGE;  // first entry of page
+		unsigned long long ne = std::min((unsigned long long)ENTRIES_PER_PAGE, numberOfEntries - fe);  // number of entries of page
+		pages[slot].resize(ENTRIES_PER_PAGE * NUMBER_OF_PROPERTIES);
+		inputFileStream->clear();
+		inputFileStream->seekg(HEADER_SIZE + (std::streamoff)(fe * NUMBER_OF_PROPERTIES * sizeof(double)), std::ios::beg);
+		inputFileStream->read((char*)pages[slot].data(), ne * NUMBER_OF_PROPERTIES * sizeof(double));
+		pageIndices[slot] = pi;
+	}
+	return &pages[slot][(entryIndex - (pi * ENTRIES_PER_PAGE)) * NUMBER_OF_PROPERTIES];
+}
+
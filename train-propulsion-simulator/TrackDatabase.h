@@ -0,0 +1,119 @@
+//////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+// This file is part of the TRAIN PROPULSION SIMULATOR repository available at github.com/lnaz01/train-propulsion-simulator //
+//////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+#ifndef TRACK_DATABASE_DEF
+#define TRACK_DATABASE_DEF
+
+#include <fstream>
+#include <string>
+#include <vector>
+#include "TrackSource.h"
+
+class Track;
+
+// Binary track database
+// (Grade, geometric curvature, superelevation, and track angle are tabulated at a uniform resolution of longitudinal position.  The
+// file starts with the file signature, the format version, the longitudinal position of the first entry (meters), the resolution
+// (meters), the number of entries, and the fingerprint of the track functions the database was converted from ('0' for databases
+// written by other tools), followed by the entries, each of which holds the four track properties as doubles.  Entries are read from
+// the file in fixed-size pages as the train consist advances, so memory use does not depend on track length.)
+class TrackDatabase : public TrackSource {
+
+public:
+
+	// filePath		-->	Absolute path of binary track database file
+	TrackDatabase(std::string filePath);
+
+	virtual ~TrackDatabase();
+
+	// File signature
+	static const std::string FILE_SIGNATURE;
+
+	// File format version
+	static constexpr unsigned int FILE_VERSION = 2;
+
+	// Number of track properties per entry (grade, curvature, superelevation, and angle)
+	static constexpr int NUMBER_OF_PROPERTIES = 4;
+
+	// Number of entries per page
+	static constexpr size_t ENTRIES_PER_PAGE = 4096;
+
+	// Number of pages held in memory
+	static constexpr size_t NUMBER_OF_CACHED_PAGES = 16;
+
+	// Absolute path of binary track database file
+	std::string filePath;
+
+	// Longitudinal position of first entry (meters)
+	double startPosition;
+
+	// Distance between entries (meters)
+	double resolution;
+
+	// Number of entries
+	unsigned long long numberOfEntries;
+
+	// Fingerprint of track functions database was converted from ('0' if database was written by other tool)
+	unsigned long long sourceFingerprint;
+
+	// Writes binary track database by tabulating track (in SI units) at uniform resolution (returns error message if file cannot be written)
+	// track		-->	Track
+	// filePath		-->	Absolute path of binary track database file
+	// resolution	-->	Distance between entries (meters)
+	static std::string convert(Track* track, std::string filePath, double resolution);
+
+	// Checks if existing binary track database file was converted from other track functions or at other resolution
+	// (databases written by other tools are never stale, and files whose header cannot be read are left for 'open' to report)
+	// filePath		-->	Absolute path of binary track database file
+	// track		-->	Track
+	// resolution	-->	Distance between entries (meters) requested for conversion
+	static bool isStale(std::string filePath, Track* track, double resolution);
+
+	// Opens binary track database file and reads header (returns error message if file is not a valid binary track database)
+	std::string open();
+
+	// Longitudinal position of first entry (meters)
+	double start() override;
+
+	// Longitudinal position of last entry (meters)
+	double end() override;
+
+	// Linear interpolation between entries
+	double interpolate(int propertyIndex, double longPosition) override;
+
+private:
+
+	// Size of file header (bytes)
+	static const std::streamoff HEADER_SIZE;
+
+	// Input file stream
+	std::ifstream* inputFileStream;
+
+	// Calculates fingerprint of track functions (64-bit FNV-1a hash of function types, intervals, and points of track in SI units)
+	// track		-->	Track
+	static unsigned long long calc_fingerprint(Track* track);
+
+	// Adds bytes to 64-bit FNV-1a hash
+	// hash				-->	Hash
+	// bytes			-->	Bytes
+	// numberOfBytes	-->	Number of bytes
+	static void hashBytes(unsigned long long* hash, const void* bytes, size_t numberOfBytes);
+
+	// Reads file header (returns 'false' if header cannot be read or file is not a binary track database of current format)
+	// ifs			-->	Input file stream positioned at start of file
+	bool readHeader(std::ifstream* ifs);
+
+	// Pages held in memory (page in slot 'i' has page index congruent to 'i' modulo number of cached pages)
+	std::vector<double> pages[NUMBER_OF_CACHED_PAGES];
+
+	// Page index of page held in each slot ('numberOfEntries' if slot is empty)
+	unsigned long long pageIndices[NUMBER_OF_CACHED_PAGES];
+
+	// Gets entry, reading page of entry from file if page is not held in memory
+	// entryIndex	-->	Entry index
+	const double* entry(unsigned long long entryIndex);
+
+};
+
+#endif
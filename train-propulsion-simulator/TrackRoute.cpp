@@ -0,0 +1,90 @@
+//////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+// This file is part of the TRAIN PROPULSION SIMULATOR repository available at github.com/lnaz01/train-propulsion-simulator //
+//////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+
+#include <algorithm>
+#include "TrackRoute.h"
+#include "InputFileReader.h"
+#include "InputFileReader_Route.h"
+#include "TrackSegmentLibrary.h"
+
+
+TrackRoute::TrackRoute() {
+	trackSegmentLibrary = NULL;
+	segmentCursor = 0;
+}
+
+
+TrackRoute::~TrackRoute() {}
+
+
+std::string TrackRoute::load(InputFileReader_Route* inputFileReader_Route) {
+	std::string tslstr = TrackSegmentLibrary::find(inputFileReader_Route->trackSegmentLibraryAbsolutePath, &trackSegmentLibrary);  // track segment library validation string
+	if (tslstr.compare(InputFileReader::VALID_INPUT_STRING) != 0) {
+		return tslstr;
+	}
+	for (size_t i = 0; i < inputFileReader_Route->segmentIds.size(); i++) {
+		size_t si = trackSegmentLibrary->calc_segmentIndex(inputFileReader_Route->segmentIds[i]);  // library segment index
+		if (si == trackSegmentLibrary->segmentIds.size()) {
+			return std::string("Segment '") + inputFileReader_Route->segmentIds[i] + std::string("' of route file is not in track segment library.");
+		}
+		double sa = 0.0;  // angle at start of route segment
+		if (i > 0) {
+			size_t psi = segmentIndices[i - 1];  // library segment index of previous route segment
+			double pse = segmentOffsets[i - 1] + trackSegmentLibrary->segmentLengths[psi];  // end of previous route segment
+			// (Small tolerance for offsets and segment lengths converted separately from feet)
+			if (inputFileReader_Route->segmentOffsets[i] < (pse - 1.0e-6)) {
+				return std::string("Segment '") + inputFileReader_Route->segmentIds[i] + std::string("' of route file starts before end of previous segment.");
+			}
+			sa = segmentStartAngles[i - 1] + trackSegmentLibrary->interpolate(psi, 3, trackSegmentLibrary->segmentLengths[psi]);
+		}
+		segmentIndices.push_back(si);
+		segmentOffsets.push_back(inputFileReader_Route->segmentOffsets[i]);
+		segmentStartAngles.push_back(sa);
+	}
+	return InputFileReader::VALID_INPUT_STRING;
+}
+
+
+double TrackRoute::start() {
+	return segmentOffsets[0];
+}
+
+
+double TrackRoute::end() {
+	size_t n = segmentOffsets.size();  // number of route segments
+	return segmentOffsets[n - 1] + trackSegmentLibrary->segmentLengths[segmentIndices[n - 1]];
+}
+
+
+double TrackRoute::interpolate(int propertyIndex, double longPosition) {
+	size_t i = calc_segmentIndex(longPosition);
+	segmentCursor = i;
+	size_t si = segmentIndices[i];  // library segment index
+	double sp = longPosition - segmentOffsets[i];  // distance from start of route segment
+	// Level tangent track after end of route segment (up to start of next route segment), except after last route segment, which is extended
+	if ((sp > trackSegmentLibrary->segmentLengths[si]) && (i < (segmentOffsets.size() - 1))) {
+		if (propertyIndex == 3) {
+			return segmentStartAngles[i] + trackSegmentLibrary->interpolate(si, 3, trackSegmentLibrary->segmentLengths[si]);
+		}
+		return 0.0;
+	}
+	double r = trackSegmentLibrary->interpolate(si, propertyIndex, sp);
+	if (propertyIndex == 3) {
+		r = r + segmentStartAngles[i];
+	}
+	return r;
+}
+
+
+size_t TrackRoute::calc_segmentIndex(double longPosition) {
+	size_t n = segmentOffsets.size();  // number of route segments
+	size_t i = std::min(segmentCursor, n - 1);
+	if ((segmentOffsets[i] <= longPosition) && ((i == (n - 1)) || (longPosition < segmentOffsets[i + 1]))) {
+		return i;
+	}
+	size_t k = std::upper_bound(segmentOffsets.begin(), segmentOffsets.end(), longPosition) - segmentOffsets.begin();
+	return (k > 0) ? (k - 1) : 0;
+}
+
@@ -0,0 +1,62 @@
+//////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+// This file is part of the TRAIN PROPULSION SIMULATOR repository available at github.com/lnaz01/train-propulsion-simulator //
+//////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+#ifndef TRACK_ROUTE_DEF
+#define TRACK_ROUTE_DEF
+
+#include <string>
+#include <vector>
+#include "TrackSource.h"
+
+class InputFileReader_Route;
+class TrackSegmentLibrary;
+
+// Route assembled from segments of track segment library
+// (Route segments refer to lookup tables of shared track segment library instead of holding copies.  Track between route segments is level tangent track.)
+class TrackRoute : public TrackSource {
+
+public:
+
+	TrackRoute();
+
+	virtual ~TrackRoute();
+
+	// Track segment library (shared with other routes, so not deleted by route)
+	TrackSegmentLibrary* trackSegmentLibrary;
+
+	// Library segment index of each route segment
+	std::vector<size_t> segmentIndices;
+
+	// Longitudinal position of start of each route segment (meters)
+	std::vector<double> segmentOffsets;
+
+	// Track angle at start of each route segment (radians)
+	std::vector<double> segmentStartAngles;
+
+	// Assembles route from route file (returns error message if track segment library is not valid or route refers to segments that are not in library)
+	// inputFileReader_Route	-->	Route file reader (loaded and converted to SI units)
+	std::string load(InputFileReader_Route* inputFileReader_Route);
+
+	// Longitudinal position of start of first route segment (meters)
+	double start() override;
+
+	// Longitudinal position of end of last route segment (meters)
+	double end() override;
+
+	// Linear interpolation in lookup table of route segment containing longitudinal position
+	double interpolate(int propertyIndex, double longPosition) override;
+
+private:
+
+	// Index of route segment found by last interpolation (search hint, since longitudinal position usually changes little between calls)
+	size_t segmentCursor;
+
+	// Calculates index of last route segment whose start is not greater than longitudinal position (first route segment if longitudinal position is
+	// before start of route)
+	// longPosition		-->	Longitudinal position (meters)
+	size_t calc_segmentIndex(double longPosition);
+
+};
+
+#endif
@@ -0,0 +1,199 @@
+//////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+// This file is part of the TRAIN PROPULSION SIMULATOR repository available at github.com/lnaz01/train-propulsion-simulator //
+//////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+
+#include <cmath>
+#include "TrackSegmentLibrary.h"
+#include "UnitConverter.h"
+
+
+const std::string TrackSegmentLibrary::START_SEGMENT_STRING = "Segment_";
+
+
+const std::string TrackSegmentLibrary::END_SEGMENT_STRING = "_Segment";
+
+
+std::map<std::string, TrackSegmentLibrary*> TrackSegmentLibrary::loadedLibraries;
+
+
+std::mutex TrackSegmentLibrary::loadedLibrariesMutex;
+
+
+TrackSegmentLibrary::TrackSegmentLibrary(std::string inputFileAbsolutePath) : InputFileReader(inputFileAbsolutePath) {
+	resolution = 0.0;
+}
+
+
+TrackSegmentLibrary::~TrackSegmentLibrary() {}
+
+
+std::string TrackSegmentLibrary::find(std::string inputFileAbsolutePath, TrackSegmentLibrary** trackSegmentLibrary) {
+	std::lock_guard<std::mutex> lock(loadedLibrariesMutex);
+	std::map<std::string, TrackSegmentLibrary*>::iterator it = loadedLibraries.find(inputFileAbsolutePath);
+	if (it != loadedLibraries.end()) {
+		*trackSegmentLibrary = it->second;
+		return InputFileReader::VALID_INPUT_STRING;
+	}
+	TrackSegmentLibrary* tsl = new TrackSegmentLibrary(inputFileAbsolutePath);  // track segment library
+	if (tsl->inputFileExistsBool == false) {
+		delete tsl;
+		return std::string("Track segment library file '") + inputFileAbsolutePath + std::string("' does not exist.");
+	}
+	std::string tslstr = tsl->load();  // track segment library validation string
+	if (tslstr.compare(InputFileReader::VALID_INPUT_STRING) != 0) {
+		delete tsl;
+		return tslstr;
+	}
+	loadedLibraries[inputFileAbsolutePath] = tsl;
+	*trackSegmentLibrary = tsl;
+	return InputFileReader::VALID_INPUT_STRING;
+}
+
+
+std::string TrackSegmentLibrary::load() {
+	reinitialize();
+	currentLineNumber = 0;
+	bool inSegmentBool = false;  // reading points of segment boolean
+	std::vector<double> x;  // positions of points of current segment (meters)
+	std::vector<double> g;  // grades of points of current segment (radians)
+	std::vector<double> c;  // curvatures of points of current segment (meters^-1)
+	std::vector<double> s;  // superelevations of points of current segment (radians)
+	for (int i = 0; i < totalNumberOfLines; i++) {
+		nextLine();
+		if (currentLine.length() == 0) {
+			continue;
+		}
+		std::vector<std::string> strvec = InputFileReader::split_string(currentLine, ',');
+		// Resolution
+		if (resolution == 0.0) {
+			try {
+				resolution = std::stod(currentLine);
+			}
+			catch (const std::invalid_argument& ia) {
+				return errorMessage("First line must hold resolution of segment lookup tables (feet).");
+			}
+			if ((strvec.size() != 1) || (resolution <= 0.0)) {
+				return errorMessage("Resolution of segment lookup tables must be a single positive number.");
+			}
+		}
+		// Start of segment
+		else if (inSegmentBool == false) {
+			if ((strvec.size() != 2) || (strvec[0].compare(START_SEGMENT_STRING) != 0)) {
+				return errorMessage(std::string("Expected '") + START_SEGMENT_STRING + std::string("' and segment identifier separated by a comma."));
+			}
+			if (calc_segmentIndex(strvec[1]) != segmentIds.size()) {
+				return errorMessage(std::string("Segment identifier '") + strvec[1] + std::string("' is already defined."));
+			}
+			segmentIds.push_back(strvec[1]);
+			x.clear();
+			g.clear();
+			c.clear();
+			s.clear();
+			inSegmentBool = true;
+		}
+		// End of segment
+		else if (currentLine.compare(END_SEGMENT_STRING) == 0) {
+			if (x.size() < 2) {
+				return errorMessage("Segment must have at least two points.");
+			}
+			compile_segment(x, g, c, s);
+			inSegmentBool = false;
+		}
+		// Point of segment
+		else {
+			if (strvec.size() != 4) {
+				return errorMessage("Each point must have position, grade, curvature, and superelevation separated by commas.");
+			}
+			double d[4];  // point values
+			try {
+				for (int k = 0; k < 4; k++) {
+					d[k] = std::stod(strvec[k]);
+				}
+			}
+			catch (const std::invalid_argument& ia) {
+				return errorMessage("Error reading number.");
+			}
+			double xsi = UnitConverter::ft_To_M(d[0]);  // position (meters)
+			if ((x.size() == 0) && (d[0] != 0.0)) {
+				return errorMessage("First point of segment must have position 0.");
+			}
+			if ((x.size() > 0) && (xsi <= x[x.size() - 1])) {
+				return errorMessage("Positions of points must be increasing.");
+			}
+			x.push_back(xsi);
+			g.push_back(UnitConverter::pct_To_Rad(d[1]));
+			c.push_back(UnitConverter::trkCurv_To_GCurv(d[2]));
+			s.push_back(UnitConverter::inSup_To_Rad(d[3]));
+		}
+	}
+	if (inSegmentBool == true) {
+		return errorMessage(std::string("Last segment must end with '") + END_SEGMENT_STRING + std::string("'."));
+	}
+	if (segmentIds.size() == 0) {
+		return std::string("Track segment library file '") + inputFileAbsolutePath + std::string("' has no segments.");
+	}
+	return InputFileReader::VALID_INPUT_STRING;
+}
+
+
+size_t TrackSegmentLibrary::calc_segmentIndex(std::string segmentId) {
+	for (size_t i = 0; i < segmentIds.size(); i++) {
+		if (segmentIds[i].compare(segmentId) == 0) {
+			return i;
+		}
+	}
+	return segmentIds.size();
+}
+
+
+double TrackSegmentLibrary::interpolate(size_t segmentIndex, int propertyIndex, double segmentPosition) {
+	const std::vector<double>& st = segmentTables[segmentIndex];  // segment lookup table
+	size_t n = (st.size() / NUMBER_OF_PROPERTIES) - 1;  // number of table intervals
+	double u = segmentPosition / segmentResolutions[segmentIndex];  // position in table entries
+	if (u <= 0.0) {
+		return st[propertyIndex];
+	}
+	size_t j = (size_t)u;
+	if (j >= n) {
+		return st[(n * NUMBER_OF_PROPERTIES) + propertyIndex];
+	}
+	double w = u - j;  // interpolation weight
+	double y0 = st[(j * NUMBER_OF_PROPERTIES) + propertyIndex];
+	double y1 = st[((j + 1) * NUMBER_OF_PROPERTIES) + propertyIndex];
+	return y0 + (w * (y1 - y0));
+}
+
+
+std::string TrackSegmentLibrary::errorMessage(std::string message) {
+	return std::string("Error on line ") + std::to_string(currentLineNumber) + std::string(" of track segment library file '") + inputFileAbsolutePath +
+		std::string("': ") + message;
+}
+
+
+void TrackSegmentLibrary::compile_segment(const std::vector<double>& x, const std::vector<double>& g, const std::vector<double>& c, const std::vector<double>& s) {
+	double l = x[x.size() - 1];  // segment length
+	size_t n = (size_t)std::ceil(l / UnitConverter::ft_To_M(resolution));  // number of table intervals
+	double h = l / n;  // distance between table entries
+	std::vector<double> st((n + 1) * NUMBER_OF_PROPERTIES);  // segment lookup table
+	size_t p = 0;  // index of point starting interval of current table entry
+	double a = 0.0;  // angle at point 'p' (integral of curvature, which is linear between points)
+	for (size_t j = 0; j <= n; j++) {
+		double xe = (j < n) ? (j * h) : l;  // position of table entry
+		while ((p < (x.size() - 2)) && (x[p + 1] <= xe)) {
+			a = a + ((x[p + 1] - x[p]) * 0.5 * (c[p] + c[p + 1]));
+			p = p + 1;
+		}
+		double dx = x[p + 1] - x[p];  // length of interval between points
+		double t = xe - x[p];  // distance from point 'p'
+		double w = t / dx;  // interpolation weight
+		st[(j * NUMBER_OF_PROPERTIES) + 0] = g[p] + (w * (g[p + 1] - g[p]));
+		st[(j * NUMBER_OF_PROPERTIES) + 1] = c[p] + (w * (c[p + 1] - c[p]));
+		st[(j * NUMBER_OF_PROPERTIES) + 2] = s[p] + (w * (s[p + 1] - s[p]));
+		st[(j * NUMBER_OF_PROPERTIES) + 3] = a + (t * (c[p] + (0.5 * w * (c[p + 1] - c[p]))));
+	}
+	segmentLengths.push_back(l);
+	segmentResolutions.push_back(h);
+	segmentTables.push_back(st);
+}
+
@@ -0,0 +1,95 @@
+//////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+// This file is part of the TRAIN PROPULSION SIMULATOR repository available at github.com/lnaz01/train-propulsion-simulator //
+//////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+#ifndef TRACK_SEGMENT_LIBRARY_DEF
+#define TRACK_SEGMENT_LIBRARY_DEF
+
+#include <map>
+#include <mutex>
+#include <string>
+#include <vector>
+#include "InputFileReader.h"
+
+// Library of standard track segments from which routes are assembled
+// (The file starts with the resolution of the segment lookup tables in feet, followed by the segments.  Each segment starts with a line holding
+// 'Segment_' and the segment identifier separated by a comma, followed by one line per point holding the position from the start of the segment
+// (feet), grade (percent), curvature (degrees), and superelevation (inches) separated by commas, and ends with a line holding '_Segment'.  Track
+// properties are linear between points.  Each segment is compiled into a lookup table once, when the library is loaded.)
+class TrackSegmentLibrary : public InputFileReader {
+
+public:
+
+	// inputFileAbsolutePath	-->	Absolute path of track segment library file
+	TrackSegmentLibrary(std::string inputFileAbsolutePath);
+
+	virtual ~TrackSegmentLibrary();
+
+	// Start segment string
+	static const std::string START_SEGMENT_STRING;
+
+	// End segment string
+	static const std::string END_SEGMENT_STRING;
+
+	// Number of track properties per lookup table entry (grade, curvature, superelevation, and angle)
+	static constexpr int NUMBER_OF_PROPERTIES = 4;
+
+	// Segment identifiers
+	std::vector<std::string> segmentIds;
+
+	// Segment lengths (meters)
+	std::vector<double> segmentLengths;
+
+	// Distance between lookup table entries of each segment (meters)
+	// (resolution of library, reduced so that each segment is a whole number of entries long)
+	std::vector<double> segmentResolutions;
+
+	// Lookup table of each segment (entry 'j' holds grade (radians), geometric curvature (meters^-1), superelevation (radians), and angle relative to
+	// start of segment (radians) at 'j * segmentResolutions' from start of segment)
+	std::vector<std::vector<double>> segmentTables;
+
+	// Finds track segment library loaded from file, loading and compiling library if it has not been loaded yet (returns error message if file is not valid)
+	// (Libraries are kept for lifetime of program and are not changed after loading, so all simulations share lookup tables of same library, such as
+	// parareal replicas and calibration candidates)
+	// inputFileAbsolutePath	-->	Absolute path of track segment library file
+	// trackSegmentLibrary		-->	Track segment library (set if library is valid)
+	static std::string find(std::string inputFileAbsolutePath, TrackSegmentLibrary** trackSegmentLibrary);
+
+	// Loads track segment library file and compiles lookup table of each segment
+	std::string load() override;
+
+	// Index of segment with identifier (number of segments if library has no segment with identifier)
+	// segmentId	-->	Segment identifier
+	size_t calc_segmentIndex(std::string segmentId);
+
+	// Calculates value of track property at position along segment (linear interpolation between lookup table entries)
+	// segmentIndex		-->	Segment index
+	// propertyIndex	-->	Track property index (0 for grade, 1 for curvature, 2 for superelevation, 3 for angle relative to start of segment)
+	// segmentPosition	-->	Distance from start of segment (meters)
+	double interpolate(size_t segmentIndex, int propertyIndex, double segmentPosition);
+
+private:
+
+	// Libraries loaded so far (by absolute path of track segment library file)
+	static std::map<std::string, TrackSegmentLibrary*> loadedLibraries;
+
+	// Mutex for libraries loaded so far
+	static std::mutex loadedLibrariesMutex;
+
+	// Resolution of lookup tables (feet)
+	double resolution;
+
+	// Returns error message for current line
+	// message	-->	Description of error
+	std::string errorMessage(std::string message);
+
+	// Compiles lookup table of segment from points (in SI units)
+	// x	-->	Positions of points from start of segment (meters)
+	// g	-->	Grades at points (radians)
+	// c	-->	Geometric curvatures at points (meters^-1)
+	// s	-->	Superelevations at points (radians)
+	void compile_segment(const std::vector<double>& x, const std::vector<double>& g, const std::vector<double>& c, const std::vector<double>& s);
+
+};
+
+#endif
@@ -0,0 +1,13 @@
+//////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+// This file is part of the TRAIN PROPULSION SIMULATOR repository available at github.com/lnaz01/train-propulsion-simulator //
+//////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+
+#include "TrackSource.h"
+
+
+TrackSource::TrackSource() {}
+
+
+TrackSource::~TrackSource() {}
+
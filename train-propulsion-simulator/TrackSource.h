@@ -0,0 +1,30 @@
+//////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+// This file is part of the TRAIN PROPULSION SIMULATOR repository available at github.com/lnaz01/train-propulsion-simulator //
+//////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+#ifndef TRACK_SOURCE_DEF
+#define TRACK_SOURCE_DEF
+
+// Source of track properties read by track instead of track functions (binary track database or route assembled from track segment library)
+class TrackSource {
+
+public:
+
+	TrackSource();
+
+	virtual ~TrackSource();
+
+	// Longitudinal position of start of track (meters)
+	virtual double start() = 0;
+
+	// Longitudinal position of end of track (meters)
+	virtual double end() = 0;
+
+	// Calculates value of track property at longitudinal position
+	// propertyIndex	-->	Track property index (0 for grade, 1 for curvature, 2 for superelevation, 3 for angle)
+	// longPosition		-->	Longitudinal position (meters)
+	virtual double interpolate(int propertyIndex, double longPosition) = 0;
+
+};
+
+#endif
@@ -3,11 +3,16 @@
 //////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
 
 
+#include <cmath>
 #include <iostream>
 #include "Track.h"
+#include "Function.h"
 #include "InputFileReader_Simulation.h"
 
 
+void integratedCurvature__TEST();
+
+
 int main() {
 
 	std::string idfp = "C:/Users/Leith/Desktop/MyTrack__test.txt";
@@ -17,6 +22,47 @@ int main() {
 	std::cout << "Line " << inputFileReader_Simulation->currentLineNumber << ": " << valstr << std::endl;
 	std::cout << std::endl;
 	inputFileReader_Simulation->userDefinedTracks[0]->console();
+	integratedCurvature__TEST();
+
+}
+
 
+// Tests integral of curvature between two longitudinal positions against difference of track angles (on tangent, spiral, and curve)
+void integratedCurvature__TEST() {
+	std::cout << "integratedCurvature__TEST" << std::endl;
+	InputFileReader_Simulation* inputFileReader_Simulation = new InputFileReader_Simulation();
+	Track* track = new Track(inputFileReader_Simulation);
+	// Curvature in SI units (tangent from 0 to 100 meters, spiral from 100 to 300 meters, and curve from 300 to 600 meters)
+	double x[4] = { 0.0, 100.0, 300.0, 600.0 };
+	double y[4] = { 0.0, 0.0, 0.002, 0.002 };
+	track->physicalVariables[1]->piecewiseLinear(x, y, 4);
+	track->calc_headingTable();
+	// Pairs of longitudinal positions (both on spiral, spiral to curve, tangent to spiral, and both on curve)
+	double x0s[4] = { 120.0, 150.0, 50.0, 350.0 };
+	double x1s[4] = { 250.0, 450.0, 200.0, 550.0 };
+	double maxError = 0.0;
+	for (int i = 0; i < 4; i++) {
+		size_t si0 = 0;
+		size_t si1 = 0;
+		double ic = track->integratedCurvature(x0s[i], x1s[i], &si0, &si1);
+		double da = track->angle(x1s[i]) - track->angle(x0s[i]);
+		std::cout << "x0: " << x0s[i] << ", x1: " << x1s[i] << ", integratedCurvature: " << ic << ", angle(x1) - angle(x0): " << da << std::endl;
+		maxError = std::fmax(maxError, std::fabs(ic - da));
+	}
+	// Spiral from 120 to 250 meters (curvature slope is 0.002 / 200 meters^-2, so integral is 0.5 * 0.00001 * (150^2 - 20^2))
+	size_t si0 = 0;
+	size_t si1 = 0;
+	double exact = 0.5 * 0.00001 * ((150.0 * 150.0) - (20.0 * 20.0));
+	std::cout << "Exact integral on spiral: " << exact << ", error: " << track->integratedCurvature(120.0, 250.0, &si0, &si1) - exact << std::endl;
+	std::cout << "Maximum difference from difference of track angles: " << maxError << std::endl;
+	if ((maxError < 1.0e-12) && (std::fabs(track->integratedCurvature(120.0, 250.0, &si0, &si1) - exact) < 1.0e-12)) {
+		std::cout << "integratedCurvature__TEST passed" << std::endl;
+	}
+	else {
+		std::cout << "integratedCurvature__TEST failed" << std::endl;
+	}
+	std::cout << std::endl << std::endl << std::endl;
+	delete track;
+	delete inputFileReader_Simulation;
 }
 
@@ -10,11 +10,15 @@
 #include "Car.h"
 #include "Coupler.h"
 #include "CouplingSystem.h"
+#include "CouplingSystemBatch.h"
 #include "Function.h"
+#include "InputFileReader_Simulation.h"
 #include "Interval.h"
 #include "Locomotive.h"
 #include "LocomotiveOperator.h"
 #include "RailVehicle.h"
+#include "SimulationState.h"
+#include "Track.h"
 #include "UnitConverter.h"
 
 
@@ -27,6 +31,10 @@ TrainConsist::TrainConsist(InputFileReader_Simulation* ifrsim) : UserDefinedRRCo
 		physicalVariables.push_back(new Function(this, i));
 	}
 	railVehicleTypesDefinedBool = false;
+	couplingSystemBatch = NULL;
+	for (int k = 0; k < Track::NUMBER_OF_PROPERTIES; k++) {
+		trackSegmentIndices[k] = 0;
+	}
 	// User-inputted physical constants
 	// 0	-->	Air temperature (fahrenheit)
 	// 1	-->	End-of-train device capability
@@ -72,6 +80,9 @@ TrainConsist::~TrainConsist() {
 	for (size_t i = 0; i < couplingSystems.size(); i++) {
 		delete couplingSystems[i];
 	}
+	if (couplingSystemBatch != NULL) {
+		delete couplingSystemBatch;
+	}
 	for (size_t i = 0; i < brakePipes_Cumulative.size(); i++) {
 		delete brakePipes_Cumulative[i];
 	}
@@ -273,6 +284,41 @@ void TrainConsist::configureCouplingSystems() {
 		couplingSystems[i]->calc_centerToCenterDistance_Unstressed();
 		// Initial coupler displacements
 		couplingSystems[i]->initialCouplerDisplacements();
+		// Composite force-displacement table
+		couplingSystems[i]->calc_compositeForceDisplacement();
+	}
+	// Batch evaluation of coupling system forces
+	if (couplingSystemBatch != NULL) {
+		delete couplingSystemBatch;
+	}
+	couplingSystemBatch = new CouplingSystemBatch(this);
+}
+
+
+void TrainConsist::calc_trackProperties() {
+	size_t nrv = railVehicles.size();  // number of rail vehicles
+	double* tp[Track::NUMBER_OF_PROPERTIES];  // track property arrays
+	railVehiclePositions.resize(nrv);
+	for (int k = 0; k < Track::NUMBER_OF_PROPERTIES; k++) {
+		railVehicleTrackProperties[k].resize(nrv);
+		tp[k] = railVehicleTrackProperties[k].data();
+	}
+	// Gather rail vehicle positions (ordered from leading to trailing rail vehicle)
+	for (size_t i = 0; i < nrv; i++) {
+		railVehiclePositions[i] = railVehicles[i]->ssv[0];
+	}
+	// Sweep track along train consist
+	inputFileReader_Simulation->userDefinedTracks[0]->calc_properties(railVehiclePositions.data(), nrv, trackSegmentIndices, tp);
+	// Scatter track properties to rail vehicles (rail vehicles with track averaging query track over their own length instead)
+	for (size_t i = 0; i < nrv; i++) {
+		if (railVehicles[i]->trackAveragingBool == true) {
+			railVehicles[i]->calc_trackProperties();
+			continue;
+		}
+		for (int k = 0; k < Track::NUMBER_OF_PROPERTIES; k++) {
+			railVehicles[i]->trackProperties[k] = railVehicleTrackProperties[k][i];
+		}
+		railVehicles[i]->trackPropertiesPosition = railVehiclePositions[i];
 	}
 }
 
@@ -309,3 +355,29 @@ void TrainConsist::loadPhysicalConstantAlternateNames() {
 	eotDeviceCapability = (int)physicalConstants[1];
 }
 
+
+void TrainConsist::saveState(SimulationState* simulationState) {
+	simulationState->append(locationOnTrack, true);
+	for (size_t i = 0; i < railVehicles.size(); i++) {
+		railVehicles[i]->saveState(simulationState);
+	}
+	for (size_t i = 0; i < brakePipes_Cumulative.size(); i++) {
+		for (size_t j = 0; j < brakePipes_Cumulative[i]->brakePipe_FiniteElements.size(); j++) {
+			brakePipes_Cumulative[i]->brakePipe_FiniteElements[j]->saveState(simulationState);
+		}
+	}
+}
+
+
+void TrainConsist::loadState(SimulationState* simulationState) {
+	locationOnTrack = simulationState->next();
+	for (size_t i = 0; i < railVehicles.size(); i++) {
+		railVehicles[i]->loadState(simulationState);
+	}
+	for (size_t i = 0; i < brakePipes_Cumulative.size(); i++) {
+		for (size_t j = 0; j < brakePipes_Cumulative[i]->brakePipe_FiniteElements.size(); j++) {
+			brakePipes_Cumulative[i]->brakePipe_FiniteElements[j]->loadState(simulationState);
+		}
+	}
+}
+
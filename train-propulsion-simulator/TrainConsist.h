@@ -7,14 +7,17 @@
 
 #include <string>
 #include <vector>
+#include "Track.h"
 #include "UnitConverter.h"
 #include "UserDefinedRRComponent.h"
 
 class BrakePipe_Cumulative;
 class CouplingSystem;
+class CouplingSystemBatch;
 class InputFileReader_Simulation;
 class Locomotive;
 class RailVehicle;
+class SimulationState;
 
 class TrainConsist : public UserDefinedRRComponent {
 
@@ -61,6 +64,9 @@ public:
 	// Vector of coupling systems
 	std::vector<CouplingSystem*> couplingSystems;
 
+	// Batch evaluation of coupling system forces (created when coupling systems are configured)
+	CouplingSystemBatch* couplingSystemBatch;
+
 	// Vector of locomotives
 	std::vector<Locomotive*> locomotives;
 
@@ -99,6 +105,14 @@ public:
 	// Calculates train consist location on track
 	void calc_locationOnTrack();
 
+	// Saves state (variables that persist from one implicit solver time step to the next)
+	// simulationState		-->	Simulation state
+	void saveState(SimulationState* simulationState);
+
+	// Loads state (variables that persist from one implicit solver time step to the next)
+	// simulationState		-->	Simulation state
+	void loadState(SimulationState* simulationState);
+
 	// Calculates air dynamic viscosity which depends on air temperature
 	void calc_airViscosity();
 
@@ -108,6 +122,9 @@ public:
 	// Configures coupling systems
 	void configureCouplingSystems();
 
+	// Calculates track properties at position of each rail vehicle (single sweep along track from leading to trailing rail vehicle)
+	void calc_trackProperties();
+
 protected:
 
 	void loadPhysicalConstantAlternateNames() override;
@@ -117,6 +134,16 @@ private:
 	// Array of rail vehicle types defined boolean
 	bool railVehicleTypesDefinedBool;
 
+	// Rail vehicle positions (meters) gathered for track sweep
+	std::vector<double> railVehiclePositions;
+
+	// Track grade, curvature, superelevation, and angle at rail vehicle positions calculated by track sweep
+	std::vector<double> railVehicleTrackProperties[Track::NUMBER_OF_PROPERTIES];
+
+	// Indices of grade, curvature, and superelevation function segments and heading table segment found at leading rail vehicle by last track sweep
+	// (starting cursors of next track sweep, since train consist moves only a few meters between sweeps)
+	size_t trackSegmentIndices[Track::NUMBER_OF_PROPERTIES];
+
 };
 
 #endif